@@ -0,0 +1,172 @@
+#pragma once
+// Arduino-Kern für den Host-Build ([env:native]): nur Sprache und Hilfstypen
+// (String, Serial, min/max, FreeRTOS-Sperren als No-op, Attribute).
+// Hardware (Pins, ADC, NVS, WLAN, Watchdog) gibt es hier bewusst nicht -
+// die Module gehen dafür über hal.h, Host-Umsetzung in src/hal_host.cpp.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <ctype.h>
+#include <stdarg.h>
+#include <algorithm>
+#include <string>
+
+using std::min;
+using std::max;
+
+#define IRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+#define PROGMEM
+#define F(s) (s)
+
+#define HIGH 1
+#define LOW  0
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define INPUT_PULLUP 0x05
+#define RISING  0x01
+#define FALLING 0x02
+#define CHANGE  0x03
+#define DEC 10
+#define HEX 16
+
+typedef uint8_t byte;
+
+template <typename T> T constrain(T x, T lo, T hi) { return x < lo ? lo : (x > hi ? hi : x); }
+
+// === STRING (Teilmenge von WString, gleiche Formatierung) ===
+class String {
+public:
+    String() {}
+    String(const char* c) : s(c ? c : "") {}
+    String(const std::string &c) : s(c) {}
+    String(char c) : s(1, c) {}
+    String(unsigned char v, unsigned char base = DEC) : s(fmtU(v, base)) {}
+    String(int v, unsigned char base = DEC) : s(base == DEC ? std::to_string(v) : fmtU((unsigned int)v, base)) {}
+    String(unsigned int v, unsigned char base = DEC) : s(fmtU(v, base)) {}
+    String(long v, unsigned char base = DEC) : s(base == DEC ? std::to_string(v) : fmtU((unsigned long)v, base)) {}
+    String(unsigned long v, unsigned char base = DEC) : s(fmtU(v, base)) {}
+    String(long long v, unsigned char base = DEC) : s(base == DEC ? std::to_string(v) : fmtU((unsigned long long)v, base)) {}
+    String(unsigned long long v, unsigned char base = DEC) : s(fmtU(v, base)) {}
+    String(float v, unsigned int decimals = 2) : s(fmtF(v, decimals)) {}
+    String(double v, unsigned int decimals = 2) : s(fmtF(v, decimals)) {}
+
+    const char* c_str() const { return s.c_str(); }
+    unsigned int length() const { return s.size(); }
+    bool isEmpty() const { return s.empty(); }
+    bool reserve(unsigned int n) { s.reserve(n); return true; }
+
+    char charAt(unsigned int i) const { return i < s.size() ? s[i] : 0; }
+    char operator[](unsigned int i) const { return charAt(i); }
+    char &operator[](unsigned int i) { return s[i]; }
+    void setCharAt(unsigned int i, char c) { if (i < s.size()) s[i] = c; }
+
+    int indexOf(char c, unsigned int from = 0) const { return pos(s.find(c, from)); }
+    int indexOf(const String &x, unsigned int from = 0) const { return pos(s.find(x.s, from)); }
+    int lastIndexOf(char c) const { return pos(s.rfind(c)); }
+    int lastIndexOf(const String &x) const { return pos(s.rfind(x.s)); }
+    String substring(unsigned int from) const { return from < s.size() ? String(s.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) std::swap(from, to);
+        if (from >= s.size()) return String();
+        return String(s.substr(from, to - from));
+    }
+    bool startsWith(const String &p) const { return s.compare(0, p.s.size(), p.s) == 0; }
+    bool endsWith(const String &p) const {
+        return s.size() >= p.s.size() && s.compare(s.size() - p.s.size(), p.s.size(), p.s) == 0;
+    }
+    bool equals(const String &o) const { return s == o.s; }
+    bool equalsIgnoreCase(const String &o) const {
+        if (s.size() != o.s.size()) return false;
+        for (size_t i = 0; i < s.size(); i++) if (tolower((unsigned char)s[i]) != tolower((unsigned char)o.s[i])) return false;
+        return true;
+    }
+
+    long  toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return (float)atof(s.c_str()); }
+    void toLowerCase() { for (auto &c : s) c = tolower((unsigned char)c); }
+    void toUpperCase() { for (auto &c : s) c = toupper((unsigned char)c); }
+    void trim() {
+        size_t a = s.find_first_not_of(" \t\r\n");
+        size_t b = s.find_last_not_of(" \t\r\n");
+        s = a == std::string::npos ? std::string() : s.substr(a, b - a + 1);
+    }
+    void replace(const String &from, const String &to) {
+        if (from.s.empty()) return;
+        for (size_t p = s.find(from.s); p != std::string::npos; p = s.find(from.s, p + to.s.size())) s.replace(p, from.s.size(), to.s);
+    }
+    void remove(unsigned int index) { if (index < s.size()) s.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < s.size()) s.erase(index, count); }
+
+    bool concat(const String &o) { s += o.s; return true; }
+    bool concat(const char* c, unsigned int n) { s.append(c, n); return true; }
+    String &operator+=(const String &o) { s += o.s; return *this; }
+    String &operator+=(const char* c) { if (c) s += c; return *this; }
+    String &operator+=(char c) { s += c; return *this; }
+    template <typename T> String &operator+=(T v) { s += String(v).s; return *this; }
+
+    bool operator==(const String &o) const { return s == o.s; }
+    bool operator==(const char* c) const { return s == (c ? c : ""); }
+    bool operator!=(const String &o) const { return s != o.s; }
+    bool operator!=(const char* c) const { return !(*this == c); }
+    bool operator<(const String &o) const { return s < o.s; }
+
+private:
+    static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+    static std::string fmtU(unsigned long long v, unsigned char base) {
+        if (base < 2 || base > 36) base = DEC;
+        char buf[72];
+        int i = sizeof(buf) - 1;
+        buf[i] = 0;
+        do { int d = v % base; buf[--i] = d < 10 ? '0' + d : 'a' + d - 10; v /= base; } while (v);
+        return std::string(buf + i);
+    }
+    static std::string fmtF(double v, unsigned int decimals) {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+        return std::string(buf);
+    }
+    std::string s;
+};
+
+inline String operator+(const String &a, const String &b) { String r(a); r += b; return r; }
+inline String operator+(const char* a, const String &b) { String r(a); r += b; return r; }
+template <typename T> String operator+(const String &a, T b) { String r(a); r += b; return r; }
+
+// === SERIAL (stdout) ===
+class HardwareSerial {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    size_t print(const String &s) { return fputs(s.c_str(), stdout) >= 0 ? s.length() : 0; }
+    size_t println(const String &s = String()) { size_t n = print(s); fputc('\n', stdout); return n + 1; }
+    size_t printf(const char* fmt, ...) {
+        va_list ap;
+        va_start(ap, fmt);
+        int n = vprintf(fmt, ap);
+        va_end(ap);
+        return n < 0 ? 0 : n;
+    }
+    void flush() { fflush(stdout); }
+};
+extern HardwareSerial Serial;
+
+// === FREERTOS-SPERREN (Host ist single-threaded) ===
+typedef void* SemaphoreHandle_t;
+typedef uint32_t TickType_t;
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { static int dummy; return &dummy; }
+inline int xSemaphoreTake(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
+inline int xSemaphoreGive(SemaphoreHandle_t) { return pdTRUE; }
+struct portMUX_TYPE { int unused; };
+#define portMUX_INITIALIZER_UNLOCKED { 0 }
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux)  ((void)(mux))
@@ -1,5 +1,7 @@
 #include "battery_module.h"
 #include "config.h"
+#include "clock_module.h"
+#include "hal.h"
 #include "logger.h"
 #include "mqtt_module.h"     
 #include "settings_module.h" 
@@ -10,20 +12,19 @@ static unsigned long lastMeasure = 0;
 static bool lowBatWarningSent = false;
 
 void batteryInit() {
-    pinMode(PIN_BATTERY_ADC, INPUT);
-    analogSetAttenuation(ADC_11db); 
+    halAnalogInit(PIN_BATTERY_ADC);
     batteryLoop(); 
 }
 
 void batteryLoop() {
-    unsigned long now = millis();
+    unsigned long now = clockMillis();
     
     // Messung alle 5 Sekunden (zum Testen), später 60s
     if (now - lastMeasure > 5000 || lastMeasure == 0) {
         lastMeasure = now;
         
         // 1. Raw Spannung am Pin messen
-        uint32_t pinMv = analogReadMilliVolts(PIN_BATTERY_ADC);
+        uint32_t pinMv = halAnalogReadMilliVolts(PIN_BATTERY_ADC);
         float pinVoltage = pinMv / 1000.0;
         
         // Rohwert speichern für Telemetrie
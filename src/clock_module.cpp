@@ -0,0 +1,44 @@
+#include "clock_module.h"
+#include "config.h"
+
+bool clockLocal(time_t t, struct tm &out) {
+    return localtime_r(&t, &out) != nullptr;
+}
+
+#ifdef CLOCK_SIM
+
+static uint64_t simUs = 0;          // Uptime in µs, läuft nicht über
+static time_t syncEpoch = 0;        // 0 = kein NTP
+static uint64_t syncUs = 0;
+
+void clockSimReset(unsigned long startMs, time_t epoch) {
+    setenv("TZ", TIME_TZ_POSIX, 1);
+    tzset();
+    simUs = (uint64_t)startMs * 1000ULL;
+    syncEpoch = 0;
+    if (epoch > 0) clockSimSetEpoch(epoch);
+}
+
+void clockSimAdvanceMs(uint32_t ms) {
+    simUs += (uint64_t)ms * 1000ULL;
+}
+
+void clockSimAdvanceUs(uint32_t us) {
+    simUs += us;
+}
+
+void clockSimSetEpoch(time_t epoch) {
+    syncEpoch = epoch;
+    syncUs = simUs;
+}
+
+// Breite wie 'unsigned long' des Builds: 32 Bit laufen wie das Gerät über
+unsigned long clockMillis() { return (unsigned long)(simUs / 1000ULL); }
+unsigned long clockMicros() { return (unsigned long)simUs; }
+
+time_t clockNow() {
+    if (syncEpoch == 0) return (time_t)(simUs / 1000000ULL);
+    return syncEpoch + (time_t)((simUs - syncUs) / 1000000ULL);
+}
+
+#endif
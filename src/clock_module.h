@@ -0,0 +1,42 @@
+#pragma once
+#include <Arduino.h>
+#include <time.h>
+
+// Eine Zeitquelle für alle Module: millis/micros/time/localtime laufen nur
+// noch hierüber. Standard ist die Hardware-Uhr (inline, kostet nichts, auch
+// im ISR nutzbar). Mit -D CLOCK_SIM läuft stattdessen eine simulierte Uhr,
+// die nur per clockSimAdvanceMs() weiterzählt -> Wochen Gerätezeit in
+// Sekunden auf dem Host (Zeitpläne, Tages-Reset, Auto-Reboot, Überlauf).
+//
+// Nicht umgestellt: Laufzeit-Messungen (Watchdog-Loopzeit, HTTP-Latenz) und
+// blockierende Warteschleifen (OTA-Pull, WLAN-Portal) - die brauchen echte Zeit.
+
+#if defined(HAL_HOST) && !defined(CLOCK_SIM)
+#define CLOCK_SIM           // Host hat keine Hardware-Uhr
+#endif
+
+#ifndef CLOCK_SIM
+
+inline unsigned long clockMillis() { return millis(); }
+inline unsigned long clockMicros() { return micros(); }
+inline time_t clockNow() { return time(NULL); }
+
+#else
+
+unsigned long clockMillis();
+unsigned long clockMicros();
+time_t clockNow();
+
+// === SIMULATION ===
+// millis()/micros() haben die Breite von 'unsigned long': mit 32 Bit (Gerät,
+// Host mit -m32) laufen sie nach 49,7 Tagen über, auf 64-Bit-Hosts nie.
+// Vor clockSimSetEpoch() liefert clockNow() Sekunden seit Boot (wie ohne NTP).
+void clockSimReset(unsigned long startMs, time_t epoch);   // epoch 0 = noch kein NTP
+void clockSimAdvanceMs(uint32_t ms);
+void clockSimAdvanceUs(uint32_t us);
+void clockSimSetEpoch(time_t epoch);                        // NTP-Sync oder Zeitsprung
+
+#endif
+
+// localtime_r mit TIME_TZ_POSIX; false bei ungültiger Zeit
+bool clockLocal(time_t t, struct tm &out);
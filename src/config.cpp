@@ -15,4 +15,10 @@ const char* TOPIC_HISTORY = MQTT_BASE_TOPIC "/hist";
 const char* TOPIC_USAGE   = MQTT_BASE_TOPIC "/usage";
 const char* TOPIC_LIMIT   = MQTT_BASE_TOPIC "/limit";
 const char* TOPIC_EVENT   = MQTT_BASE_TOPIC "/event";
-const char* TOPIC_LOG     = MQTT_BASE_TOPIC "/log";
\ No newline at end of file
+const char* TOPIC_LOG     = MQTT_BASE_TOPIC "/log";
+const char* TOPIC_HTTP    = MQTT_BASE_TOPIC "/http";
+const char* TOPIC_OTA     = MQTT_BASE_TOPIC "/ota";
+const char* TOPIC_ZONES   = MQTT_BASE_TOPIC "/zones";
+const char* TOPIC_QUEUE   = MQTT_BASE_TOPIC "/queue";
+const char* TOPIC_RUNS    = MQTT_BASE_TOPIC "/runs";
+const char* TOPIC_STATS   = MQTT_BASE_TOPIC "/stats";
\ No newline at end of file
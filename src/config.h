@@ -22,6 +22,13 @@
 
 #define PIN_VALVE_A     PIN_RELAY 
 
+// Ventil-Zonen: ein Low-Side-Ausgang pro Zone, Zone 1 = PIN_RELAY
+// (Zonen und Sequencer-Werte sind per -include überschreibbar, siehe [env:native_zones])
+#ifndef VALVE_ZONES
+#define VALVE_ZONES         1
+#define VALVE_ZONE_PINS     { PIN_RELAY }
+#endif
+
 // ==========================================================
 // WIFI & MQTT KONFIGURATION
 // ==========================================================
@@ -47,6 +54,12 @@ extern const char* TOPIC_USAGE;
 extern const char* TOPIC_LIMIT;
 extern const char* TOPIC_EVENT;
 extern const char* TOPIC_LOG;
+extern const char* TOPIC_HTTP;
+extern const char* TOPIC_OTA;
+extern const char* TOPIC_ZONES;
+extern const char* TOPIC_QUEUE;
+extern const char* TOPIC_RUNS;
+extern const char* TOPIC_STATS;
 
 // (Optional für Code-Kompatibilität, falls noch X-Macro Reste da sind)
 #define MQTT_TOPIC_GENERATOR(X) 
@@ -56,12 +69,20 @@ extern const char* TOPIC_LOG;
 // ==========================================================
 #define OTA_USER        "otauser"
 #define OTA_PASS        "superSecret123"
+#define OTA_REQUIRE_SHA256   false     // true = Upload ohne sha256 ablehnen
+#define OTA_VERIFY_WINDOW_MS 180000UL  // Selbsttest nach Update, sonst Rollback
+#define OTA_SELFTEST_MAX_LPM 0.5f      // Flow bei geschlossenem Ventil
+#define OTA_INFLATE_MAX_WINDOW 32768   // max. zlib-Fenster für komprimierte Images (RAM)
 
 #define NTP_SERVER_1    "pool.ntp.org"
 #define NTP_TZ_OFFSET_S (7 * 3600) // UTC+7
 #define NTP_RETRY_S     60
+#define TIME_TZ_POSIX   "ICT-7"    // POSIX: ICT-7 = UTC+7 (für localtime, auch in der Simulation)
 
 #define FLOW_K_FACTOR 7.5f 
+#define FLOW_CLOSE_LATENCY_S    0.3f    // Loop + Ventil-Schließzeit (Mengen-Stopp-Vorhersage)
+#define FLOW_RUNON_MS           4000    // so lange nach dem Schließen Nachlauf messen
+#define FLOW_RUNON_MAX_L        2.0f    // mehr ist kein Nachlauf mehr (Leck, Fremdverbrauch)
 #define BAT_R1 100.0f
 #define BAT_R2 100.0f
 
@@ -69,4 +90,89 @@ extern const char* TOPIC_LOG;
 #define IRR_DEFAULT_START_H     6
 #define IRR_DEFAULT_START_M     0
 #define IRR_DEFAULT_DURATION_S  600
-#define IRR_DEFAULT_MAX_RUN_S   3600
\ No newline at end of file
+#define IRR_DEFAULT_MAX_RUN_S   3600
+#define IRR_VOLUME_MAX_S        3600    // Zeit-Obergrenze je Zone bei Mengen-Läufen ohne eigene Dauer
+
+// Fälliger Lauf, während ein anderer läuft
+#define IRR_MERGE_APPEND        0       // in die Warteschlange (nach Priorität, dann Fälligkeit)
+#define IRR_MERGE_EXTEND        1       // gleiche Zonen wie laufender/wartender Lauf: diesen verlängern
+#define IRR_MERGE_SKIP          2       // verwerfen (Event "run_skipped")
+#define IRR_MERGE_POLICY        IRR_MERGE_APPEND
+#define IRR_RUN_QUEUE_LEN       8
+#define IRR_QUEUE_MAX_WAIT_S    21600   // länger wartende Läufe verfallen (Event "run_expired")
+#define IRR_PRIO_SCHEDULE       1       // Slots, Regeln ohne "prio"
+#define IRR_PRIO_MANUAL         5       // MQTT "run"
+#define IRR_CATCHUP_WINDOW_S    600     // verspäteter Start noch erlaubt (Loop-Hänger, NTP-Sprung)
+#define IRR_CLOCK_BACK_S        60      // Uhr so weit zurück -> Zeitplan neu berechnen
+#define IRR_BOOT_CATCHUP_S      7200    // ohne gültige Zeit verpasste Slots so lange nachholen (0 = aus)
+
+// Lauf, der durch Reboot/Stromausfall unterbrochen wurde
+#define IRR_RESUME_OFF          0       // verwerfen (nur loggen)
+#define IRR_RESUME_REMAINING    1       // bis zum ursprünglichen Ende weiterlaufen
+#define IRR_RESUME_RESTART      2       // komplett neu starten
+#define IRR_RESUME_POLICY       IRR_RESUME_REMAINING
+#define IRR_RESUME_MAX_AGE_S    3600    // RESTART nur, wenn Start nicht älter
+#define IRR_RESUME_WAIT_MS      180000UL // so lange nach Boot auf gültige Zeit warten
+
+// Zonen-Sequencer
+#ifndef VALVE_MAX_OPEN
+#define VALVE_MAX_OPEN          1       // gleichzeitig offene Zonen (Wasserdruck, Batteriestrom)
+#endif
+#define VALVE_ZONE_GAP_MS       5000UL  // Mindestabstand zwischen zwei Schaltvorgängen
+#ifndef VALVE_ZONE_LIMIT_S
+#define VALVE_ZONE_LIMIT_S      0       // Tageslimit je Zone (0 = nur Gesamtlimit)
+#endif
+#define SEQ_QUEUE_LEN           16
+
+// Ventil-Zustandsautomat (ein Durchflusssensor für alle Zonen)
+#define VALVE_OPEN_TIMEOUT_MS   5000UL  // kein Impuls nach dem Öffnen -> klemmt zu (oder kein Wasser)
+#define VALVE_CLOSE_TIMEOUT_MS  8000UL  // noch Durchfluss nach dem Schließen -> klemmt offen (> FLOW_RUNON_MS)
+#define VALVE_FLOW_QUIET_MS     1500UL  // so lange ohne Impuls = Durchfluss steht
+
+// Schnellabschaltung (guard_module): eigener Timer, unabhängig von loop()
+#define GUARD_TICK_MS           50      // Abtastung der ISR-Impulse
+#define GUARD_WINDOW_MS         200     // Durchfluss gemittelt über dieses Fenster
+#define GUARD_MAX_LPM           25.0f   // Hüllkurve: mehr = geplatzter Schlauch
+#define GUARD_RUN_MAX_L         400.0f  // Menge je Zeit-Lauf bzw. je manueller Öffnung
+#define GUARD_VOLUME_MARGIN     1.2f    // Mengen-Lauf: Ziel x Faktor + FLOW_RUNON_MAX_L je Zone
+#define GUARD_CLOSED_MAX_LPM    1.0f    // Durchfluss bei geschlossenen Ventilen ...
+#define GUARD_CLOSED_GRACE_MS   VALVE_CLOSE_TIMEOUT_MS  // ... nach dem Nachlauf ...
+#define GUARD_CLOSED_CONFIRM_MS 1000UL  // ... so lange am Stück
+
+// Leck-Erkennung (leak_module): Impuls-Abstände bei geschlossenen Ventilen, stündlich
+#define LEAK_DEFAULT_SENS       5       // 0 = aus, 1..10 (Einstellung "leak_sens")
+#define LEAK_BASE_LPH           3.0f    // Schwelle "nasse Stunde" = LEAK_BASE_LPH / Empfindlichkeit (L/h)
+#define LEAK_MIN_PULSES_H       6       // weniger Impulse je Stunde sind Störungen
+#define LEAK_WINDOW_H           12      // Stunden im Ring
+#define LEAK_MIN_HOURS          4       // so viele beobachtete Stunden, bevor es einen Score gibt
+#define LEAK_MIN_OBS_MIN        20      // Stunde zählt nur mit so vielen Minuten "zu und ruhig"
+#define LEAK_SETTLE_MS          120000UL // nach Schalten/Nachlauf so lange nicht auswerten
+#define LEAK_ALARM_PCT          75      // Score ab dem "leak_suspected" gemeldet wird
+
+// Durchfluss-Signatur je Slot (signature_module): gleitender Mittelwert/Varianz
+#define SIG_RAMP_MS             5000UL  // Anlauf: mittlerer Durchfluss in den ersten 5 s
+#define SIG_EARLY_MS            30000UL // Plateau 5..30 s, danach Vergleich mit der Signatur
+#define SIG_MIN_RUNS            3       // so viele Läufe lernen, bevor verglichen wird
+#define SIG_WINDOW              10      // Gedächtnis in Läufen (EWMA 1/SIG_WINDOW)
+#define SIG_Z_ALARM             4.0f    // Abweichung (in Standardabweichungen) = Anomalie
+#define SIG_RELEARN             3       // so viele Anomalien hintereinander = neuer Normalzustand
+
+// Lauf-Protokoll (runlog_module): 32-Byte-Datensätze im Daten-Flash (Ring)
+#define RUNLOG_PAGE_DEFAULT     50      // /api/runs ohne limit
+#define RUNLOG_PAGE_MAX         500     // /api/runs: max. Läufe je Seite (gestreamt)
+#define RUNLOG_MQTT_MAX         50      // {"cmd":"runs"}: max. Läufe je Anfrage
+#define RUNLOG_MQTT_MSG_BYTES   400     // Antworten in Stücke unter dem MQTT-Puffer (512)
+
+// Verbrauchs-Statistik Tag/Woche/Monat (stats_module), retained auf <base>/stats/...
+#define STATS_RTC_MS            1000UL      // Zwischenstand so oft ins RTC-RAM
+#define STATS_FLASH_MS          300000UL    // und so oft in den Flash (sonst beim Periodenwechsel)
+#define STATS_PUBLISH_MS        300000UL    // laufende Periode höchstens so oft senden
+
+// Verlauf (history_module): tscodec-Blöcke im RAM statt JSON-Queue
+#define HIST_BLOCK_BYTES        256     // je Block (höchstens TS_BLOCK_MAX)
+#define HIST_BLOCKS             24      // Ring 6 KB: ~2..5 Tage Minutenwerte, je nach Gießbetrieb
+#define HIST_REPLAY_PER_LOOP    2       // nach Reconnect so viele Punkte je Loop nachsenden
+
+// Öffnungszeit-Konto (ms, je Zone und Tag): RTC-RAM + Flash-Checkpoint
+#define VALVE_ACC_RTC_MS        1000UL      // offene Zeit so oft ins RTC-RAM (Reset/Panic)
+#define VALVE_ACC_FLASH_MS      300000UL    // und so oft in den Flash (Stromausfall), sonst beim Schließen
\ No newline at end of file
@@ -1,8 +1,10 @@
 #include "flow_module.h"
 #include "config.h"
+#include "clock_module.h"
+#include "hal.h"
 #include "logger.h"
 #include "settings_module.h" // NEU: Für K-Factor
-#include <Preferences.h>
+#include "metrics_module.h"
 
 // RTC_DATA_ATTR behält Wert bei Reboot (aber nicht bei Stromausfall)
 RTC_DATA_ATTR unsigned long rtcTotalPulses = 0;
@@ -13,26 +15,41 @@ static const unsigned long MAX_PULSES_PER_INTERVAL = 20000;
 static const unsigned long MIN_PULSE_SPACING_US    = 150;
 
 static volatile unsigned long pulseCount = 0;
-static unsigned long lastPulseMicros = 0;
+static volatile uint32_t isrPulses = 0;        // läuft nur hoch (Guard-Timer), Überlauf ok
+static volatile unsigned long lastPulseMicros = 0;
+static volatile bool firstPulseArmed = false;  // Ventil-Latenz: erster Impuls nach dem Öffnen
+static volatile bool firstPulseSeen = false;
+static volatile unsigned long firstPulseMicros = 0;
 static float lastLpm = 0.0f;
 static float totalLiters = 0.0f;
 static unsigned long lastCalcMs = 0;
+static float runOnLiters = 0.0f;        // gelernter Nachlauf (EMA), im Flash
 
 void IRAM_ATTR flowIsr() {
-    unsigned long nowUs = micros();
-    if (nowUs - lastPulseMicros < MIN_PULSE_SPACING_US) return; 
+    unsigned long nowUs = clockMicros();
+    if (nowUs - lastPulseMicros < MIN_PULSE_SPACING_US) {
+        metricInc(MC_FLOW_GLITCHES);
+        return;
+    }
     lastPulseMicros = nowUs;
+    if (firstPulseArmed) {
+        firstPulseMicros = nowUs;
+        firstPulseSeen = true;
+        firstPulseArmed = false;
+    }
     pulseCount++;
+    isrPulses++;
+    metricInc(MC_FLOW_PULSES);
 }
 
 void flowInit() {
-    pinMode(PIN_FLOW, INPUT_PULLUP);
-    attachInterrupt(digitalPinToInterrupt(PIN_FLOW), flowIsr, FALLING);
-    lastCalcMs = millis();
+    halPinMode(PIN_FLOW, INPUT_PULLUP);
+    halAttachInterrupt(PIN_FLOW, flowIsr, FALLING);
+    lastCalcMs = clockMillis();
 
     // Bei Stromausfall (RTC=0) versuchen, alten Stand aus Flash zu holen
     if (rtcTotalPulses == 0) {
-        Preferences p;
+        HalNvs p;
         p.begin("flow-data", true); // Read-only
         unsigned long saved = p.getULong("pulses", 0);
         p.end();
@@ -41,19 +58,24 @@ void flowInit() {
             logInfo("Restored Flow Pulses from Flash: " + String(rtcTotalPulses));
         }
     }
-    
-    logInfo("Flow init. Total Pulses: " + String(rtcTotalPulses));
+
+    HalNvs p;
+    p.begin("flow-data", true);
+    runOnLiters = p.getFloat("runon", 0.0f);
+    p.end();
+
+    logInfo("Flow init. Total Pulses: " + String(rtcTotalPulses) + ", run-on " + String(runOnLiters, 2) + " L");
 }
 
 void flowLoop() {
-    unsigned long now = millis();
+    unsigned long now = clockMillis();
     // 100ms Fenster
     if (now - lastCalcMs >= 100) {
         
-        noInterrupts();
+        halInterruptsOff();
         unsigned long pulses = pulseCount;
         pulseCount = 0;
-        interrupts();
+        halInterruptsOn();
 
         if (pulses > MAX_PULSES_PER_INTERVAL) pulses = 0; 
         
@@ -93,7 +115,7 @@ unsigned long flowGetTotalPulses() {
 
 // NEU: Speichern in Flash (wird bei Ventil-Zu aufgerufen)
 void flowSaveToFlash() {
-    Preferences p;
+    HalNvs p;
     p.begin("flow-data", false);
     p.putULong("pulses", rtcTotalPulses);
     p.end();
@@ -103,5 +125,51 @@ void flowSaveToFlash() {
 
 unsigned long flowGetLastPulseAgeMs() {
     if (lastPulseMicros == 0) return 0;
-    return (micros() - lastPulseMicros) / 1000;
-}
\ No newline at end of file
+    return (clockMicros() - lastPulseMicros) / 1000;
+}
+
+void flowArmFirstPulse() {
+    halInterruptsOff();
+    firstPulseSeen = false;
+    firstPulseArmed = true;
+    halInterruptsOn();
+}
+
+bool flowGetFirstPulseUs(unsigned long &us) {
+    if (!firstPulseSeen) return false;
+    us = firstPulseMicros;
+    return true;
+}
+
+bool flowGetLastPulseUs(unsigned long &us) {
+    us = lastPulseMicros;
+    return us != 0;
+}
+
+uint32_t flowGetIsrPulses() { return isrPulses; }
+
+// === MENGEN-LÄUFE ===
+float flowPulsesToLiters(uint32_t pulses) {
+    float k = settingsGetFlowFactor();
+    if (k <= 0.1f) k = 450.0f;
+    return pulses / k;
+}
+
+float flowPredictOvershootL() {
+    return runOnLiters + lastLpm / 60.0f * FLOW_CLOSE_LATENCY_S;
+}
+
+void flowLearnRunOn(float liters) {
+    if (liters < 0.0f) liters = 0.0f;
+    if (liters > FLOW_RUNON_MAX_L) liters = FLOW_RUNON_MAX_L;   // Leck/Fremdverbrauch nicht lernen
+    float old = runOnLiters;
+    runOnLiters = (runOnLiters == 0.0f) ? liters : runOnLiters * 0.7f + liters * 0.3f;
+    if (fabsf(runOnLiters - old) >= 0.01f) {
+        HalNvs p;
+        p.begin("flow-data", false);
+        p.putFloat("runon", runOnLiters);
+        p.end();
+    }
+}
+
+float flowGetRunOnL() { return runOnLiters; }
@@ -10,4 +10,20 @@ float flowGetTotalLiters();
 unsigned long flowGetTotalPulses();
 void flowSaveToFlash(); 
 
-unsigned long flowGetLastPulseAgeMs();
\ No newline at end of file
+unsigned long flowGetLastPulseAgeMs();
+
+// Impuls-Zeitpunkte (clockMicros) für die Ventil-Latenz
+void flowArmFirstPulse();                       // nächsten Impuls festhalten
+bool flowGetFirstPulseUs(unsigned long &us);    // false = seit dem Scharfschalten keiner
+bool flowGetLastPulseUs(unsigned long &us);     // false = noch nie ein Impuls
+
+// Impulse direkt aus der ISR, ohne flowLoop() (Guard-Timer, anderer Task)
+uint32_t flowGetIsrPulses();
+
+// === MENGEN-LÄUFE ===
+float flowPulsesToLiters(uint32_t pulses);
+// Erwartete Menge, die nach dem Schließen-Befehl noch durchläuft
+// (Schaltverzug bei aktuellem Durchfluss + gelernter Nachlauf)
+float flowPredictOvershootL();
+void  flowLearnRunOn(float liters);   // gemessener Nachlauf nach einem Mengen-Stopp
+float flowGetRunOnL();
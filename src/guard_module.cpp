@@ -0,0 +1,214 @@
+#include "guard_module.h"
+#include "config.h"
+#include "clock_module.h"
+#include "hal.h"
+#include "logger.h"
+#include "flow_module.h"
+#include "valve_module.h"
+#include "sequencer_module.h"
+#include "irrigation_module.h"
+#include "settings_module.h"
+#include "metrics_module.h"
+#include "mqtt_module.h"
+#include "runlog_module.h"
+
+static const uint32_t TRIP_MAGIC = 0x47524431;   // "GRD1"
+static const int WINDOW_TICKS = GUARD_WINDOW_MS / GUARD_TICK_MS;
+static_assert(WINDOW_TICKS >= 1, "GUARD_WINDOW_MS must be >= GUARD_TICK_MS");
+
+struct Envelope {
+    float maxLpm;
+    float maxL;
+    bool  run;                  // Programm-Lauf: Menge über alle Zonen und Pausen
+};
+
+// Vom Timer geschrieben, von loop() gelesen (nach 'tripped')
+static GuardTrip trip;
+static volatile bool tripped = false;
+static bool handled = false;            // loop() hat Lauf beendet
+static bool reported = false;           // Event raus (wartet auf MQTT, Alarm ist verriegelt)
+static bool restored = false;           // Alarm kam aus dem Flash
+
+// Nur im Timer benutzt (Envelope/Reset unter halInterruptsOff aus loop())
+static Envelope env = { GUARD_MAX_LPM, GUARD_RUN_MAX_L, false };
+static uint32_t window[WINDOW_TICKS];
+static uint32_t windowSum = 0;
+static int windowPos = 0;
+static uint32_t lastIsrPulses = 0;
+static uint32_t runPulses = 0;
+static unsigned long runStartMs = 0;
+static unsigned long closedSinceMs = 0;
+static uint32_t closedOverMs = 0;
+static bool wasOpen = false;
+
+static uint8_t openMask() {
+    uint8_t m = 0;
+    for (int z = 0; z < VALVE_ZONES; z++) if (valveZoneIsOpen(z)) m |= 1 << z;
+    return m;
+}
+
+// Im Timer: erst abschalten, dann protokollieren
+static void guardTrip(GuardReason reason, float lpm, float limitLpm, float runL, float limitL, uint32_t elapsedMs) {
+    valveEmergencyClose();
+    time_t now = clockNow();
+    trip.magic = TRIP_MAGIC;
+    trip.reason = reason;
+    trip.zones = openMask();
+    trip.lpm = lpm;
+    trip.limitLpm = limitLpm;
+    trip.runL = runL;
+    trip.limitL = limitL;
+    trip.elapsedMs = elapsedMs;
+    trip.epoch = now > 1577836800 ? (uint32_t)now : 0;
+    tripped = true;
+}
+
+static void guardTick() {
+    uint32_t p = flowGetIsrPulses();
+    uint32_t d = p - lastIsrPulses;
+    lastIsrPulses = p;
+    windowSum += d - window[windowPos];
+    window[windowPos] = d;
+    windowPos = (windowPos + 1) % WINDOW_TICKS;
+
+    float k = settingsGetFlowFactor();
+    if (k <= 0.1f) k = 450.0f;
+    float lpm = windowSum / k * (60000.0f / (WINDOW_TICKS * GUARD_TICK_MS));
+
+    unsigned long now = clockMillis();
+    bool open = valveOpenCount() > 0;
+    if (open && !wasOpen && !env.run) {     // manuelle Öffnung = eigener Lauf
+        runPulses = 0;
+        runStartMs = now;
+    }
+    if (!open && wasOpen) {
+        closedSinceMs = now;
+        closedOverMs = 0;
+    }
+    wasOpen = open;
+    if (open || env.run) runPulses += d;
+
+    if (tripped) return;
+    float runL = runPulses / k;
+    if (open && lpm > env.maxLpm) {
+        guardTrip(GuardReason::BURST, lpm, env.maxLpm, runL, env.maxL, now - runStartMs);
+    } else if ((open || env.run) && runL > env.maxL) {
+        guardTrip(GuardReason::VOLUME, lpm, env.maxLpm, runL, env.maxL, now - runStartMs);
+    } else if (!open && now - closedSinceMs >= GUARD_CLOSED_GRACE_MS) {
+        closedOverMs = lpm > GUARD_CLOSED_MAX_LPM ? closedOverMs + GUARD_TICK_MS : 0;
+        if (closedOverMs >= GUARD_CLOSED_CONFIRM_MS) {
+            guardTrip(GuardReason::CLOSED_FLOW, lpm, GUARD_CLOSED_MAX_LPM, runL, env.maxL, now - closedSinceMs);
+        }
+    }
+}
+
+void guardInit() {
+    tripped = handled = reported = restored = false;
+    closedSinceMs = clockMillis();
+    lastIsrPulses = flowGetIsrPulses();
+
+    GuardTrip t;
+    HalNvs p;
+    p.begin("guard", true);
+    size_t len = p.getBytes("trip", &t, sizeof(t));
+    p.end();
+    if (len == sizeof(t) && t.magic == TRIP_MAGIC) {
+        trip = t;
+        restored = true;
+        tripped = true;
+        valveEmergencyClose();
+        logWarn(String("Flow guard alarm still latched: ") + guardReasonName(t.reason));
+    }
+
+    if (!halTimerStart(guardTick, GUARD_TICK_MS)) logError("Flow guard timer failed");
+    logInfo("Flow guard: max " + String(GUARD_MAX_LPM, 1) + " L/min, " + String(GUARD_RUN_MAX_L, 0) + " L/run, every " + String(GUARD_TICK_MS) + " ms");
+}
+
+void guardLoop() {
+    if (!tripped) return;
+    GuardTrip t = trip;
+
+    if (!handled) {
+        handled = true;
+        // Zustand zur Notabschaltung nachziehen
+        seqCancel();
+        runlogNoteStop(RunStop::GUARD);
+        irrigationCancelRun("flow guard");
+        irrigationSetMode(IrrigationMode::MANUAL);
+        valveSet(ValveState::CLOSED);
+        guardEndRun();
+        if (!restored) {
+            HalNvs p;
+            p.begin("guard", false);
+            p.putBytes("trip", &t, sizeof(t));
+            p.end();
+            metricInc(MC_GUARD_TRIPS);
+            logError(String("FLOW GUARD: ") + guardReasonName(t.reason) + " " + String(t.lpm, 1) + " L/min, " +
+                     String(t.runL, 1) + " L -> valves closed");
+        }
+    }
+
+    if (reported || !mqttIsConnected()) return;
+    reported = true;
+    String extra = "\"reason\":\"" + String(guardReasonName(t.reason)) + "\"";
+    extra += ",\"zones\":" + String(t.zones);
+    extra += ",\"lpm\":" + String(t.lpm, 2);
+    extra += ",\"max_lpm\":" + String(t.limitLpm, 2);
+    extra += ",\"run_l\":" + String(t.runL, 2);
+    extra += ",\"max_l\":" + String(t.limitL, 1);
+    extra += ",\"elapsed_ms\":" + String(t.elapsedMs);
+    extra += ",\"trip_ts\":" + String(t.epoch);
+    extra += ",\"latched\":true";
+    mqttPublishEvent("alarm_flow", extra);
+}
+
+void guardBeginRun(float maxLpm, float maxL) {
+    halInterruptsOff();
+    env = { maxLpm, maxL, true };
+    runPulses = 0;
+    runStartMs = clockMillis();
+    halInterruptsOn();
+}
+
+void guardEndRun() {
+    halInterruptsOff();
+    env = { GUARD_MAX_LPM, GUARD_RUN_MAX_L, false };
+    runPulses = 0;
+    runStartMs = clockMillis();
+    halInterruptsOn();
+}
+
+bool guardIsTripped() { return tripped; }
+
+bool guardGetTrip(GuardTrip &out) {
+    if (!tripped) return false;
+    out = trip;
+    return true;
+}
+
+void guardReset() {
+    if (!tripped) return;
+    HalNvs p;
+    p.begin("guard", false);
+    p.remove("trip");
+    p.end();
+
+    halInterruptsOff();
+    closedSinceMs = clockMillis();
+    closedOverMs = 0;
+    tripped = false;
+    halInterruptsOn();
+    handled = reported = restored = false;
+    valveEmergencyRelease();
+    logInfo("Flow guard alarm reset");
+    mqttPublishEvent("alarm_flow_cleared");
+}
+
+const char* guardReasonName(GuardReason r) {
+    switch (r) {
+        case GuardReason::BURST:       return "burst";
+        case GuardReason::VOLUME:      return "volume";
+        case GuardReason::CLOSED_FLOW: return "closed_flow";
+        default:                       return "none";
+    }
+}
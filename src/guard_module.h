@@ -0,0 +1,39 @@
+#pragma once
+#include <Arduino.h>
+
+// Schnellabschaltung: prüft den Durchfluss alle GUARD_TICK_MS in einem
+// eigenen Timer (halTimerStart), also auch, wenn loop() gerade im WLAN/MQTT
+// hängt. Verletzt der Durchfluss die Hüllkurve des Laufs, werden die
+// Ausgänge sofort im Timer abgeschaltet (valveEmergencyClose); loop()
+// beendet danach Lauf und Sequencer und meldet den Alarm.
+//
+// Hüllkurve je Lauf: max. L/min (über GUARD_WINDOW_MS), max. Menge je Lauf,
+// und kein Durchfluss bei geschlossenen Ventilen nach dem Nachlauf.
+// Der Alarm ist verriegelt (auch über Neustart, Flash) bis guardReset().
+
+enum class GuardReason : uint8_t { NONE, BURST, VOLUME, CLOSED_FLOW };
+
+struct GuardTrip {
+    uint32_t    magic;
+    GuardReason reason;
+    uint8_t     zones;          // beim Auslösen offene Zonen (Bit 0 = Zone 1)
+    float       lpm;            // gemessen über GUARD_WINDOW_MS
+    float       limitLpm;
+    float       runL;           // Menge seit Laufbeginn
+    float       limitL;
+    uint32_t    elapsedMs;      // seit Laufbeginn bzw. seit dem Schließen
+    uint32_t    epoch;          // 0 = ohne gültige Zeit
+};
+
+void guardInit();
+void guardLoop();               // Alarm melden, Lauf beenden (nur aus loop())
+
+// Hüllkurve für den nächsten/laufenden Programm-Lauf, bis guardEndRun().
+// Ohne Lauf gilt je Öffnung GUARD_MAX_LPM / GUARD_RUN_MAX_L.
+void guardBeginRun(float maxLpm, float maxL);
+void guardEndRun();
+
+bool guardIsTripped();
+bool guardGetTrip(GuardTrip &out);   // false = kein Alarm
+void guardReset();                   // quittieren, Ventile wieder freigeben
+const char* guardReasonName(GuardReason r);
@@ -0,0 +1,231 @@
+#pragma once
+#include <Arduino.h>
+#include "clock_module.h"
+
+// Dünne Hardware-Schicht: alles, was die Module vom Chip brauchen
+// (GPIO, Interrupts, ADC, NVS, Netzwerk, Watchdog, System). Die Uhr kommt
+// aus clock_module.h.
+//
+// ESP32: Inline-Wrapper um Arduino/ESP-IDF, kein Overhead, ISR-tauglich.
+// Host (-D HAL_HOST, [env:native]): Simulation in hal_host.cpp, von außen
+// steuerbar über die halHost*()-Funktionen unten.
+
+#ifndef HAL_HOST
+
+#include <Preferences.h>
+#include <WiFi.h>
+#include <PubSubClient.h>
+#include <esp_task_wdt.h>
+#include <esp_timer.h>
+#include <esp_partition.h>
+
+// === GPIO / INTERRUPTS / ADC ===
+inline void halPinMode(uint8_t pin, uint8_t mode) { pinMode(pin, mode); }
+inline void halDigitalWrite(uint8_t pin, uint8_t level) { digitalWrite(pin, level); }
+inline int  halDigitalRead(uint8_t pin) { return digitalRead(pin); }
+inline void halAttachInterrupt(uint8_t pin, void (*isr)(), int mode) {
+    attachInterrupt(digitalPinToInterrupt(pin), isr, mode);
+}
+inline void halInterruptsOff() { noInterrupts(); }
+inline void halInterruptsOn() { interrupts(); }
+inline void halAnalogInit(uint8_t pin) {
+    pinMode(pin, INPUT);
+    analogSetAttenuation(ADC_11db);     // voller Bereich bis ~3,1 V
+}
+inline uint32_t halAnalogReadMilliVolts(uint8_t pin) { return analogReadMilliVolts(pin); }
+
+// === NVS ===
+typedef Preferences HalNvs;
+
+// === WATCHDOG (Task-WDT für den Loop-Task) ===
+inline void halWdtInit(uint32_t timeoutMs) {
+    esp_task_wdt_config_t cfg = {
+        .timeout_ms = timeoutMs,
+        .idle_core_mask = (1 << 0), // C6 hat nur Core 0
+        .trigger_panic = true       // Reboot bei Hänger
+    };
+    esp_task_wdt_init(&cfg);
+    esp_task_wdt_add(NULL);
+}
+inline void halWdtReset() { esp_task_wdt_reset(); }
+inline void halWdtDeleteTask() { esp_task_wdt_delete(NULL); }
+
+// === SYSTEM ===
+inline void halDelay(unsigned long ms) { delay(ms); }
+inline void halRestart() { ESP.restart(); }
+inline uint32_t halFreeHeap() { return ESP.getFreeHeap(); }
+inline uint32_t halMinFreeHeap() { return ESP.getMinFreeHeap(); }
+inline uint32_t halChipId() { return (uint32_t)ESP.getEfuseMac(); }
+// echte Laufzeit (Loop-Messung), auch wenn die Logik-Uhr simuliert ist
+inline unsigned long halRealMillis() { return millis(); }
+inline unsigned long halRealMicros() { return micros(); }
+
+// === PERIODISCHER TIMER ===
+// Läuft im esp_timer-Task (hohe Priorität), also auch, wenn loop() im
+// Netzwerk hängt. Callback kurz halten: kein Logging, keine Strings.
+inline bool halTimerStart(void (*cb)(), uint32_t periodMs) {
+    esp_timer_create_args_t args = {};
+    args.callback = [](void* arg) { ((void (*)())arg)(); };
+    args.arg = (void*)cb;
+    args.name = "hal_timer";
+    esp_timer_handle_t h;
+    if (esp_timer_create(&args, &h) != ESP_OK) return false;
+    return esp_timer_start_periodic(h, (uint64_t)periodMs * 1000ULL) == ESP_OK;
+}
+
+// === DATEN-FLASH ===
+// Die "spiffs"-Partition (min_spiffs.csv) als Rohspeicher für Ringpuffer,
+// ohne Dateisystem. Löschen nur sektorweise, Schreiben nur 1 -> 0.
+static const uint32_t HAL_FLASH_SECTOR = 4096;
+inline const esp_partition_t* halDataPartition() {
+    static const esp_partition_t* part =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, nullptr);
+    return part;
+}
+inline uint32_t halFlashSize() { return halDataPartition() ? halDataPartition()->size : 0; }
+inline bool halFlashRead(uint32_t off, void* buf, size_t len) {
+    return halDataPartition() && esp_partition_read(halDataPartition(), off, buf, len) == ESP_OK;
+}
+inline bool halFlashWrite(uint32_t off, const void* buf, size_t len) {
+    return halDataPartition() && esp_partition_write(halDataPartition(), off, buf, len) == ESP_OK;
+}
+inline bool halFlashEraseSector(uint32_t off) {
+    return halDataPartition() && esp_partition_erase_range(halDataPartition(), off, HAL_FLASH_SECTOR) == ESP_OK;
+}
+
+// === NETZWERK ===
+inline void halSntpStart(long tzOffsetSec, const char* server) { configTime(tzOffsetSec, 0, server); }
+inline void halWifiBegin(const char* ssid, const char* pass) {
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(ssid, pass);
+}
+inline void halWifiDisconnect() { WiFi.disconnect(false, false); }
+inline bool halWifiConnected() { return WiFi.status() == WL_CONNECTED; }
+inline String halWifiIp() { return WiFi.localIP().toString(); }
+inline int halWifiRssi() { return WiFi.RSSI(); }
+
+// MQTT-Client über WLAN. Die Basisklasse mit dem Socket kommt zuerst,
+// damit er steht, bevor PubSubClient ihn übernimmt.
+struct HalWifiSocket { WiFiClient socket; };
+class HalMqttClient : private HalWifiSocket, public PubSubClient {
+public:
+    HalMqttClient() : PubSubClient(socket) {}
+};
+
+#else // HAL_HOST
+
+#include <map>
+#include <string>
+#include <vector>
+
+void halPinMode(uint8_t pin, uint8_t mode);
+void halDigitalWrite(uint8_t pin, uint8_t level);
+int  halDigitalRead(uint8_t pin);
+void halAttachInterrupt(uint8_t pin, void (*isr)(), int mode);
+void halInterruptsOff();
+void halInterruptsOn();
+void halAnalogInit(uint8_t pin);
+uint32_t halAnalogReadMilliVolts(uint8_t pin);
+
+// NVS im RAM; Namensräume und Typen wie Preferences, bleibt über halHostReset() erhalten
+class HalNvs {
+public:
+    bool begin(const char* name, bool readOnly = false);
+    void end();
+    bool remove(const char* key);
+    bool clear();
+
+    size_t getBytesLength(const char* key);
+    size_t getBytes(const char* key, void* buf, size_t maxLen);
+    size_t putBytes(const char* key, const void* value, size_t len);
+
+    int32_t  getInt(const char* key, int32_t def = 0);
+    size_t   putInt(const char* key, int32_t v);
+    uint8_t  getUChar(const char* key, uint8_t def = 0);
+    size_t   putUChar(const char* key, uint8_t v);
+    uint32_t getULong(const char* key, uint32_t def = 0);
+    size_t   putULong(const char* key, uint32_t v);
+    int64_t  getLong64(const char* key, int64_t def = 0);
+    size_t   putLong64(const char* key, int64_t v);
+    float    getFloat(const char* key, float def = 0);
+    size_t   putFloat(const char* key, float v);
+    String   getString(const char* key, const String &def = String());
+    size_t   putString(const char* key, const String &v);
+
+private:
+    template <typename T> T getValue(const char* key, T def);
+    template <typename T> size_t putValue(const char* key, T v);
+    std::string ns;
+    bool open = false;
+    bool readOnly = true;
+};
+
+void halWdtInit(uint32_t timeoutMs);
+void halWdtReset();
+void halWdtDeleteTask();
+
+void halDelay(unsigned long ms);        // läuft auf der simulierten Uhr
+void halRestart();
+uint32_t halFreeHeap();
+uint32_t halMinFreeHeap();
+uint32_t halChipId();
+unsigned long halRealMillis();
+unsigned long halRealMicros();
+
+// Daten-Flash im RAM (HAL_HOST_FLASH_SIZE), verhält sich wie NOR-Flash, bleibt über halHostReset() erhalten
+static const uint32_t HAL_FLASH_SECTOR = 4096;
+uint32_t halFlashSize();
+bool halFlashRead(uint32_t off, void* buf, size_t len);
+bool halFlashWrite(uint32_t off, const void* buf, size_t len);
+bool halFlashEraseSector(uint32_t off);
+
+// feuert, wenn die simulierte Uhr über halHostAdvanceMs()/halHostPulses()/halDelay() läuft
+bool halTimerStart(void (*cb)(), uint32_t periodMs);
+
+void halSntpStart(long tzOffsetSec, const char* server);
+void halWifiBegin(const char* ssid, const char* pass);
+void halWifiDisconnect();
+bool halWifiConnected();
+String halWifiIp();
+int halWifiRssi();
+
+// MQTT ohne Broker: Publishes landen im Protokoll, Kommandos per halHostMqttInject()
+class HalMqttClient {
+public:
+    typedef void (*Callback)(char* topic, uint8_t* payload, unsigned int length);
+    bool setBufferSize(uint16_t size) { (void)size; return true; }
+    void setServer(const char* host, uint16_t port) { (void)host; (void)port; }
+    void setCallback(Callback cb);
+    bool connect(const char* id, const char* user, const char* pass,
+                 const char* willTopic, uint8_t willQos, bool willRetain, const char* willMessage);
+    void disconnect();
+    bool connected();
+    int  state();
+    bool publish(const char* topic, const char* payload, bool retained = false);
+    bool subscribe(const char* topic);
+    bool loop();
+};
+
+// === HOST-STEUERUNG (Simulation, Unit-Tests, Benchmarks) ===
+struct HalHostMessage {
+    String topic;
+    String payload;
+    bool   retained;
+};
+
+void halHostReset();                                 // Pins, Timer, Netz, Zähler; NVS bleibt
+void halHostSetInput(uint8_t pin, int level);        // Flanke löst die ISR aus
+void halHostPulses(uint8_t pin, uint32_t count, uint32_t periodUs);  // n fallende Flanken, Uhr läuft mit
+void halHostAdvanceMs(uint32_t ms);                  // Uhr vorstellen, fällige Timer unterwegs auslösen
+void halHostSetAnalogMv(uint8_t pin, uint32_t mv);
+int  halHostGetOutput(uint8_t pin);                  // -1 = kein Ausgang (hochohmig)
+void halHostSetWifi(bool connected);
+void halHostSetMqtt(bool reachable);
+void halHostMqttInject(const char* topic, const String &payload);
+const std::vector<HalHostMessage> &halHostMqttLog();  // letzte HAL_HOST_MQTT_LOG Publishes
+void halHostMqttClearLog();
+void halHostNvsErase();                              // NVS und Daten-Flash
+uint32_t halHostWdtFeeds();
+uint32_t halHostRestarts();                          // Zahl der halRestart()-Aufrufe
+
+#endif
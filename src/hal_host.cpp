@@ -0,0 +1,376 @@
+// Host-Umsetzung von hal.h ([env:native]). Auf dem ESP32 leer.
+#ifdef HAL_HOST
+
+#include "hal.h"
+#include "config.h"
+#include "logger.h"
+#include "web_module.h"
+#include "ota_module.h"
+#include <algorithm>
+#include <chrono>
+
+HardwareSerial Serial;
+
+static const int HOST_PINS = 64;
+static const size_t HAL_HOST_MQTT_LOG = 256;
+static const int HOST_TIMERS = 4;
+
+// === TIMER ===
+// Feuern zum fälligen Zeitpunkt der simulierten Uhr, nicht in Echtzeit
+struct HostTimer {
+    void        (*cb)();
+    unsigned long periodUs;
+    unsigned long dueUs;
+};
+static HostTimer timers[HOST_TIMERS];
+static int timerCount = 0;
+
+bool halTimerStart(void (*cb)(), uint32_t periodMs) {
+    if (timerCount >= HOST_TIMERS || periodMs == 0) return false;
+    timers[timerCount++] = { cb, periodMs * 1000UL, clockMicros() + periodMs * 1000UL };
+    return true;
+}
+
+static void advanceTo(unsigned long untilUs) {
+    long rest;
+    while ((rest = (long)(untilUs - clockMicros())) > 0) clockSimAdvanceUs(min(rest, 1000000000L));
+}
+
+// Fällige Timer bis 'untilUs' auslösen, Uhr dabei auf den jeweiligen Zeitpunkt stellen
+static void timersRunUntil(unsigned long untilUs) {
+    for (;;) {
+        int next = -1;
+        for (int i = 0; i < timerCount; i++) {
+            if ((long)(timers[i].dueUs - untilUs) > 0) continue;
+            if (next < 0 || (long)(timers[i].dueUs - timers[next].dueUs) < 0) next = i;
+        }
+        if (next < 0) break;
+        advanceTo(timers[next].dueUs);
+        timers[next].dueUs += timers[next].periodUs;
+        timers[next].cb();
+    }
+    advanceTo(untilUs);
+}
+
+void halHostAdvanceMs(uint32_t ms) {
+    timersRunUntil(clockMicros() + ms * 1000UL);
+}
+
+// === GPIO / INTERRUPTS / ADC ===
+struct HostPin {
+    uint8_t  mode;
+    uint8_t  out;           // geschriebener Pegel (nur OUTPUT)
+    int8_t   ext;           // von außen getrieben, -1 = offen
+    uint32_t mv;            // ADC
+    void   (*isr)();
+    int      isrMode;
+};
+static HostPin pins[HOST_PINS];
+static bool irqOff = false;
+
+static int pinLevel(const HostPin &p) {
+    if (p.mode == OUTPUT) return p.out;
+    if (p.ext >= 0) return p.ext;
+    return p.mode == INPUT_PULLUP ? HIGH : LOW;
+}
+
+void halPinMode(uint8_t pin, uint8_t mode) { if (pin < HOST_PINS) pins[pin].mode = mode; }
+void halDigitalWrite(uint8_t pin, uint8_t level) { if (pin < HOST_PINS) pins[pin].out = level ? HIGH : LOW; }
+int  halDigitalRead(uint8_t pin) { return pin < HOST_PINS ? pinLevel(pins[pin]) : LOW; }
+
+void halAttachInterrupt(uint8_t pin, void (*isr)(), int mode) {
+    if (pin >= HOST_PINS) return;
+    pins[pin].isr = isr;
+    pins[pin].isrMode = mode;
+}
+
+void halInterruptsOff() { irqOff = true; }
+void halInterruptsOn() { irqOff = false; }
+void halAnalogInit(uint8_t pin) { halPinMode(pin, INPUT); }
+uint32_t halAnalogReadMilliVolts(uint8_t pin) { return pin < HOST_PINS ? pins[pin].mv : 0; }
+
+void halHostSetInput(uint8_t pin, int level) {
+    if (pin >= HOST_PINS) return;
+    HostPin &p = pins[pin];
+    int before = pinLevel(p);
+    p.ext = level;
+    int after = pinLevel(p);
+    if (!p.isr || irqOff || before == after) return;
+    bool rising = after == HIGH;
+    if (p.isrMode == CHANGE || (p.isrMode == RISING && rising) || (p.isrMode == FALLING && !rising)) p.isr();
+}
+
+void halHostPulses(uint8_t pin, uint32_t count, uint32_t periodUs) {
+    for (uint32_t i = 0; i < count; i++) {
+        timersRunUntil(clockMicros() + periodUs);
+        halHostSetInput(pin, LOW);
+        halHostSetInput(pin, HIGH);
+    }
+}
+
+void halHostSetAnalogMv(uint8_t pin, uint32_t mv) { if (pin < HOST_PINS) pins[pin].mv = mv; }
+
+int halHostGetOutput(uint8_t pin) {
+    if (pin >= HOST_PINS || pins[pin].mode != OUTPUT) return -1;
+    return pins[pin].out;
+}
+
+// === NVS ===
+// Namensraum -> Schlüssel -> Bytes. Wie beim ESP32 überlebt das einen Neustart.
+static std::map<std::string, std::map<std::string, std::string>> nvs;
+
+bool HalNvs::begin(const char* name, bool ro) {
+    ns = name;
+    readOnly = ro;
+    open = true;
+    return true;
+}
+
+void HalNvs::end() { open = false; }
+
+bool HalNvs::remove(const char* key) {
+    if (!open || readOnly) return false;
+    return nvs[ns].erase(key) > 0;
+}
+
+bool HalNvs::clear() {
+    if (!open || readOnly) return false;
+    nvs[ns].clear();
+    return true;
+}
+
+size_t HalNvs::getBytesLength(const char* key) {
+    if (!open) return 0;
+    auto &m = nvs[ns];
+    auto it = m.find(key);
+    return it == m.end() ? 0 : it->second.size();
+}
+
+size_t HalNvs::getBytes(const char* key, void* buf, size_t maxLen) {
+    size_t len = getBytesLength(key);
+    if (len == 0 || len > maxLen) return 0;
+    memcpy(buf, nvs[ns][key].data(), len);
+    return len;
+}
+
+size_t HalNvs::putBytes(const char* key, const void* value, size_t len) {
+    if (!open || readOnly) return 0;
+    nvs[ns][key] = std::string((const char*)value, len);
+    return len;
+}
+
+template <typename T> T HalNvs::getValue(const char* key, T def) {
+    T v;
+    return getBytes(key, &v, sizeof(v)) == sizeof(v) ? v : def;
+}
+
+template <typename T> size_t HalNvs::putValue(const char* key, T v) {
+    return putBytes(key, &v, sizeof(v));
+}
+
+int32_t  HalNvs::getInt(const char* key, int32_t def) { return getValue(key, def); }
+size_t   HalNvs::putInt(const char* key, int32_t v) { return putValue(key, v); }
+uint8_t  HalNvs::getUChar(const char* key, uint8_t def) { return getValue(key, def); }
+size_t   HalNvs::putUChar(const char* key, uint8_t v) { return putValue(key, v); }
+uint32_t HalNvs::getULong(const char* key, uint32_t def) { return getValue(key, def); }
+size_t   HalNvs::putULong(const char* key, uint32_t v) { return putValue(key, v); }
+int64_t  HalNvs::getLong64(const char* key, int64_t def) { return getValue(key, def); }
+size_t   HalNvs::putLong64(const char* key, int64_t v) { return putValue(key, v); }
+float    HalNvs::getFloat(const char* key, float def) { return getValue(key, def); }
+size_t   HalNvs::putFloat(const char* key, float v) { return putValue(key, v); }
+
+String HalNvs::getString(const char* key, const String &def) {
+    if (!open) return def;
+    auto &m = nvs[ns];
+    auto it = m.find(key);
+    return it == m.end() ? def : String(it->second);
+}
+
+size_t HalNvs::putString(const char* key, const String &v) {
+    return putBytes(key, v.c_str(), v.length());
+}
+
+// === DATEN-FLASH ===
+// 128 KB wie die spiffs-Partition von min_spiffs.csv; Schreiben kann Bits nur löschen
+static const uint32_t HAL_HOST_FLASH_SIZE = 0x20000;
+static std::vector<uint8_t> flash(HAL_HOST_FLASH_SIZE, 0xFF);
+
+uint32_t halFlashSize() { return HAL_HOST_FLASH_SIZE; }
+
+bool halFlashRead(uint32_t off, void* buf, size_t len) {
+    if (off + len > HAL_HOST_FLASH_SIZE) return false;
+    memcpy(buf, &flash[off], len);
+    return true;
+}
+
+bool halFlashWrite(uint32_t off, const void* buf, size_t len) {
+    if (off + len > HAL_HOST_FLASH_SIZE) return false;
+    const uint8_t* b = (const uint8_t*)buf;
+    for (size_t i = 0; i < len; i++) flash[off + i] &= b[i];
+    return true;
+}
+
+bool halFlashEraseSector(uint32_t off) {
+    if (off % HAL_FLASH_SECTOR || off >= HAL_HOST_FLASH_SIZE) return false;
+    memset(&flash[off], 0xFF, HAL_FLASH_SECTOR);
+    return true;
+}
+
+void halHostNvsErase() {
+    nvs.clear();
+    std::fill(flash.begin(), flash.end(), 0xFF);
+}
+
+// === WATCHDOG / SYSTEM ===
+static uint32_t wdtFeeds = 0;
+static uint32_t restarts = 0;
+static const auto realStart = std::chrono::steady_clock::now();
+
+void halWdtInit(uint32_t timeoutMs) { (void)timeoutMs; }
+void halWdtReset() { wdtFeeds++; }
+void halWdtDeleteTask() {}
+
+void halDelay(unsigned long ms) { halHostAdvanceMs(ms); }
+void halRestart() { restarts++; }
+uint32_t halFreeHeap() { return 0; }
+uint32_t halMinFreeHeap() { return 0; }
+uint32_t halChipId() { return 0; }
+
+unsigned long halRealMicros() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - realStart).count();
+}
+unsigned long halRealMillis() { return halRealMicros() / 1000; }
+
+uint32_t halHostWdtFeeds() { return wdtFeeds; }
+uint32_t halHostRestarts() { return restarts; }
+
+// === NETZWERK ===
+// Zeit kommt per clockSimReset()/clockSimSetEpoch(), nicht per SNTP
+void halSntpStart(long tzOffsetSec, const char* server) { (void)tzOffsetSec; (void)server; }
+
+static bool wifiUp = true;
+static bool brokerUp = true;
+static bool mqttSession = false;
+static int  mqttState = -1;             // PubSubClient: -1 getrennt, -2 Verbindung fehlgeschlagen
+static HalMqttClient::Callback mqttCb = nullptr;
+static std::vector<std::string> mqttSubs;
+static std::vector<HalHostMessage> mqttLog;
+
+void halWifiBegin(const char* ssid, const char* pass) { (void)ssid; (void)pass; }
+void halWifiDisconnect() {}
+bool halWifiConnected() { return wifiUp; }
+String halWifiIp() { return wifiUp ? String("127.0.0.1") : String("0.0.0.0"); }
+int halWifiRssi() { return wifiUp ? -50 : 0; }
+
+void HalMqttClient::setCallback(Callback cb) { mqttCb = cb; }
+
+bool HalMqttClient::connect(const char* id, const char* user, const char* pass,
+                            const char* willTopic, uint8_t willQos, bool willRetain, const char* willMessage) {
+    (void)id; (void)user; (void)pass; (void)willTopic; (void)willQos; (void)willRetain; (void)willMessage;
+    mqttSession = wifiUp && brokerUp;
+    mqttState = mqttSession ? 0 : -2;
+    mqttSubs.clear();
+    return mqttSession;
+}
+
+void HalMqttClient::disconnect() {
+    mqttSession = false;
+    mqttState = -1;
+}
+
+bool HalMqttClient::connected() {
+    if (mqttSession && !(wifiUp && brokerUp)) disconnect();
+    return mqttSession;
+}
+
+int HalMqttClient::state() { return mqttState; }
+
+bool HalMqttClient::publish(const char* topic, const char* payload, bool retained) {
+    if (!connected()) return false;
+    if (mqttLog.size() >= HAL_HOST_MQTT_LOG) mqttLog.erase(mqttLog.begin());
+    mqttLog.push_back({ String(topic), String(payload), retained });
+    return true;
+}
+
+bool HalMqttClient::subscribe(const char* topic) {
+    if (!connected()) return false;
+    mqttSubs.push_back(topic);
+    return true;
+}
+
+bool HalMqttClient::loop() { return connected(); }
+
+void halHostSetWifi(bool connected) { wifiUp = connected; }
+void halHostSetMqtt(bool reachable) { brokerUp = reachable; }
+
+void halHostMqttInject(const char* topic, const String &payload) {
+    if (!mqttSession || !mqttCb) return;
+    if (std::find(mqttSubs.begin(), mqttSubs.end(), topic) == mqttSubs.end()) return;
+    std::string t(topic);
+    std::string p(payload.c_str());
+    mqttCb(&t[0], (uint8_t*)&p[0], p.size());
+}
+
+const std::vector<HalHostMessage> &halHostMqttLog() { return mqttLog; }
+void halHostMqttClearLog() { mqttLog.clear(); }
+
+void halHostReset() {
+    memset(pins, 0, sizeof(pins));
+    for (auto &p : pins) p.ext = -1;
+    irqOff = false;
+    timerCount = 0;
+    wifiUp = brokerUp = true;
+    mqttSession = false;
+    mqttState = -1;
+    mqttSubs.clear();
+    mqttLog.clear();
+    wdtFeeds = restarts = 0;
+}
+
+// === MODULE OHNE HOST-VARIANTE ===
+// Web-Server, SSE und OTA hängen direkt an WebServer/lwip/OTA-Partitionen
+// und sind im native-Build ausgenommen (build_src_filter).
+void webInit() {}
+void webLoop() {}
+void webPublishRouteStats() {}
+void otaInit() {}
+void otaLoop() {}
+int otaGetProgressPct() { return -1; }
+bool otaPullStart(const String &url, const String &sha256Hex) {
+    (void)url; (void)sha256Hex;
+    logWarn("OTA not available on host");
+    return false;
+}
+
+// === FIRMWARE AUF DEM PC ===
+// program [tage] [schritt_ms] [epoch]: setup(), dann loop() im Takt der
+// simulierten Uhr, bis die Zeit um ist oder die Firmware neu starten will.
+#ifndef PIO_UNIT_TESTING
+void setup();
+void loop();
+
+int main(int argc, char** argv) {
+    double days = argc > 1 ? atof(argv[1]) : 1.0;
+    uint32_t stepMs = argc > 2 ? (uint32_t)atol(argv[2]) : 100;
+    time_t epoch = argc > 3 ? (time_t)atoll(argv[3]) : 1780272000;    // 2026-06-01 00:00 UTC
+    if (stepMs == 0) stepMs = 1;
+
+    halHostReset();
+    clockSimReset(0, epoch);
+    setup();
+
+    uint64_t loops = (uint64_t)(days * 86400000.0 / stepMs);
+    uint64_t i = 0;
+    for (; i < loops && halHostRestarts() == 0; i++) {
+        loop();
+        halHostAdvanceMs(stepMs);
+    }
+    double realS = halRealMicros() / 1e6;
+    printf("\n[HOST] %.2f days simulated in %.2f s (%llu loops, %u restarts, %u MQTT msgs kept)\n",
+           i * (double)stepMs / 86400000.0, realS, (unsigned long long)i, halHostRestarts(), (unsigned)mqttLog.size());
+    return 0;
+}
+#endif
+
+#endif // HAL_HOST
@@ -0,0 +1,174 @@
+#include "history_module.h"
+#include "config.h"
+#include "logger.h"
+#include "mqtt_module.h"
+#include "metrics_module.h"
+#include <atomic>
+
+static_assert(HIST_BLOCK_BYTES <= TS_BLOCK_MAX, "HIST_BLOCK_BYTES > TS_BLOCK_MAX");
+
+// Jeder Slot hat wie der Snapshot einen Sequenzzähler (ungerade = wird
+// geschrieben): der Web-Task kopiert einen Block und erkennt, ob der
+// Haupt-Loop ihn währenddessen geändert hat.
+struct HistSlot {
+    std::atomic<uint32_t> seq;
+    uint32_t firstSeq;      // Nummer des ersten Punkts (ab 1)
+    uint16_t count;
+    uint16_t len;
+    uint8_t  data[HIST_BLOCK_BYTES];
+};
+
+static HistSlot slots[HIST_BLOCKS];
+static std::atomic<uint32_t> oldest(0);    // Index des ältesten Slots
+static std::atomic<uint32_t> used(0);      // belegte Slots, der jüngste wächst noch
+static std::atomic<uint32_t> dropped(0);   // verworfene Blöcke insgesamt (Leser im Web-Task)
+static TsEncoder enc;                      // jüngster Block
+static uint32_t curFirst = 0;              // firstSeq des jüngsten Blocks
+static uint32_t nextSeq = 1;
+static uint32_t sentSeq = 0;               // bis hier per MQTT gesendet
+
+// Encoder-Stand in den Slot (Block bleibt jederzeit lesbar)
+static void slotWrite(HistSlot &s) {
+    s.seq.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.firstSeq = curFirst;
+    s.count = enc.count;
+    s.len = tsEncFinish(enc, s.data, sizeof(s.data));
+    s.seq.fetch_add(1, std::memory_order_release);
+}
+
+static void dropOldest() {
+    HistSlot &s = slots[oldest.load(std::memory_order_relaxed)];
+    uint32_t last = s.firstSeq + s.count - 1;
+    if (last > sentSeq) {
+        // nie gesendet (lange offline): wie früher die volle Queue als Drop zählen
+        for (uint32_t n = last - max(sentSeq, s.firstSeq - 1); n > 0; n--) metricInc(MC_MQTT_DROPS);
+        sentSeq = last;
+    }
+    dropped.fetch_add(1, std::memory_order_release);
+    oldest.store((oldest.load(std::memory_order_relaxed) + 1) % HIST_BLOCKS, std::memory_order_release);
+    used.fetch_sub(1, std::memory_order_release);
+}
+
+String historyPointJson(const TsPoint &p) {
+    String json = "{";
+    json += "\"ts\":" + String((unsigned long)p.ts) + ",";
+    json += "\"flow_l_min\":" + String(p.flowLpm, 2) + ",";
+    json += "\"total_l\":" + String(p.totalL, 2) + ",";
+    json += "\"vbat\":" + String(p.batV, 2) + ",";
+    json += "\"valve\":\"" + String(p.valveOpen ? "OPEN" : "CLOSED") + "\"";
+    json += "}";
+    return json;
+}
+
+void historyInit() {
+    for (int i = 0; i < HIST_BLOCKS; i++) {
+        slots[i].seq.store(0, std::memory_order_relaxed);
+        slots[i].firstSeq = 0;
+        slots[i].count = 0;
+        slots[i].len = 0;
+    }
+    oldest.store(0);
+    used.store(0);
+    dropped.store(0);
+    curFirst = 0;
+    nextSeq = 1;
+    sentSeq = 0;
+}
+
+void historyAdd(const DeviceSnapshot &s) {
+    TsPoint p = { (uint32_t)s.epoch, s.flowLpm, s.flowTotalL, s.batV, s.valve == ValveState::OPEN };
+    uint32_t seq = nextSeq++;
+
+    uint32_t n = used.load(std::memory_order_relaxed);
+    bool fresh = n == 0 || !tsEncAdd(enc, p);
+    if (fresh) {
+        if (n == HIST_BLOCKS) {
+            dropOldest();
+            n--;
+        }
+        tsEncBegin(enc, HIST_BLOCK_BYTES);
+        tsEncAdd(enc, p);
+        curFirst = seq;
+    }
+    // neuer Slot erst beschreiben, dann sichtbar machen
+    slotWrite(slots[(oldest.load(std::memory_order_relaxed) + n - (fresh ? 0 : 1)) % HIST_BLOCKS]);
+    if (fresh) used.fetch_add(1, std::memory_order_release);
+
+    // Live: nur wenn nichts mehr nachzusenden ist (Reihenfolge)
+    if (sentSeq + 1 == seq && mqttIsConnected()) {
+        if (mqttPublish(TOPIC_HISTORY, historyPointJson(p).c_str())) sentSeq = seq;
+    }
+}
+
+void historyLoop() {
+    if (sentSeq + 1 >= nextSeq || !mqttIsConnected()) return;
+    uint32_t start = oldest.load(std::memory_order_relaxed);
+    uint32_t n = used.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < n; i++) {
+        HistSlot &s = slots[(start + i) % HIST_BLOCKS];
+        uint32_t last = s.firstSeq + s.count - 1;
+        if (last <= sentSeq) continue;
+
+        TsDecoder dec;
+        TsPoint p;
+        int sent = 0;
+        tsDecBegin(dec, s.data, s.len);
+        for (uint32_t seq = s.firstSeq; tsDecNext(dec, p); seq++) {
+            if (seq <= sentSeq) continue;
+            if (!mqttPublish(TOPIC_HISTORY, historyPointJson(p).c_str())) return;
+            sentSeq = seq;
+            if (++sent >= HIST_REPLAY_PER_LOOP) return;
+        }
+        if (dec.error) {
+            logWarn("History block " + String(s.firstSeq) + " unreadable, skipped");
+            sentSeq = last;
+        }
+        return;
+    }
+}
+
+uint32_t historyPending() {
+    return nextSeq - 1 - sentSeq;
+}
+
+uint32_t historyStored() {
+    uint32_t start = oldest.load(std::memory_order_relaxed);
+    uint32_t n = used.load(std::memory_order_relaxed);
+    uint32_t points = 0;
+    for (uint32_t i = 0; i < n; i++) points += slots[(start + i) % HIST_BLOCKS].count;
+    return points;
+}
+
+uint32_t historyBytes() {
+    uint32_t start = oldest.load(std::memory_order_relaxed);
+    uint32_t n = used.load(std::memory_order_relaxed);
+    uint32_t bytes = 0;
+    for (uint32_t i = 0; i < n; i++) bytes += slots[(start + i) % HIST_BLOCKS].len;
+    return bytes;
+}
+
+int historyForEachBlock(HistoryBlockVisitor fn, void* ctx) {
+    uint8_t buf[HIST_BLOCK_BYTES];
+    uint32_t d0 = dropped.load(std::memory_order_acquire);
+    uint32_t start = oldest.load(std::memory_order_acquire);
+    uint32_t n = used.load(std::memory_order_acquire);
+    int blocks = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        HistSlot &s = slots[(start + i) % HIST_BLOCKS];
+        uint16_t len;
+        for (;;) {
+            uint32_t s1 = s.seq.load(std::memory_order_acquire);
+            if (s1 & 1) continue;
+            len = s.len;
+            memcpy(buf, s.data, len);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s.seq.load(std::memory_order_relaxed) == s1) break;
+        }
+        // Ring seit dem Start um mehr als i Blöcke weitergelaufen: Slot ist neu belegt
+        if (len == 0 || dropped.load(std::memory_order_acquire) - d0 > i) continue;
+        fn(buf, len, ctx);
+        blocks++;
+    }
+    return blocks;
+}
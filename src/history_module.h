@@ -0,0 +1,29 @@
+#pragma once
+#include <Arduino.h>
+#include "snapshot_module.h"
+#include "tscodec_module.h"
+
+// Verlauf (ein Punkt je Minute und bei jedem Ventilwechsel, Felder wie
+// TOPIC_HISTORY) kompakt im RAM: Ring aus HIST_BLOCKS Blöcken zu
+// HIST_BLOCK_BYTES im tscodec-Format (~1..3 Byte je Punkt statt ~90 Byte
+// JSON, also Tage statt der früheren 150 Punkte). Der jüngste Block wächst,
+// bis er voll ist; ist der Ring voll, fällt der älteste Block weg.
+// MQTT: online geht jeder Punkt sofort als JSON raus. Offline gesammelte
+// Punkte werden nach dem Reconnect aus den Blöcken dekodiert und in
+// Reihenfolge nachgesendet (HIST_REPLAY_PER_LOOP je Loop), gleiches Format.
+// Web: /api/history liefert die Blöcke roh (tools/tsc_tool.cpp dekodiert).
+
+void historyInit();
+void historyLoop();                         // Nachsenden nach Reconnect
+void historyAdd(const DeviceSnapshot &s);   // nur aus dem Haupt-Loop
+
+uint32_t historyPending();                  // noch nicht gesendet
+uint32_t historyStored();                   // Punkte im Ring
+uint32_t historyBytes();                    // belegte Bytes (Blöcke)
+
+// Blöcke älteste zuerst, aus beliebigem Task (jeder Block als stimmige Kopie)
+typedef void (*HistoryBlockVisitor)(const uint8_t* block, size_t len, void* ctx);
+int historyForEachBlock(HistoryBlockVisitor fn, void* ctx);
+
+// {"ts":...,"flow_l_min":...,"total_l":...,"vbat":...,"valve":"OPEN|CLOSED"}
+String historyPointJson(const TsPoint &p);
@@ -1,23 +1,490 @@
 #include "irrigation_module.h"
 #include "config.h"
+#include "clock_module.h"
+#include "hal.h"
 #include "logger.h"
 #include "valve_module.h"
 #include "flow_module.h" 
 #include "time_module.h" 
+#include "schedule_module.h"
+#include "settings_module.h"
+#include "rules_module.h"
+#include "sequencer_module.h"
+#include "mqtt_module.h"
+#include "guard_module.h"
+#include "signature_module.h"
+#include "runlog_module.h"
 #include <time.h> 
-#include <Preferences.h>
 
 static IrrigationMode currentMode = IrrigationMode::AUTO;
 static bool isRunning = false;
-static unsigned long runStartTime = 0;
-static unsigned long runDuration = 0;
 
 static IrrigationSlot slots[MAX_PROGRAM_SLOTS];
-static Preferences prefs; 
+static HalNvs prefs; 
+
+static bool scheduleDirty = true;       // Heap neu aufbauen
+static time_t lastScheduleCheck = 0;
+static time_t timeValidSince = 0;       // erste gültige Zeit nach dem Boot
+static time_t lastRuleMinute = 0;       // zuletzt geprüfte Minute der Cron-Regeln
+static uint32_t lastRulesVersion = 0;   // rulesGetVersion() beim letzten Abgleich
+
+// === MENGEN-LAUF ===
+// Ein Sensor für alle Zonen: bei mehreren offenen Zonen wird die Menge
+// gleichmäßig aufgeteilt.
+static float zoneTargetL[VALVE_ZONES];      // 0 = Zone läuft nach Zeit
+static float zoneDeliveredL[VALVE_ZONES];
+static uint16_t volDoneMask = 0;            // Ziel erreicht und geschlossen
+static uint16_t volOpenMask = 0;            // beim letzten Durchlauf offen
+static uint32_t volLastPulses = 0;
+
+// Nachlauf nach einem Mengen-Stopp messen (nur wenn danach alles zu bleibt)
+static bool runOnPending = false;
+static unsigned long runOnStartMs = 0;
+static uint32_t runOnStartPulses = 0;
+
+// === LAUF-WARTESCHLANGE ===
+// Nach Priorität (höher zuerst), dann Fälligkeit sortiert; nur RAM.
+static QueuedRun runQueue[IRR_RUN_QUEUE_LEN];
+static int runQueueLen = 0;
+static uint32_t runQueueVersion = 0;
+
+// Slot-Format bis FW 1.2.8 (ohne Menge), wird beim Laden übernommen
+struct IrrigationSlotV1 {
+    bool enabled;
+    uint8_t startHour;
+    uint8_t startMinute;
+    uint16_t durationSec;
+    uint8_t weekDays;
+    uint8_t zones;
+};
+
+// === LAUF-JOURNAL ===
+// Aktiver Lauf in RTC-RAM (überlebt Reset/Panic) und Flash (überlebt
+// Stromausfall). Flash wird nur bei Start und Ende geschrieben, die
+// gelieferte Menge nur im RTC-RAM nachgeführt.
+static const uint32_t JOURNAL_MAGIC = 0x4A524E31;   // "JRN1"
+static const unsigned long JOURNAL_RTC_UPDATE_MS = 10000;
+
+struct RunJournal {
+    uint32_t magic;
+    int8_t   slot;              // -1 = ohne Slot
+    uint8_t  zones;             // 0 = Zone 1 (Journal vor Mehrzonen-Firmware)
+    uint32_t durationSec;       // je Zone (Mengen-Lauf: Obergrenze)
+    float    volumeL;           // je Zone, 0 = nach Zeit
+    time_t   startEpoch;        // 0 = Zeit beim Start ungültig
+    time_t   endEpoch;
+    uint32_t startPulses;
+    uint32_t deliveredPulses;
+    uint32_t check;
+};
+
+// Nur vorhandene Zonen; nichts übrig = Zone 1. Alte Slots (8 Byte) hatten
+// an dieser Stelle ein Füllbyte, das aus einem ungelöschten Stack-Slot stammen
+// kann - ohne Maske würde so ein Slot 0 Zonen einreihen und nie gießen.
+static uint8_t zonesValid(uint8_t mask) {
+    mask &= (uint8_t)((1u << VALVE_ZONES) - 1);
+    return mask ? mask : 1;
+}
+
+RTC_DATA_ATTR static RunJournal rtcJournal;
+static RunJournal journal;
+static bool resumePending = false;
+static unsigned long lastJournalRtcMs = 0;
+
+static uint32_t journalCheck(const RunJournal &j) {
+    // FNV-1a über alles außer 'check'
+    const uint8_t* p = (const uint8_t*)&j;
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < offsetof(RunJournal, check); i++) h = (h ^ p[i]) * 16777619u;
+    return h;
+}
+
+static bool journalValid(const RunJournal &j) {
+    return j.magic == JOURNAL_MAGIC && j.check == journalCheck(j);
+}
+
+static void journalSave(bool toFlash) {
+    journal.check = journalCheck(journal);
+    rtcJournal = journal;
+    if (toFlash) {
+        prefs.begin("irr-run", false);
+        prefs.putBytes("jrnl", &journal, sizeof(journal));
+        prefs.end();
+    }
+}
+
+static void journalClear() {
+    memset(&journal, 0, sizeof(journal));
+    rtcJournal = journal;
+    prefs.begin("irr-run", false);
+    prefs.remove("jrnl");
+    prefs.end();
+}
+
+static void journalLoad() {
+    if (journalValid(rtcJournal)) {
+        journal = rtcJournal;
+    } else {
+        RunJournal j;
+        prefs.begin("irr-run", true);
+        size_t len = prefs.getBytes("jrnl", &j, sizeof(j));
+        prefs.end();
+        if (len == sizeof(j) && journalValid(j)) journal = j;
+        else memset(&journal, 0, sizeof(journal));
+    }
+    resumePending = (journal.magic == JOURNAL_MAGIC);
+    if (resumePending) {
+        logWarn("Interrupted run found (slot " + String(journal.slot + 1) + ", " + String(journal.durationSec) + " s)");
+    }
+}
+
+static float journalDeliveredLiters() {
+    float k = settingsGetFlowFactor();
+    if (k <= 0.1f) k = 450.0f;
+    return journal.deliveredPulses / k;
+}
+
+// Verbrauchte Slot-Termine sichern, damit ein Catch-up nach dem Boot nicht doppelt läuft
+static void saveLastDue() {
+    time_t last[MAX_PROGRAM_SLOTS];
+    for (int i = 0; i < MAX_PROGRAM_SLOTS; i++) last[i] = scheduleGetLastDue(i);
+    prefs.begin("irr-run", false);
+    prefs.putBytes("last", last, sizeof(last));
+    prefs.end();
+}
+
+// Nur die Minute des letzten Regel-Starts, nicht jede geprüfte Minute (Flash-Verschleiß)
+static void saveRuleMinute(time_t minute) {
+    prefs.begin("irr-run", false);
+    prefs.putLong64("rmin", minute);
+    prefs.end();
+}
+
+static time_t loadRuleMinute() {
+    prefs.begin("irr-run", true);
+    time_t t = prefs.getLong64("rmin", 0);
+    prefs.end();
+    return t;
+}
+
+// Jede Minute seit dem letzten Abgleich genau einmal gegen die Regeln prüfen.
+// Uhr rückwärts: warten, bis die Zeit lastRuleMinute wieder überholt.
+// Nachgeholt wird wie bei den Slots: nur innerhalb IRR_CATCHUP_WINDOW_S,
+// Minuten ohne gültige Zeit bis IRR_BOOT_CATCHUP_S, je Regel höchstens einmal.
+static void rulesCheck(time_t now) {
+    time_t minute = now - now % 60;
+    time_t windowFloor = minute - (time_t)IRR_CATCHUP_WINDOW_S;
+
+    // Neue Regeln gelten ab jetzt, nicht rückwirkend (auch nach langer Pause ohne Regeln)
+    if (rulesGetVersion() != lastRulesVersion) {
+        lastRulesVersion = rulesGetVersion();
+        lastRuleMinute = minute;
+        return;
+    }
+
+    time_t from;
+    if (lastRuleMinute == 0) {
+        // Erster Abgleich nach dem Boot: zusätzlich, was ohne gültige Zeit verpasst wurde
+        time_t bootFloor = timeValidSince - (time_t)IRR_BOOT_CATCHUP_S;
+        from = max(loadRuleMinute() + 60, min(windowFloor, bootFloor - bootFloor % 60));
+    } else {
+        from = max(lastRuleMinute + 60, windowFloor);
+    }
+
+    // Spätester Treffer je Regel
+    uint32_t due = 0;
+    time_t dueAt[MAX_RULES];
+    for (time_t t = from; t <= minute; t += 60) {
+        lastRuleMinute = t;
+        uint32_t hit = rulesMatchMinute(t);
+        for (uint32_t m = hit; m; m &= m - 1) dueAt[__builtin_ctz(m)] = t;
+        due |= hit;
+    }
+
+    time_t consumed = 0;
+    for (int rule = 0; rule < MAX_RULES; rule++) {
+        if (!((due >> rule) & 1)) continue;
+        if (currentMode != IrrigationMode::AUTO) {
+            logInfo("Rule " + String(rule + 1) + " skipped (MANUAL mode)");
+            continue;
+        }
+        long lateSec = (long)(now - dueAt[rule]);
+        long allowedSec = IRR_CATCHUP_WINDOW_S;
+        if (dueAt[rule] < timeValidSince) {
+            // verpasst, solange die Zeit ungültig war (Boot, spätes NTP)
+            lateSec = (long)(timeValidSince - dueAt[rule]);
+            allowedSec = IRR_BOOT_CATCHUP_S;
+        }
+        consumed = max(consumed, dueAt[rule]);
+        if (lateSec > allowedSec) {
+            logWarn("Rule " + String(rule + 1) + " missed (" + String(lateSec) + " s late)");
+            continue;
+        }
+        logInfo("Rule " + String(rule + 1) + " Triggered!" + (lateSec > 60 ? " (catch-up, " + String(lateSec) + " s late)" : String("")));
+        irrigationRequest(rulesGetDuration(rule), MAX_PROGRAM_SLOTS + rule, rulesGetZones(rule),
+                          rulesGetVolumeL(rule), rulesGetPriority(rule));
+    }
+    if (consumed) saveRuleMinute(consumed);
+}
+
+// Pro Durchlauf: Menge den offenen Zonen zuschreiben und Zonen vor dem Ziel
+// schließen - um den vorhergesagten Nachlauf früher, damit nichts überläuft.
+static void volumeTrack() {
+    uint32_t pulses = flowGetTotalPulses();
+    float liters = flowPulsesToLiters(pulses - volLastPulses);
+    volLastPulses = pulses;
+
+    uint16_t openMask = 0;
+    for (int z = 0; z < VALVE_ZONES; z++) if (valveZoneIsOpen(z)) openMask |= 1 << z;
+    int open = __builtin_popcount(openMask);
+
+    // Per Dauer-Obergrenze geschlossen, bevor die Menge erreicht war
+    uint16_t closed = volOpenMask & ~openMask & ~volDoneMask;
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        if (!((closed >> z) & 1) || zoneTargetL[z] <= 0.0f) continue;
+        logWarn("Zone " + String(z + 1) + ": volume not reached (" + String(zoneDeliveredL[z], 1) + " of " + String(zoneTargetL[z], 1) + " L)");
+        volDoneMask |= 1 << z;
+    }
+    volOpenMask = openMask;
+    if (open == 0) return;
+
+    float share = liters / open;
+    float lead = flowPredictOvershootL() / open;
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        if (!((openMask >> z) & 1) || zoneTargetL[z] <= 0.0f) continue;
+        zoneDeliveredL[z] += share;
+        if (zoneDeliveredL[z] + lead < zoneTargetL[z]) continue;
+
+        logInfo("Zone " + String(z + 1) + ": " + String(zoneTargetL[z], 1) + " L reached");
+        volDoneMask |= 1 << z;
+        volOpenMask &= ~(1 << z);
+        seqFinishZone(z);
+        if (open == 1) {
+            runOnPending = true;
+            runOnStartMs = clockMillis();
+            runOnStartPulses = pulses;
+        }
+    }
+}
+
+static String runName(int slot) {
+    if (slot < 0) return "manual";
+    if (slot >= MAX_PROGRAM_SLOTS) return "rule " + String(slot - MAX_PROGRAM_SLOTS + 1);
+    return "slot " + String(slot + 1);
+}
+
+static void queueEvent(const char* event, const QueuedRun &r) {
+    logInfo("Run " + runName(r.slot) + ": " + event);
+    mqttPublishEvent(event, "\"slot\":" + String(r.slot + 1) + ",\"queued\":" + String(runQueueLen));
+}
+
+static void queueRemove(int i) {
+    for (int k = i; k < runQueueLen - 1; k++) runQueue[k] = runQueue[k + 1];
+    runQueueLen--;
+    runQueueVersion++;
+}
+
+static void queueInsert(const QueuedRun &r) {
+    if (runQueueLen >= IRR_RUN_QUEUE_LEN) {
+        // Voll: den unwichtigsten (zuletzt einsortierten) Lauf opfern
+        const QueuedRun &last = runQueue[runQueueLen - 1];
+        if (last.priority >= r.priority) {
+            queueEvent("run_dropped", r);
+            return;
+        }
+        queueEvent("run_dropped", last);
+        runQueueLen--;
+    }
+    int i = runQueueLen;
+    while (i > 0 && runQueue[i - 1].priority < r.priority) {
+        runQueue[i] = runQueue[i - 1];
+        i--;
+    }
+    runQueue[i] = r;
+    runQueueLen++;
+    runQueueVersion++;
+    queueEvent("run_queued", r);
+}
+
+// Gleiche Zonen, gleiche Art (Zeit/Menge): laufenden oder wartenden Lauf verlängern
+static bool queueTryExtend(const QueuedRun &r) {
+    if (isRunning && journal.zones == r.zones && (journal.volumeL > 0.0f) == (r.volumeDl > 0)) {
+        if (r.volumeDl > 0) {
+            float add = r.volumeDl / 10.0f;
+            for (int z = 0; z < VALVE_ZONES; z++) {
+                if (!((r.zones >> z) & 1)) continue;
+                zoneTargetL[z] += add;
+                if ((volDoneMask >> z) & 1) {
+                    volDoneMask &= ~(1 << z);
+                    seqEnqueue(z, journal.durationSec);
+                }
+            }
+            journal.volumeL += add;
+        } else {
+            seqEnqueueProgram(r.zones, r.durationSec, 0);
+            journal.durationSec += r.durationSec;
+        }
+        journal.endEpoch = journal.startEpoch ? clockNow() + seqGetRemainingSec(clockMillis()) : 0;
+        journalSave(true);
+        queueEvent("run_extended", r);
+        return true;
+    }
+    for (int i = 0; i < runQueueLen; i++) {
+        QueuedRun &q = runQueue[i];
+        if (q.zones != r.zones || (q.volumeDl > 0) != (r.volumeDl > 0)) continue;
+        q.durationSec = min(3600, q.durationSec + r.durationSec);
+        q.volumeDl = min(60000, q.volumeDl + r.volumeDl);
+        runQueueVersion++;
+        queueEvent("run_extended", r);
+        return true;
+    }
+    return false;
+}
+
+// Gleiche Grenze wie der FAILSAFE in main.cpp: darüber startet kein Lauf mehr
+static bool dailyLimitReached() {
+    return valveGetDailyOpenMs() > (uint32_t)settingsGetDailyLimitSec() * 1000UL;
+}
+
+static void queueLoop() {
+    for (int i = 0; i < runQueueLen; ) {
+        if (clockMillis() - runQueue[i].queuedMs > IRR_QUEUE_MAX_WAIT_S * 1000UL) {
+            QueuedRun r = runQueue[i];
+            queueRemove(i);
+            queueEvent("run_expired", r);
+        } else {
+            i++;
+        }
+    }
+    if (runQueueLen == 0 || isRunning || resumePending) return;
+    if (currentMode != IrrigationMode::AUTO) return;   // wartet, bis wieder AUTO
+    if (dailyLimitReached()) return;                    // wartet auf den Tages-Reset (oder verfällt)
+
+    QueuedRun r = runQueue[0];
+    queueRemove(0);
+    long waited = (clockMillis() - r.queuedMs) / 1000;
+    logInfo("Run " + runName(r.slot) + " started from queue (waited " + String(waited) + " s)");
+    irrigationStart(r.durationSec, r.slot, r.zones, r.volumeDl / 10.0f);
+}
+
+static void loadLastDue() {
+    time_t last[MAX_PROGRAM_SLOTS];
+    prefs.begin("irr-run", true);
+    size_t len = prefs.getBytes("last", last, sizeof(last));
+    prefs.end();
+    if (len != sizeof(last)) return;
+    for (int i = 0; i < MAX_PROGRAM_SLOTS; i++) scheduleSetLastDue(i, last[i]);
+}
+
+// Hüllkurve für die Schnellabschaltung: Mengen-Lauf nach Ziel, Zeit-Lauf pauschal.
+// 'deliveredL' ist schon gelaufen (Resume).
+static void guardArmRun(uint8_t zoneMask, float volumeL, float deliveredL) {
+    float maxL = GUARD_RUN_MAX_L;
+    if (volumeL > 0.0f) {
+        int n = 0;
+        for (int z = 0; z < VALVE_ZONES; z++) if ((zoneMask >> z) & 1) n++;
+        maxL = n * (volumeL * GUARD_VOLUME_MARGIN + FLOW_RUNON_MAX_L);
+    }
+    guardBeginRun(GUARD_MAX_LPM, max(maxL - deliveredL, FLOW_RUNON_MAX_L));
+}
+
+// Nach dem Boot (sobald die Zeit gültig ist): Lauf gemäß IRR_RESUME_POLICY
+// Lauf-Protokoll: Herkunft aus der Slot-Nummer (-1 = Kommando, Hinweis von MQTT/Web)
+static void runlogStartFor(int slot, uint8_t zoneMask, bool resumed) {
+    RunSource src = RunSource::OTHER;
+    uint8_t n = 0;
+    if (slot >= MAX_PROGRAM_SLOTS) {
+        src = RunSource::RULE;
+        n = slot - MAX_PROGRAM_SLOTS + 1;
+    } else if (slot >= 0) {
+        src = RunSource::SCHEDULE;
+        n = slot + 1;
+    }
+    runlogProgramStart(resumed ? RunSource::RESUME : src, n, zoneMask);
+}
+
+static void irrigationResume(time_t now) {
+    resumePending = false;
+    long remaining = (long)(journal.endEpoch - now);
+    String what = "Run slot " + String(journal.slot + 1);
+
+    if (journal.startEpoch == 0 || IRR_RESUME_POLICY == IRR_RESUME_OFF) {
+        logWarn(what + " interrupted by reboot, not resumed (" + String(journalDeliveredLiters(), 1) + " L delivered)");
+        journalClear();
+        return;
+    }
+    if (currentMode != IrrigationMode::AUTO) {
+        logWarn(what + " not resumed (MANUAL mode)");
+        journalClear();
+        return;
+    }
+    if (dailyLimitReached()) {
+        logWarn(what + " not resumed (daily limit)");
+        journalClear();
+        return;
+    }
+    if (IRR_RESUME_POLICY == IRR_RESUME_RESTART) {
+        if (now - journal.startEpoch > IRR_RESUME_MAX_AGE_S) {
+            logWarn(what + " too old, not restarted");
+            journalClear();
+            return;
+        }
+        logWarn(what + " restarted after reboot");
+        irrigationStart(journal.durationSec, journal.slot, journal.zones, journal.volumeL);
+        return;
+    }
+    // IRR_RESUME_REMAINING: Zonen-Ablauf ab der verstrichenen Zeit fortsetzen,
+    // Mengen-Lauf ab der gelieferten Menge (Zonen der Reihe nach gefüllt)
+    uint8_t zones = zonesValid(journal.zones);
+    seqCancel();
+    int queued = 0;
+    if (journal.volumeL > 0.0f) {
+        float left = journalDeliveredLiters();
+        volDoneMask = 0;
+        for (int z = 0; z < VALVE_ZONES; z++) {
+            zoneTargetL[z] = zoneDeliveredL[z] = 0.0f;
+            if (!((zones >> z) & 1)) continue;
+            zoneTargetL[z] = journal.volumeL;
+            zoneDeliveredL[z] = min(left, journal.volumeL);
+            left -= zoneDeliveredL[z];
+            if (zoneDeliveredL[z] < journal.volumeL && seqEnqueue(z, journal.durationSec)) queued++;
+        }
+        volLastPulses = flowGetTotalPulses();
+    } else if (remaining > 0) {
+        queued = seqEnqueueProgram(zones, journal.durationSec, now - journal.startEpoch);
+    }
+    if (remaining <= 0 || queued == 0) {
+        logInfo(what + " finished during reboot (" + String(journalDeliveredLiters(), 1) + " L delivered)");
+        journalClear();
+        return;
+    }
+    logWarn(what + " resumed after reboot, " + String(remaining) + " s left");
+    // Nach Stromausfall steht der Impulszähler auf dem letzten Flash-Stand
+    uint32_t pulses = flowGetTotalPulses();
+    if (pulses < journal.startPulses + journal.deliveredPulses && pulses >= journal.deliveredPulses) {
+        journal.startPulses = pulses - journal.deliveredPulses;
+    }
+    isRunning = true;
+    guardArmRun(zones, journal.volumeL, journalDeliveredLiters());
+    runlogStartFor(journal.slot, zones, true);
+    journalSave(true);   // Journal (Start, Ende, Menge) bleibt, nur neu bestätigt
+}
 
 void irrigationInit() {
     prefs.begin("irr-slots", true); 
-    size_t len = prefs.getBytes("data", slots, sizeof(slots));
+    size_t len = prefs.getBytesLength("data");
+    if (len == sizeof(IrrigationSlotV1) * MAX_PROGRAM_SLOTS) {
+        IrrigationSlotV1 old[MAX_PROGRAM_SLOTS];
+        prefs.getBytes("data", old, sizeof(old));
+        for (int i = 0; i < MAX_PROGRAM_SLOTS; i++) {
+            slots[i] = { old[i].enabled, old[i].startHour, old[i].startMinute, old[i].durationSec,
+                         old[i].weekDays, zonesValid(old[i].zones), 0 };
+        }
+        len = sizeof(slots);
+        logInfo("Slots migrated (volume field added)");
+    } else {
+        len = prefs.getBytes("data", slots, sizeof(slots));
+    }
     prefs.end();
 
     if (len != sizeof(slots)) {
@@ -28,82 +495,211 @@ void irrigationInit() {
             slots[i].startMinute = 0;
             slots[i].durationSec = 600;
             slots[i].weekDays = 127; 
+            slots[i].zones = 1;
+            slots[i].volumeDl = 0;
         }
     } else {
+        for (int i = 0; i < MAX_PROGRAM_SLOTS; i++) slots[i].zones = zonesValid(slots[i].zones);
         logInfo("Loaded " + String(MAX_PROGRAM_SLOTS) + " slots.");
     }
+
+    loadLastDue();
+    journalLoad();
 }
 
 void irrigationLoop() {
     // 1. ANOMALIE CHECK
     if (!isRunning && valveGetState() == ValveState::CLOSED && flowGetLpm() > 0.2f) {
         static unsigned long lastWarn = 0;
-        if (millis() - lastWarn > 30000) {
+        if (clockMillis() - lastWarn > 30000) {
             logWarn("Anomaly: Flow detected while valve CLOSED!");
-            lastWarn = millis();
+            lastWarn = clockMillis();
+        }
+    }
+
+    // 2. Unterbrochener Lauf vom letzten Boot
+    if (resumePending && !isRunning) {
+        time_t t = clockNow();
+        if (t > 1577836800) {
+            irrigationResume(t);
+        } else if (clockMillis() > IRR_RESUME_WAIT_MS) {
+            logWarn("No valid time after boot, interrupted run dropped");
+            resumePending = false;
+            journalClear();
         }
     }
 
-    // 2. Timer Stop
+    // Nachlauf nach Mengen-Stopp: nur gültig, wenn in der Zeit alles zu blieb
+    if (runOnPending) {
+        if (valveOpenCount() > 0) {
+            runOnPending = false;
+        } else if (clockMillis() - runOnStartMs >= FLOW_RUNON_MS) {
+            flowLearnRunOn(flowPulsesToLiters(flowGetTotalPulses() - runOnStartPulses));
+            runOnPending = false;
+        }
+    }
+
+    // 3. Timer Stop
     if (isRunning) {
-        if (millis() - runStartTime >= runDuration * 1000UL) {
+        volumeTrack();
+        if (clockMillis() - lastJournalRtcMs >= JOURNAL_RTC_UPDATE_MS) {
+            journal.deliveredPulses = flowGetTotalPulses() - journal.startPulses;
+            journalSave(false);
+            lastJournalRtcMs = clockMillis();
+        }
+        if (!seqIsBusy()) {
             logInfo("Timer finished. Stopping.");
             irrigationStop();
         }
-        return; 
-    }
-
-    // 3. Automatik
-    if (currentMode == IrrigationMode::AUTO) {
-        time_t now;
-        time(&now);
-        
-        if (now > 1577836800) {
-            struct tm ti;
-            localtime_r(&now, &ti); 
-
-            for (int i = 0; i < MAX_PROGRAM_SLOTS; i++) {
-                if (slots[i].enabled) {
-                    // Check Day
-                    if ((slots[i].weekDays >> ti.tm_wday) & 1) {
-                        // Check Time
-                        if (ti.tm_hour == slots[i].startHour && ti.tm_min == slots[i].startMinute) {
-                            if (ti.tm_sec < 5) {
-                                logInfo("Slot " + String(i+1) + " Triggered! (Day " + String(ti.tm_wday) + ")");
-                                irrigationStart(slots[i].durationSec);
-                                delay(1000); 
-                                return; 
-                            }
-                        }
-                    }
-                }
-            }
+    }
+
+    // 4. Warteschlange: verfallene Läufe, nächsten starten
+    queueLoop();
+
+    // 5. Automatik: nur die Heap-Spitze prüfen
+    time_t now = clockNow();
+    if (now <= 1577836800) return;   // noch keine gültige Zeit
+    if (resumePending) return;
+
+    // Erste gültige Zeit: Slots, die ohne Zeit verpasst wurden, mit einplanen
+    // (bereits gelaufene Termine schließt scheduleGetLastDue() aus)
+    if (timeValidSince == 0) {
+        timeValidSince = now;
+        scheduleRebuild(slots, MAX_PROGRAM_SLOTS, now - (time_t)IRR_BOOT_CATCHUP_S);
+        scheduleDirty = false;
+    }
+
+    // Neuaufbau bei Slot-Änderung oder Uhr rückwärts (NTP-Korrektur)
+    if (scheduleDirty || now + IRR_CLOCK_BACK_S < lastScheduleCheck) {
+        if (!scheduleDirty) logWarn("Clock jumped back, schedule rebuilt");
+        scheduleRebuild(slots, MAX_PROGRAM_SLOTS, now);
+        scheduleDirty = false;
+    }
+    lastScheduleCheck = now;
+
+    while (!scheduleEmpty() && schedulePeek().due <= now) {
+        ScheduleEntry e = schedulePop();
+        const IrrigationSlot &slot = slots[e.slot];
+        long lateSec = (long)(now - e.due);
+        long allowedSec = IRR_CATCHUP_WINDOW_S;
+        if (e.due < timeValidSince) {
+            // verpasst, solange die Zeit ungültig war (Boot, spätes NTP)
+            lateSec = (long)(timeValidSince - e.due);
+            allowedSec = IRR_BOOT_CATCHUP_S;
         }
-    } else {
-        // MANUAL MODE WARNUNG (nur zur vollen Minute, zum Debuggen)
-        static int lastLogMin = -1;
-        time_t now; time(&now);
-        struct tm ti; localtime_r(&now, &ti);
-        if (ti.tm_min != lastLogMin && ti.tm_sec < 5) {
-             // Wenn wir im Manual Mode sind und ein Slot eigentlich laufen würde, loggen wir das.
-             // Das hilft bei "Warum geht es nicht?"
-             lastLogMin = ti.tm_min;
+        saveLastDue();
+
+        // Folgetermin: höchstens eine Nachholung pro Slot, auch nach großem Zeitsprung
+        time_t from = max(e.due, now - (time_t)IRR_CATCHUP_WINDOW_S);
+        time_t next = scheduleNextOccurrence(slot, from);
+        if (next != 0) schedulePush({ next, e.slot });
+
+        if (currentMode != IrrigationMode::AUTO) {
+            logInfo("Slot " + String(e.slot + 1) + " skipped (MANUAL mode)");
+            continue;
+        }
+        if (lateSec > allowedSec) {
+            logWarn("Slot " + String(e.slot + 1) + " missed (" + String(lateSec) + " s late)");
+            continue;
         }
+        logInfo("Slot " + String(e.slot + 1) + " Triggered!" + (lateSec > 5 ? " (catch-up, " + String(lateSec) + " s late)" : String("")));
+        irrigationRequest(slot.durationSec, e.slot, slot.zones, slot.volumeDl / 10.0f, IRR_PRIO_SCHEDULE);
+    }
+
+    // 6. Cron-Regeln (zusätzlich zu den Slots)
+    if (rulesGetCount() > 0) rulesCheck(now);
+}
+
+void irrigationRequest(int durationSec, int slot, uint8_t zoneMask, float volumeL, uint8_t priority) {
+    if (!isRunning && !resumePending && runQueueLen == 0) {
+        irrigationStart(durationSec, slot, zoneMask, volumeL);
+        return;
     }
+    time_t now = clockNow();
+    QueuedRun r;
+    r.slot = slot;
+    r.zones = zonesValid(zoneMask);
+    r.priority = priority;
+    r.durationSec = constrain(durationSec, 0, 3600);
+    r.volumeDl = constrain(lroundf(volumeL * 10.0f), 0L, 60000L);
+    r.due = (now > 1577836800) ? now : 0;
+    r.queuedMs = clockMillis();
+
+    if (IRR_MERGE_POLICY == IRR_MERGE_SKIP) {
+        queueEvent("run_skipped", r);
+        return;
+    }
+    if (IRR_MERGE_POLICY == IRR_MERGE_EXTEND && queueTryExtend(r)) return;
+    queueInsert(r);
 }
 
-void irrigationStart(int durationSec) {
-    if (durationSec > 3600) durationSec = 3600; 
-    valveSet(ValveState::OPEN);
+void irrigationStart(int durationSec, int slot, uint8_t zoneMask, float volumeL) {
+    if (dailyLimitReached()) {
+        logWarn("Run " + runName(slot) + " refused (daily limit)");
+        return;
+    }
+    if (volumeL > 0.0f) {
+        if (durationSec <= 0 || durationSec > IRR_VOLUME_MAX_S) durationSec = IRR_VOLUME_MAX_S;
+    } else if (durationSec > 3600) {
+        durationSec = 3600; 
+    }
+    if (volumeL < 0.0f) volumeL = 0.0f;
+    zoneMask = zonesValid(zoneMask);
+
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        zoneTargetL[z] = ((zoneMask >> z) & 1) ? volumeL : 0.0f;
+        zoneDeliveredL[z] = 0.0f;
+    }
+    volDoneMask = volOpenMask = 0;
+    volLastPulses = flowGetTotalPulses();
+
+    seqCancel();
+    guardArmRun(zoneMask, volumeL, 0.0f);
+    sigRunStart(slot);
+    runlogStartFor(slot, zoneMask, false);
+    seqEnqueueProgram(zoneMask, durationSec, 0);
     isRunning = true;
-    runDuration = durationSec;
-    runStartTime = millis();
+
+    time_t now = clockNow();
+    bool timeOk = now > 1577836800;
+    journal.magic = JOURNAL_MAGIC;
+    journal.slot = slot;
+    journal.zones = zoneMask;
+    journal.durationSec = durationSec;
+    journal.volumeL = volumeL;
+    journal.startEpoch = timeOk ? now : 0;
+    journal.endEpoch = timeOk ? now + seqGetRemainingSec(clockMillis()) : 0;
+    journal.startPulses = flowGetTotalPulses();
+    journal.deliveredPulses = 0;
+    journalSave(true);
+    lastJournalRtcMs = clockMillis();
 }
 
 void irrigationStop() {
+    float target, delivered;
+    if (irrigationGetVolume(target, delivered)) {
+        logInfo("Volume run done: " + String(delivered, 1) + " of " + String(target, 1) + " L");
+    }
+    seqCancel();
     valveSet(ValveState::CLOSED);
+    guardEndRun();
+    sigRunEnd(true);
+    runlogProgramEnd(RunStop::DONE);
     isRunning = false;
     currentMode = IrrigationMode::AUTO; // Timer fertig -> Zurück zu Auto!
+    journalClear();
+}
+
+void irrigationCancelRun(const char* reason) {
+    if (!isRunning && !resumePending) return;
+    logInfo(String("Run cancelled: ") + reason);
+    seqCancel();
+    guardEndRun();
+    sigRunEnd(false);
+    runlogProgramEnd(RunStop::CLOSED);
+    isRunning = false;
+    resumePending = false;
+    journalClear();
 }
 
 void irrigationSetMode(IrrigationMode mode) {
@@ -118,11 +714,35 @@ bool irrigationIsRunning() {
     return isRunning;
 }
 
+time_t irrigationGetNextRun(int &slot) {
+    if (scheduleDirty || scheduleEmpty()) {
+        slot = -1;
+        return 0;
+    }
+    slot = schedulePeek().slot;
+    return schedulePeek().due;
+}
+
+bool irrigationGetVolume(float &targetL, float &deliveredL) {
+    targetL = deliveredL = 0.0f;
+    if (!isRunning) return false;
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        targetL += zoneTargetL[z];
+        deliveredL += zoneDeliveredL[z];
+    }
+    return targetL > 0.0f;
+}
+
+int irrigationGetQueue(QueuedRun* out) {
+    memcpy(out, runQueue, runQueueLen * sizeof(QueuedRun));
+    return runQueueLen;
+}
+
+uint32_t irrigationGetQueueVersion() { return runQueueVersion; }
+
 int irrigationGetRemainingSec() {
     if (!isRunning) return 0;
-    unsigned long elapsed = (millis() - runStartTime) / 1000;
-    if (elapsed >= runDuration) return 0;
-    return runDuration - elapsed;
+    return seqGetRemainingSec(clockMillis());
 }
 
 void irrigationGetSlots(IrrigationSlot* targetArray) {
@@ -131,7 +751,12 @@ void irrigationGetSlots(IrrigationSlot* targetArray) {
 
 void irrigationUpdateSlot(int index, IrrigationSlot slot) {
     if (index >= 0 && index < MAX_PROGRAM_SLOTS) {
+        const IrrigationSlot &old = slots[index];
+        if (old.zones != slot.zones || old.durationSec != slot.durationSec || old.volumeDl != slot.volumeDl) {
+            sigResetSlot(index);    // anderer Lauf, alte Signatur passt nicht mehr
+        }
         slots[index] = slot;
+        scheduleDirty = true;
     }
 }
 
@@ -11,6 +11,19 @@ struct IrrigationSlot {
     uint8_t startMinute;    // 0-59
     uint16_t durationSec;   // Dauer in Sekunden
     uint8_t weekDays;       // Bitmaske: Bit 0=So, 1=Mo, ..., 6=Sa (127 = Alle Tage)
+    uint8_t zones;          // Bitmaske Zonen: Bit 0 = Zone 1 (beim Laden auf VALVE_ZONES maskiert, leer = Zone 1)
+    uint16_t volumeDl;      // Zielmenge je Zone in 0.1 L, 0 = nach Zeit (Dauer = Obergrenze)
+};
+
+// Wartender Lauf (fällig, während ein anderer lief)
+struct QueuedRun {
+    int8_t   slot;          // -1 = manuell, >= MAX_PROGRAM_SLOTS = Regel
+    uint8_t  zones;
+    uint8_t  priority;      // höher = früher
+    uint16_t durationSec;
+    uint16_t volumeDl;      // 0.1 L, 0 = nach Zeit
+    time_t   due;           // 0 = ohne gültige Zeit angefordert
+    uint32_t queuedMs;
 };
 
 enum class IrrigationMode {
@@ -22,14 +35,26 @@ void irrigationInit();
 void irrigationLoop();
 
 // Steuerung
-void irrigationStart(int durationSec); 
+// Zonen laufen über den Sequencer nacheinander, je durationSec (0 = Zone 1).
+// volumeL > 0: jede Zone schließt bei dieser Menge, durationSec ist dann nur
+// Obergrenze (0 = IRR_VOLUME_MAX_S).
+void irrigationStart(int durationSec, int slot = -1, uint8_t zoneMask = 0, float volumeL = 0.0f);
+// Lauf anfordern: startet sofort, sonst gemäß IRR_MERGE_POLICY
+// Warteschlange, Verlängerung oder Verwerfen. Die Warteschlange läuft nur
+// im AUTO-Modus ab.
+void irrigationRequest(int durationSec, int slot, uint8_t zoneMask, float volumeL, uint8_t priority);
 void irrigationStop();
+void irrigationCancelRun(const char* reason);   // manuell zu / OTA: Lauf + Journal verwerfen
 void irrigationSetMode(IrrigationMode mode);
 
 // Info
 IrrigationMode irrigationGetMode();
 bool irrigationIsRunning();
 int irrigationGetRemainingSec();
+time_t irrigationGetNextRun(int &slot);   // 0 = kein Termin geplant
+bool irrigationGetVolume(float &targetL, float &deliveredL);   // false = kein Mengen-Lauf
+int irrigationGetQueue(QueuedRun* out);   // out: IRR_RUN_QUEUE_LEN Einträge, Rückgabe Anzahl
+uint32_t irrigationGetQueueVersion();     // steigt bei jeder Änderung
 
 // === SLOT MANAGEMENT (NEU) ===
 // Gibt das gesamte Array zurück (für Web-Anzeige)
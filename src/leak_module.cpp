@@ -0,0 +1,182 @@
+#include "leak_module.h"
+#include "config.h"
+#include "clock_module.h"
+#include "hal.h"
+#include "logger.h"
+#include "flow_module.h"
+#include "valve_module.h"
+#include "settings_module.h"
+#include "metrics_module.h"
+#include "mqtt_module.h"
+
+static const uint32_t LEAK_MAGIC = 0x4C4B3031;   // "LK01"
+static const int BUCKETS = 12;
+static const uint32_t BUCKET0_MS = 250;          // Stufe 0: < 250 ms, dann je x2
+static const uint32_t HOUR_MS = 3600000UL;
+
+struct LeakHour {
+    uint16_t hist[BUCKETS];     // Impuls-Abstände
+    uint16_t pulses;
+    uint16_t closedMin;         // Minuten "zu und ruhig"
+};
+
+struct LeakState {
+    uint32_t magic;
+    uint16_t size;              // sizeof(LeakState), ändert sich mit LEAK_WINDOW_H
+    uint8_t  count;             // abgeschlossene Stunden, älteste zuerst
+    bool     alarm;
+    uint32_t curAgeMs;          // Laufzeit der aktuellen Stunde
+    uint32_t curClosedMs;
+    LeakHour cur;
+    LeakHour hours[LEAK_WINDOW_H];
+};
+static_assert(sizeof(LeakState) <= 512, "leak state should stay a few hundred bytes");
+
+RTC_DATA_ATTR static LeakState st;
+static LeakStatus status;
+static unsigned long lastMs = 0;
+static unsigned long lastActiveMs = 0;  // zuletzt offen/schaltend
+static uint32_t lastPulses = 0;
+static unsigned long prevPulseUs = 0;
+static bool havePrev = false;
+
+static int bucketOf(uint32_t intervalMs) {
+    int b = 0;
+    for (uint32_t lim = BUCKET0_MS; b < BUCKETS - 1 && intervalMs >= lim; lim <<= 1) b++;
+    return b;
+}
+
+static void sat16Add(uint16_t &v, uint32_t n) {
+    v = (v + n > 0xFFFF) ? 0xFFFF : v + n;
+}
+
+// Alle Ventile zu, keine Zone im Übergang, Nachlauf vorbei
+static bool leakSettled(unsigned long now) {
+    bool quiet = valveOpenCount() == 0;
+    for (int z = 0; quiet && z < VALVE_ZONES; z++) {
+        ValvePhase p = valveZoneGetPhase(z);
+        if (p == ValvePhase::OPENING || p == ValvePhase::CLOSING) quiet = false;
+    }
+    if (!quiet) lastActiveMs = now;
+    return quiet && now - lastActiveMs >= LEAK_SETTLE_MS;
+}
+
+static float pulsesPerLiter() {
+    float k = settingsGetFlowFactor();
+    return k <= 0.1f ? 450.0f : k;
+}
+
+static void leakEvaluate() {
+    LeakStatus s = {};
+    int sens = settingsGetLeakSensitivity();
+    float wetPulsesH = max(LEAK_BASE_LPH / max(sens, 1) * pulsesPerLiter(), (float)LEAK_MIN_PULSES_H);
+
+    uint32_t hist[BUCKETS] = {};
+    float wetRates[LEAK_WINDOW_H];
+    int n = 0;
+    for (int i = 0; i < st.count; i++) {
+        const LeakHour &h = st.hours[i];
+        if (h.closedMin < LEAK_MIN_OBS_MIN) continue;
+        s.hours++;
+        float perHour = h.pulses * 60.0f / h.closedMin;
+        if (perHour < wetPulsesH) continue;
+        s.wetHours++;
+        for (int b = 0; b < BUCKETS; b++) hist[b] += h.hist[b];
+        // sortiert einfügen (Median)
+        int j = n++;
+        while (j > 0 && wetRates[j - 1] > perHour) { wetRates[j] = wetRates[j - 1]; j--; }
+        wetRates[j] = perHour;
+    }
+
+    // Regelmäßigkeit: größter Anteil in drei benachbarten Stufen
+    uint32_t total = 0, best = 0;
+    for (int b = 0; b < BUCKETS; b++) total += hist[b];
+    for (int b = 0; b < BUCKETS; b++) {
+        uint32_t w = hist[b] + (b > 0 ? hist[b - 1] : 0) + (b < BUCKETS - 1 ? hist[b + 1] : 0);
+        if (w > best) best = w;
+    }
+    s.regularityPct = total ? best * 100 / total : 0;
+    if (n > 0) s.baseLpm = wetRates[n / 2] / pulsesPerLiter() / 60.0f;
+
+    if (sens > 0 && s.hours >= LEAK_MIN_HOURS) {
+        float persistence = (float)s.wetHours / s.hours;
+        s.score = lroundf(100.0f * persistence * (0.5f + 0.5f * s.regularityPct / 100.0f));
+    }
+
+    bool was = st.alarm;
+    if (s.score >= LEAK_ALARM_PCT) st.alarm = true;
+    else if (s.score < LEAK_ALARM_PCT / 2) st.alarm = false;
+    s.alarm = st.alarm;
+    status = s;
+    metricSet(MG_LEAK_SCORE, s.score);
+
+    if (st.alarm == was) return;
+    String extra = "\"score\":" + String(s.score);
+    extra += ",\"base_lpm\":" + String(s.baseLpm, 3);
+    extra += ",\"hours\":" + String(s.hours);
+    extra += ",\"wet_hours\":" + String(s.wetHours);
+    extra += ",\"regularity\":" + String(s.regularityPct);
+    if (st.alarm) {
+        logWarn("Leak suspected: score " + String(s.score) + ", ~" + String(s.baseLpm, 3) + " L/min while closed");
+        mqttPublishEvent("leak_suspected", extra);
+    } else {
+        logInfo("Leak suspicion cleared (score " + String(s.score) + ")");
+        mqttPublishEvent("leak_cleared", extra);
+    }
+}
+
+static void leakRollHour() {
+    st.cur.closedMin = st.curClosedMs / 60000UL;
+    // chronologisch halten: ist alles voll, fällt die älteste Stunde heraus
+    if (st.count < LEAK_WINDOW_H) {
+        st.hours[st.count++] = st.cur;
+    } else {
+        memmove(&st.hours[0], &st.hours[1], sizeof(LeakHour) * (LEAK_WINDOW_H - 1));
+        st.hours[LEAK_WINDOW_H - 1] = st.cur;
+    }
+    memset(&st.cur, 0, sizeof(st.cur));
+    st.curAgeMs = st.curClosedMs = 0;
+    leakEvaluate();
+}
+
+void leakInit() {
+    if (st.magic != LEAK_MAGIC || st.size != sizeof(LeakState) || st.count > LEAK_WINDOW_H) {
+        memset(&st, 0, sizeof(st));
+        st.magic = LEAK_MAGIC;
+        st.size = sizeof(LeakState);
+    } else {
+        logInfo("Leak histogram restored: " + String(st.count) + " h");
+    }
+    lastMs = lastActiveMs = clockMillis();
+    lastPulses = flowGetIsrPulses();
+    havePrev = false;
+    leakEvaluate();
+}
+
+void leakLoop() {
+    unsigned long now = clockMillis();
+    uint32_t dt = now - lastMs;
+    lastMs = now;
+    uint32_t p = flowGetIsrPulses();
+    uint32_t d = p - lastPulses;
+    lastPulses = p;
+
+    st.curAgeMs += dt;
+    if (settingsGetLeakSensitivity() > 0 && leakSettled(now)) {
+        st.curClosedMs += dt;
+        unsigned long lastUs;
+        if (d > 0 && flowGetLastPulseUs(lastUs)) {
+            // mehrere Impulse seit dem letzten Durchlauf: mittlerer Abstand
+            if (havePrev) sat16Add(st.cur.hist[bucketOf((lastUs - prevPulseUs) / 1000UL / d)], d);
+            sat16Add(st.cur.pulses, d);
+            prevPulseUs = lastUs;
+            havePrev = true;
+        }
+    } else {
+        havePrev = false;
+    }
+
+    if (st.curAgeMs >= HOUR_MS) leakRollHour();
+}
+
+void leakGetStatus(LeakStatus &out) { out = status; }
@@ -0,0 +1,27 @@
+#pragma once
+#include <Arduino.h>
+
+// Schleichende Lecks (tropfende Verschraubung, < 0,1 L/min) erkennen, die
+// unter der Anomalie-Schwelle von flowGetLpm() bleiben.
+//
+// Solange alle Ventile zu und beruhigt sind (LEAK_SETTLE_MS nach dem letzten
+// Schalten), kommen die Abstände zwischen zwei Impulsen in ein log2-Histogramm
+// (ab 250 ms, 12 Stufen). Jede Stunde wird abgeschlossen und in einen Ring von
+// LEAK_WINDOW_H Stunden geschoben. Score 0..100:
+//   Anteil "nasser" Stunden (Impulse >= Schwelle aus "leak_sens") an den
+//   beobachteten Stunden, gewichtet mit der Regelmäßigkeit der Abstände
+//   (Tropfen kommen gleichmäßig, Störimpulse verstreut).
+// Fester Speicher (< 400 Byte im RTC-RAM: übersteht Auto-Reboot), kein Flash.
+
+struct LeakStatus {
+    uint8_t score;          // 0..100, 0 = zu wenig beobachtet
+    uint8_t hours;          // beobachtete Stunden im Ring
+    uint8_t wetHours;       // davon mit Durchfluss über der Schwelle
+    uint8_t regularityPct;  // Anteil der Abstände um den häufigsten Wert
+    float   baseLpm;        // geschätzter Dauerdurchfluss (Median nasser Stunden)
+    bool    alarm;          // Score >= LEAK_ALARM_PCT (Event "leak_suspected")
+};
+
+void leakInit();
+void leakLoop();
+void leakGetStatus(LeakStatus &out);
@@ -1,5 +1,7 @@
 #include "logger.h"
 #include "config.h"
+#include "clock_module.h"
+#include "hal.h"
 #include <deque> // Für die Listen
 #include <time.h>
 
@@ -14,35 +16,56 @@ const size_t MAX_LOG_EVENTS = 20;
 static std::deque<String> flowLog; 
 const size_t MAX_FLOW_EVENTS = 50;   
 
+// Logs werden aus Haupt-Loop und Web-Task benutzt -> Listen per Mutex schützen
+static SemaphoreHandle_t logMutex = nullptr;
+
+struct LogLock {
+    LogLock()  { if (logMutex) xSemaphoreTake(logMutex, portMAX_DELAY); }
+    ~LogLock() { if (logMutex) xSemaphoreGive(logMutex); }
+};
+
 // Hilfsfunktion: Zeitstempel (HH:MM:SS)
 String getLogTimeStr() {
-    time_t now;
-    time(&now);
+    time_t now = clockNow();
     // Wenn NTP noch nicht da (Zeit < 2020)
     if (now < 1577836800) {
-        return "[" + String(millis()/1000) + "s]";
+        return "[" + String(clockMillis()/1000) + "s]";
     }
     struct tm timeinfo;
-    localtime_r(&now, &timeinfo);
+    clockLocal(now, timeinfo);
     char buf[16];
     sprintf(buf, "%02d:%02d:%02d", timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
     return String(buf);
 }
 
+// Hilfsfunktion: Liste als JSON-Array (Rendering macht die Web-UI)
+static String logListToJson(const std::deque<String> &list) {
+    String json = "[";
+    for (const auto& line : list) {
+        if (json.length() > 1) json += ",";
+        json += "\"";
+        for (unsigned int i = 0; i < line.length(); i++) {
+            char c = line[i];
+            if (c == '"' || c == '\\') json += '\\';
+            if ((uint8_t)c >= 0x20) json += c;
+        }
+        json += "\"";
+    }
+    json += "]";
+    return json;
+}
+
 // === SYSTEM LOG LOGIK ===
 void logEvent(String type, String msg) {
-    String entry = getLogTimeStr() + " <b>[" + type + "]</b> " + msg;
+    String entry = getLogTimeStr() + " [" + type + "] " + msg;
+    LogLock lock;
     eventLog.push_front(entry); 
     if (eventLog.size() > MAX_LOG_EVENTS) eventLog.pop_back(); 
 }
 
-String logGetEventsHtml() {
-    String html = "";
-    if (eventLog.empty()) return "<tr><td>No events yet</td></tr>";
-    for (const auto& line : eventLog) {
-        html += "<tr><td style='font-size:14px; padding:4px; border-bottom:1px solid #eee;'>" + line + "</td></tr>";
-    }
-    return html;
+String logGetEventsJson() {
+    LogLock lock;
+    return logListToJson(eventLog);
 }
 
 // === NEU: FLOW LOG LOGIK (Größe 50) ===
@@ -50,27 +73,27 @@ void logFlowEvent(String msg) {
     // Einfaches Format: "HH:MM:SS Nachricht"
     String entry = getLogTimeStr() + " " + msg;
     
-    flowLog.push_front(entry);
-    if (flowLog.size() > MAX_FLOW_EVENTS) {
-        flowLog.pop_back();
+    {
+        LogLock lock;
+        flowLog.push_front(entry);
+        if (flowLog.size() > MAX_FLOW_EVENTS) {
+            flowLog.pop_back();
+        }
     }
     // Optional auch auf Serial ausgeben
     Serial.println("[FLOW-LOG] " + msg);
 }
 
-String logGetFlowEventsHtml() {
-    String html = "";
-    if (flowLog.empty()) return "<tr><td>No flow events yet</td></tr>";
-    for (const auto& line : flowLog) {
-        html += "<tr><td style='font-size:13px; padding:2px; border-bottom:1px solid #f0f0f0; color:#0055aa;'>" + line + "</td></tr>";
-    }
-    return html;
+String logGetFlowEventsJson() {
+    LogLock lock;
+    return logListToJson(flowLog);
 }
 
 // === STANDARD LOGGER ===
 void logInit() {
+    logMutex = xSemaphoreCreateMutex();
     Serial.begin(115200);
-    delay(1000);
+    halDelay(1000);
     Serial.println();
     Serial.println("=== Logger started ===");
     logEvent("SYSTEM", "Bootup " FW_VERSION);
@@ -95,12 +118,15 @@ void logDiag(const String &msg) {
 }
 
 void logSetLastDiag(String s) {
-    if (lastDiagMessage != s) {
+    {
+        LogLock lock;
+        if (lastDiagMessage == s) return;
         lastDiagMessage = s;
-        logEvent("STATUS", s);
     }
+    logEvent("STATUS", s);
 }
 
 String logGetLastDiag() {
+    LogLock lock;
     return lastDiagMessage;
 }
\ No newline at end of file
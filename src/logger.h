@@ -17,9 +17,9 @@ String logGetLastDiag();
 // === Event Log (System/Error) - Ringpuffer 20 ===
 // Für Fehler, WLAN-Probleme, Reboots
 void logEvent(String type, String msg); 
-String logGetEventsHtml();              
+String logGetEventsJson();              // JSON-Array (neueste zuerst)
 
 // === NEU: Valve & Flow Log - Ringpuffer 50 ===
 // Speziell für: "Ventil Auf", "Ventil Zu (X Liter)"
 void logFlowEvent(String msg);
-String logGetFlowEventsHtml();
\ No newline at end of file
+String logGetFlowEventsJson();
\ No newline at end of file
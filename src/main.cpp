@@ -5,6 +5,8 @@
 
 #include <Arduino.h>
 #include "config.h"
+#include "clock_module.h"
+#include "hal.h"
 #include "logger.h"
 #include "wifi_module.h"
 #include "mqtt_module.h"
@@ -15,7 +17,17 @@
 #include "time_module.h"
 #include "watchdog_module.h"
 #include "irrigation_module.h"
+#include "rules_module.h"
+#include "sequencer_module.h"
 #include "settings_module.h" 
+#include "snapshot_module.h"
+#include "ota_module.h"
+#include "guard_module.h"
+#include "leak_module.h"
+#include "signature_module.h"
+#include "runlog_module.h"
+#include "stats_module.h"
+#include "history_module.h"
 #include <time.h> 
 
 static unsigned long lastStatePublishMs = 0;
@@ -25,42 +37,82 @@ bool warningLeak = false;
 bool limitWarningSent = false;
 
 // === JSON BUILDER (TELEMETRIE) ===
-String buildTeleJson() {
-    time_t rawTime;
-    time(&rawTime);
+// Beide Builder lesen nur den Snapshot -> Werte innerhalb einer Meldung passen zusammen
+String buildTeleJson(const DeviceSnapshot &s) {
     String json = "{";
-    json += "\"ts\":" + String((unsigned long)rawTime) + ","; 
+    json += "\"ts\":" + String((unsigned long)s.epoch) + ","; 
     json += "\"fw\":\"" + String(FW_VERSION) + "\",";
-    json += "\"valve\":\"" + String(valveGetState() == ValveState::OPEN ? "OPEN" : "CLOSED") + "\",";
-    json += "\"flow_lpm\":" + String(flowGetLpm(), 2) + ",";
-    json += "\"flow_total_l\":" + String(flowGetTotalLiters(), 2) + ",";
-    json += "\"pulses\":" + String(flowGetTotalPulses()) + ",";
-    json += "\"battery_v\":" + String(batteryGetVoltage(), 2) + ",";
-    json += "\"irr_mode\":\"" + String(irrigationGetMode() == IrrigationMode::AUTO ? "AUTO" : "MANUAL") + "\",";
-    json += "\"irr_running\":" + String(irrigationIsRunning() ? "true" : "false") + ",";
-    json += "\"daily_open_s\":" + String(valveGetDailyOpenSec());
+    json += "\"valve\":\"" + String(s.valve == ValveState::OPEN ? "OPEN" : "CLOSED") + "\",";
+    json += "\"flow_lpm\":" + String(s.flowLpm, 2) + ",";
+    json += "\"flow_total_l\":" + String(s.flowTotalL, 2) + ",";
+    json += "\"pulses\":" + String(s.pulses) + ",";
+    json += "\"battery_v\":" + String(s.batV, 2) + ",";
+    json += "\"irr_mode\":\"" + String(s.mode == IrrigationMode::AUTO ? "AUTO" : "MANUAL") + "\",";
+    json += "\"irr_running\":" + String(s.irrRunning ? "true" : "false") + ",";
+    json += "\"daily_open_s\":" + String(s.dailyOpenSec) + ",";
+    json += "\"alarm\":\"" + String(guardReasonName(s.guardReason)) + "\",";
+    json += "\"leak_pct\":" + String(s.leak.score);
     json += "}";
     return json;
 }
 
-// === JSON BUILDER (HISTORY) ===
-String buildHistoryJson(time_t timestamp) {
-    String json = "{";
-    json += "\"ts\":" + String((unsigned long)timestamp) + ","; 
-    json += "\"flow_l_min\":" + String(flowGetLpm(), 2) + ",";
-    json += "\"total_l\":" + String(flowGetTotalLiters(), 2) + ",";
-    json += "\"vbat\":" + String(batteryGetVoltage(), 2) + ",";
-    json += "\"valve\":\"" + String(valveGetState() == ValveState::OPEN ? "OPEN" : "CLOSED") + "\"";
-    json += "}";
-    return json;
+// "key":"wert" aus einem flachen JSON-Kommando (ohne Escapes)
+static String cmdGetString(const String &json, const char* key) {
+    String k = "\"" + String(key) + "\"";
+    int i = json.indexOf(k);
+    if (i < 0) return "";
+    int start = json.indexOf('"', json.indexOf(':', i + k.length()) + 1);
+    if (start < 0) return "";
+    int end = json.indexOf('"', start + 1);
+    if (end < 0) return "";
+    return json.substring(start + 1, end);
+}
+
+// "key":12.5 aus einem flachen JSON-Kommando, -1 = fehlt
+static float cmdGetNumber(const String &json, const char* key) {
+    String k = "\"" + String(key) + "\"";
+    int i = json.indexOf(k);
+    if (i < 0) return -1;
+    int colon = json.indexOf(':', i + k.length());
+    if (colon < 0) return -1;
+    return json.substring(colon + 1).toFloat();
 }
 
 void onMqttCommand(const String &cmdJson) {
     logInfo("CMD: " + cmdJson);
-    if (cmdJson.indexOf("OPEN") >= 0) {
+    // Zuerst: die URL könnte "OPEN"/"CLOSE" enthalten
+    // {"cmd":"ota","url":"http://192.168.1.10:8000/firmware.bin","sha256":"..."}
+    if (cmdGetString(cmdJson, "cmd") == "ota") {
+        otaPullStart(cmdGetString(cmdJson, "url"), cmdGetString(cmdJson, "sha256"));
+    } else if (cmdGetString(cmdJson, "cmd") == "run" || cmdGetString(cmdJson, "cmd") == "zones") {
+        // {"cmd":"run","zones":5,"dur":300} -> Zone 1 und 3 nacheinander je 300 s
+        // {"cmd":"run","vol":20}            -> Zone 1 bis 20 L (Obergrenze IRR_VOLUME_MAX_S oder "dur")
+        long zones = lroundf(cmdGetNumber(cmdJson, "zones"));
+        long dur = lroundf(cmdGetNumber(cmdJson, "dur"));
+        float vol = cmdGetNumber(cmdJson, "vol");
+        if (zones < 0) zones = 1;
+        if (zones == 0 || (zones >> VALVE_ZONES) || (dur <= 0 && vol <= 0.0f)) {
+            logWarn("Run rejected: bad zones/dur/vol");
+        } else {
+            // läuft schon etwas: Warteschlange mit IRR_PRIO_MANUAL
+            runlogNoteSource(RunSource::MQTT);
+            irrigationRequest(dur > 0 ? dur : 0, -1, zones, vol > 0.0f ? vol : 0.0f, IRR_PRIO_MANUAL);
+        }
+    } else if (cmdGetString(cmdJson, "cmd") == "alarm_reset") {
+        guardReset();
+    } else if (cmdGetString(cmdJson, "cmd") == "runs") {
+        // {"cmd":"runs","req":"a1","since":1780272000,"after":120,"limit":20} -> Antwort auf /runs
+        float since = cmdGetNumber(cmdJson, "since");
+        float after = cmdGetNumber(cmdJson, "after");
+        runlogPublish(cmdGetString(cmdJson, "req"), since > 0 ? (uint32_t)since : 0,
+                      after > 0 ? (uint32_t)after : 0, lroundf(cmdGetNumber(cmdJson, "limit")));
+    } else if (cmdJson.indexOf("OPEN") >= 0) {
+        runlogNoteSource(RunSource::MQTT);
         irrigationSetMode(IrrigationMode::MANUAL);
         valveSet(ValveState::OPEN);
     } else if (cmdJson.indexOf("CLOSE") >= 0) {
+        runlogNoteStop(RunStop::MQTT);
+        irrigationCancelRun("valve closed via MQTT");
         irrigationSetMode(IrrigationMode::MANUAL);
         valveSet(ValveState::CLOSED);
     } else if (cmdJson.indexOf("MODE_AUTO") >= 0) {
@@ -75,23 +127,33 @@ void setup() {
     settingsInit(); 
     logInfo("Boot " + String(DEVICE_NAME) + " FW " + FW_VERSION);
 
-    pinMode(PIN_STATUS_LED, OUTPUT);
-    digitalWrite(PIN_STATUS_LED, LOW);
+    halPinMode(PIN_STATUS_LED, OUTPUT);
+    halDigitalWrite(PIN_STATUS_LED, LOW);
 
     valveInit();
+    seqInit();
     flowInit();
     batteryInit();
     irrigationInit(); 
+    rulesInit();
+    guardInit();        // nach Ventil/Flow: Timer startet sofort
+    leakInit();
+    sigInit();
+    runlogInit();       // offenen Lauf von vor dem Reset ablegen
+    statsInit();
+    historyInit();
 
     wifiInit();
     timeInit();
     mqttInit();
     mqttSetCommandCallback(onMqttCommand);
 
+    otaInit();
+    snapshotInit();
     webInit();
     watchdogInit();
 
-    lastOpenTimestamp = time(NULL);
+    lastOpenTimestamp = clockNow();
     logInfo("Setup done");
 }
 
@@ -100,14 +162,25 @@ void loop() {
     wifiLoop();
     timeLoop();
     mqttLoop();
+    historyLoop();      // offline gesammelten Verlauf nachsenden
     flowLoop();
+    guardLoop();        // Notabschaltung aus dem Timer nachziehen, Alarm melden
+    leakLoop();
+    sigLoop();          // Durchfluss-Signatur des laufenden Slots
+    runlogLoop();
+    statsLoop();        // Verbrauch Tag/Woche/Monat
     batteryLoop();
     valveLoop();
+    seqLoop(clockMillis());  // Zonen öffnen/schließen
     irrigationLoop();
-    webLoop();
+    otaLoop();          // Fortschritt melden, Selbsttest nach Update
+    snapshotPublish();  // Zustand dieses Durchlaufs für alle Serializer
+    webLoop();          // Kommandos aus dem Web-Task ausführen
     watchdogLoop();
 
-    unsigned long nowMs = millis(); 
+    unsigned long nowMs = clockMillis(); 
+    DeviceSnapshot snap;
+    snapshotGet(snap);
 
     // BOOT EVENT
     static bool bootEventSent = false;
@@ -124,19 +197,27 @@ void loop() {
     
     if (nowMs - lastLogTime >= 60000) triggerLog = true;
     
-    ValveState currentV = valveGetState();
+    ValveState currentV = snap.valve;
     if (currentV != lastValveForLog) {
         triggerLog = true;
         if (currentV == ValveState::OPEN) {
             logFlowEvent("START Valve Open");
             mqttPublishEvent("valve_open");
-            lastFlowTotal = flowGetTotalLiters(); 
+            lastFlowTotal = snap.flowTotalL; 
         } else {
-            float delta = flowGetTotalLiters() - lastFlowTotal;
+            float delta = snap.flowTotalL - lastFlowTotal;
             String msg = "STOP Valve Closed (Total: " + String(delta, 1) + " L)";
             logFlowEvent(msg);
             
             String extra = "\"last_run_l\":" + String(delta, 2);
+            int sigSlot;
+            float sigScore;
+            const char* sigKind;
+            if (sigGetScore(sigSlot, sigScore, sigKind)) {
+                extra += ",\"sig_slot\":" + String(sigSlot + 1);
+                extra += ",\"sig_score\":" + String(sigScore, 1);
+                extra += ",\"sig_kind\":\"" + String(sigKind) + "\"";
+            }
             mqttPublishEvent("valve_close", extra);
             flowSaveToFlash();
         }
@@ -144,55 +225,67 @@ void loop() {
     }
     
     if (triggerLog) {
-        time_t rawTime;
-        time(&rawTime);
-        if (rawTime > 1700000000) { 
-            String histJson = buildHistoryJson(rawTime);
-            mqttLogDataPoint(histJson);
+        if (snap.epoch > 1700000000) { 
+            historyAdd(snap);       // kompakt speichern, online sofort als JSON
             lastLogTime = nowMs;
         }
     }
 
     // 2. LIVE STATUS
     unsigned long teleInterval = 60000; 
-    if (valveGetState() == ValveState::OPEN || flowGetLpm() > 0.0) teleInterval = 5000;
+    if (snap.valve == ValveState::OPEN || snap.flowLpm > 0.0) teleInterval = 5000;
 
     if (nowMs - lastStatePublishMs >= teleInterval) {
-        mqttPublishState((valveGetState() == ValveState::OPEN) ? "OPEN" : "CLOSED"); 
-        String teleJson = buildTeleJson(); 
+        mqttPublishState((snap.valve == ValveState::OPEN) ? "OPEN" : "CLOSED"); 
+        String teleJson = buildTeleJson(snap); 
         mqttPublish(TOPIC_TELE, teleJson.c_str());
         mqttPublish(TOPIC_LWT, MQTT_PAYLOAD_ONLINE); 
-        mqttPublishUsage(valveGetDailyOpenSec(), settingsGetDailyLimitSec());
+        mqttPublishUsage(snap.dailyOpenSec, snap.dailyLimitSec);
+        mqttPublish(TOPIC_ZONES, snapshotZonesJson(snap).c_str());
         lastStatePublishMs = nowMs;
     }
 
+    // 2a. WARTESCHLANGE bei Änderung
+    static uint32_t lastQueueVersion = 0;
+    if (snap.queueVersion != lastQueueVersion) {
+        mqttPublish(TOPIC_QUEUE, snapshotQueueJson(snap).c_str());
+        lastQueueVersion = snap.queueVersion;
+    }
+
+    // 2b. HTTP-STATISTIK (alle 5 min)
+    static unsigned long lastHttpStatsMs = 0;
+    if (nowMs - lastHttpStatsMs >= 300000) {
+        webPublishRouteStats();
+        lastHttpStatsMs = nowMs;
+    }
+
     // 3. LED
     static bool led = false;
     static unsigned long lastLedMs = 0;
     if (nowMs - lastLedMs >= (wifiIsConnected() ? 1000 : 200)) {
         led = !led;
-        digitalWrite(PIN_STATUS_LED, led ? HIGH : LOW);
+        halDigitalWrite(PIN_STATUS_LED, led ? HIGH : LOW);
         lastLedMs = nowMs;
     }
 
-    // 4. TAGES-RESET
-    static int lastDay = -1; 
-    time_t rawTime = time(NULL);
+    // 4. TAGES-RESET (Datum steht im Ventil-Konto, auch nach Neustart)
+    time_t rawTime = clockNow();
     struct tm timeInfo;
-    if (localtime_r(&rawTime, &timeInfo) && timeInfo.tm_year > (2020 - 1900)) {
-        if (lastDay == -1) lastDay = timeInfo.tm_mday; 
-        if (timeInfo.tm_mday != lastDay) {
+    if (clockLocal(rawTime, timeInfo) && timeInfo.tm_year > (2020 - 1900)) {
+        int32_t day = (timeInfo.tm_year + 1900) * 10000 + (timeInfo.tm_mon + 1) * 100 + timeInfo.tm_mday;
+        if (valveRollDay(day)) {
             logInfo("Daily Reset.");
-            valveResetDailyOpenSec();
-            limitWarningSent = false;   
-            lastDay = timeInfo.tm_mday; 
+            limitWarningSent = false;
         }
+        statsRoll(timeInfo);    // gleicher Zeitpunkt: Tag, Woche, Monat
     }
 
     // 5. SAFETY
-    if (valveGetDailyOpenSec() > (unsigned long)settingsGetDailyLimitSec()) {
+    if (valveGetDailyOpenMs() > (uint32_t)settingsGetDailyLimitSec() * 1000UL) {
         if (valveGetState() == ValveState::OPEN) {
             logError("FAILSAFE: Limit Exceeded");
+            runlogNoteStop(RunStop::LIMIT);
+            irrigationCancelRun("daily limit");     // nicht irrigationStop(): kein AUTO, keine Signatur
             valveSet(ValveState::CLOSED);
             irrigationSetMode(IrrigationMode::MANUAL);
             if (!limitWarningSent) {
@@ -205,11 +298,12 @@ void loop() {
     // Auto Reboot (Safe)
     static int lastCheckHour = -1;
     if (rawTime > 1700000000) {
-        struct tm* ti = localtime(&rawTime);
-        if (ti->tm_hour != lastCheckHour) {
-            lastCheckHour = ti->tm_hour;
+        struct tm ti;
+        clockLocal(rawTime, ti);
+        if (ti.tm_hour != lastCheckHour) {
+            lastCheckHour = ti.tm_hour;
             int rebootH = settingsGetRebootHour();
-            if (rebootH >= 0 && ti->tm_hour == rebootH) {
+            if (rebootH >= 0 && ti.tm_hour == rebootH) {
                 if (valveGetState() == ValveState::CLOSED) {
                     logWarn("Auto-Reboot Triggered");
                     mqttPublishEvent("reboot_scheduled");
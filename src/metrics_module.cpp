@@ -0,0 +1,115 @@
+#include "metrics_module.h"
+#include "config.h"
+#include "clock_module.h"
+#include "hal.h"
+
+std::atomic<uint32_t> metricCounters[MC_COUNT];
+std::atomic<int32_t>  metricGauges[MG_COUNT];
+
+const char* METRICS_CONTENT_TYPE = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+struct MetricInfo {
+    const char* name;
+    const char* help;
+};
+
+static const MetricInfo COUNTER_INFO[MC_COUNT] = {
+    { "irrigation_flow_pulses",      "Accepted flow sensor pulses" },
+    { "irrigation_flow_glitches",    "Flow pulses rejected by minimum pulse spacing" },
+    { "irrigation_valve_actuations", "Valve state changes" },
+    { "irrigation_valve_faults",     "Stuck-open or stuck-closed valve detections" },
+    { "irrigation_guard_trips",      "Flow guard cut-offs (burst, run volume, flow while closed)" },
+    { "irrigation_mqtt_publishes",   "MQTT messages handed to the client" },
+    { "irrigation_mqtt_drops",       "MQTT messages not sent (offline, buffer, queue full)" },
+    { "irrigation_mqtt_reconnects",  "Successful MQTT broker connections" },
+    { "irrigation_wifi_reconnects",  "WiFi reconnect attempts" },
+};
+
+static const MetricInfo GAUGE_INFO[MG_COUNT] = {
+    { "irrigation_valve_open",              "Number of open valve zones" },
+    { "irrigation_valve_daily_open_seconds", "Valve open time today" },
+    { "irrigation_loop_avg_microseconds",   "Main loop period, moving average" },
+    { "irrigation_loop_max_microseconds",   "Main loop period, maximum of the last 10 s" },
+    { "irrigation_leak_score_percent",      "Low-flow leak confidence while valves are closed" },
+};
+
+// === LOOP-HISTOGRAMM ===
+// Obergrenzen in µs; uint64-Summe -> kurzer Critical Section statt Atomic
+static const uint32_t LOOP_BUCKET_US[] = { 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000, 500000 };
+static const int LOOP_BUCKETS = sizeof(LOOP_BUCKET_US) / sizeof(LOOP_BUCKET_US[0]);
+
+static portMUX_TYPE histMux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t loopHist[LOOP_BUCKETS + 1];
+static uint32_t loopCount = 0;
+static uint64_t loopSumUs = 0;
+
+void metricObserveLoopUs(uint32_t us) {
+    int b = 0;
+    while (b < LOOP_BUCKETS && us > LOOP_BUCKET_US[b]) b++;
+    portENTER_CRITICAL(&histMux);
+    loopHist[b]++;
+    loopCount++;
+    loopSumUs += us;
+    portEXIT_CRITICAL(&histMux);
+}
+
+// µs als Sekunden mit 6 Nachkommastellen, ohne float
+static String usToSeconds(uint64_t us) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%llu.%06llu",
+             (unsigned long long)(us / 1000000ULL), (unsigned long long)(us % 1000000ULL));
+    return String(buf);
+}
+
+static String family(const char* name, const char* type, const char* help) {
+    return "# TYPE " + String(name) + " " + type + "\n# HELP " + name + " " + help + "\n";
+}
+
+void metricsRender(MetricsSink sink) {
+    for (int i = 0; i < MC_COUNT; i++) {
+        String c = family(COUNTER_INFO[i].name, "counter", COUNTER_INFO[i].help);
+        c += String(COUNTER_INFO[i].name) + "_total " +
+             String((unsigned long)metricCounters[i].load(std::memory_order_relaxed)) + "\n";
+        sink(c);
+    }
+
+    for (int i = 0; i < MG_COUNT; i++) {
+        String c = family(GAUGE_INFO[i].name, "gauge", GAUGE_INFO[i].help);
+        c += String(GAUGE_INFO[i].name) + " " +
+             String((long)metricGauges[i].load(std::memory_order_relaxed)) + "\n";
+        sink(c);
+    }
+
+    // Heap direkt beim Scrape abfragen (IDF führt das Minimum selbst)
+    String c = family("irrigation_heap_free_bytes", "gauge", "Free heap");
+    c += "irrigation_heap_free_bytes " + String((unsigned long)halFreeHeap()) + "\n";
+    c += family("irrigation_heap_min_free_bytes", "gauge", "Lowest free heap since boot");
+    c += "irrigation_heap_min_free_bytes " + String((unsigned long)halMinFreeHeap()) + "\n";
+    c += family("irrigation_uptime_seconds", "gauge", "Time since boot");
+    c += "irrigation_uptime_seconds " + String(clockMillis() / 1000) + "\n";
+    c += family("irrigation_build", "info", "Firmware build");
+    c += "irrigation_build_info{version=\"" + String(FW_VERSION) + "\"} 1\n";
+    sink(c);
+
+    uint32_t hist[LOOP_BUCKETS + 1];
+    uint32_t count;
+    uint64_t sumUs;
+    portENTER_CRITICAL(&histMux);
+    memcpy(hist, loopHist, sizeof(hist));
+    count = loopCount;
+    sumUs = loopSumUs;
+    portEXIT_CRITICAL(&histMux);
+
+    const char* h = "irrigation_loop_duration_seconds";
+    c = family(h, "histogram", "Main loop period");
+    uint32_t cum = 0;
+    for (int b = 0; b < LOOP_BUCKETS; b++) {
+        cum += hist[b];
+        c += String(h) + "_bucket{le=\"" + usToSeconds(LOOP_BUCKET_US[b]) + "\"} " + String((unsigned long)cum) + "\n";
+    }
+    c += String(h) + "_bucket{le=\"+Inf\"} " + String((unsigned long)count) + "\n";
+    c += String(h) + "_sum " + usToSeconds(sumUs) + "\n";
+    c += String(h) + "_count " + String((unsigned long)count) + "\n";
+    c += "# EOF\n";
+    sink(c);
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+
+// Feste, statisch angelegte Metriken für /metrics (OpenMetrics-Text).
+// Zähler sind 32-Bit Atomics (ein amoadd auf dem C6) und dürfen aus ISR,
+// Haupt-Loop und Web-Task ohne Lock erhöht werden.
+
+enum MetricCounter : uint8_t {
+    MC_FLOW_PULSES,          // akzeptierte Impulse (ISR)
+    MC_FLOW_GLITCHES,        // verworfen wegen MIN_PULSE_SPACING_US (ISR)
+    MC_VALVE_ACTUATIONS,     // Zustandswechsel des Ventils
+    MC_VALVE_FAULTS,         // klemmt offen / klemmt zu erkannt
+    MC_GUARD_TRIPS,          // Schnellabschaltung (Burst, Menge, Fluss bei zu)
+    MC_MQTT_PUBLISHES,       // erfolgreich an den Client übergeben
+    MC_MQTT_DROPS,           // nicht gesendet (offline, Puffer, Queue voll)
+    MC_MQTT_RECONNECTS,      // erfolgreiche Verbindungen zum Broker
+    MC_WIFI_RECONNECTS,      // Reconnect-Versuche
+    MC_COUNT
+};
+
+enum MetricGauge : uint8_t {
+    MG_VALVE_OPEN,
+    MG_DAILY_OPEN_SEC,
+    MG_LOOP_AVG_US,
+    MG_LOOP_MAX_US,
+    MG_LEAK_SCORE,
+    MG_COUNT
+};
+
+extern std::atomic<uint32_t> metricCounters[MC_COUNT];
+extern std::atomic<int32_t>  metricGauges[MG_COUNT];
+
+static inline __attribute__((always_inline)) void metricInc(MetricCounter c) {
+    metricCounters[c].fetch_add(1, std::memory_order_relaxed);
+}
+
+static inline void metricSet(MetricGauge g, int32_t v) {
+    metricGauges[g].store(v, std::memory_order_relaxed);
+}
+
+// Loop-Dauer in µs ins Histogramm (nur aus dem Haupt-Loop)
+void metricObserveLoopUs(uint32_t us);
+
+// Rendert alle Metriken stückweise; sink wird pro Metrik-Familie aufgerufen
+typedef void (*MetricsSink)(const String &chunk);
+void metricsRender(MetricsSink sink);
+
+extern const char* METRICS_CONTENT_TYPE;
@@ -1,31 +1,26 @@
 #include "mqtt_module.h"
 #include "config.h"
+#include "clock_module.h"
+#include "hal.h"
 #include "logger.h"
 #include "wifi_module.h"
 #include "settings_module.h" 
-#include <WiFi.h>
-#include <PubSubClient.h>
-#include <vector> 
+#include "metrics_module.h"
 
-static WiFiClient espClient;
-static PubSubClient mqttClient(espClient);
+static HalMqttClient mqttClient;
 static MqttCommandCallback commandCallback = nullptr; 
 static unsigned long lastMqttReconnectAttempt = 0;
-static std::vector<String> historyQueue; 
 
 // === GETTER FÜR DIAGNOSE ===
-size_t mqttGetQueueSize() {
-    return historyQueue.size();
-}
-
 unsigned long mqttGetLastReconnectMs() {
     // Alter des letzten Reconnect-Versuchs (ms) für Web-Diag
     if (lastMqttReconnectAttempt == 0) return 0;
-    return millis() - lastMqttReconnectAttempt;
+    return clockMillis() - lastMqttReconnectAttempt;
 }
 
 String mqttGetStateString() { return mqttClient.connected() ? "Connected" : "Disconnected"; }
 String mqttGetLastError() { return String(mqttClient.state()); }
+int mqttGetStateCode() { return mqttClient.state(); }
 bool mqttIsConnected() { return mqttClient.connected(); }
 
 static void mqttOnMessage(char* topic, byte* payload, unsigned int length) {
@@ -37,24 +32,37 @@ static void mqttOnMessage(char* topic, byte* payload, unsigned int length) {
     }
 }
 
+// Alle Publishes laufen hierüber, damit /metrics Erfolg/Verlust zählt
+static bool mqttPub(const char* topic, const char* payload, bool retained) {
+    if (mqttClient.connected() && mqttClient.publish(topic, payload, retained)) {
+        metricInc(MC_MQTT_PUBLISHES);
+        return true;
+    }
+    metricInc(MC_MQTT_DROPS);
+    return false;
+}
+
 void mqttGracefulRestart() {
     if (mqttClient.connected()) {
         mqttClient.publish(TOPIC_LWT, MQTT_PAYLOAD_OFFLINE, true);
         mqttClient.disconnect();
     }
-    delay(500);
-    ESP.restart();
+    halDelay(500);
+    halRestart();
 }
 
 // Event für ioBroker (JSON)
 void mqttPublishEvent(const String &eventName, const String &extraJson) {
-    if (!mqttClient.connected()) return;
+    if (!mqttClient.connected()) {
+        metricInc(MC_MQTT_DROPS);
+        return;
+    }
     String json = "{\"event\":\"" + eventName + "\",";
     json += "\"fw\":\"" + String(FW_VERSION) + "\",";
-    json += "\"ts_uptime\":" + String(millis()/1000);
+    json += "\"ts_uptime\":" + String(clockMillis()/1000);
     if (extraJson.length() > 0) json += "," + extraJson;
     json += "}";
-    mqttClient.publish(TOPIC_EVENT, json.c_str(), false);
+    mqttPub(TOPIC_EVENT, json.c_str(), false);
     logInfo("Event sent: " + eventName);
 }
 
@@ -65,13 +73,14 @@ static bool mqttReconnect() {
     mqttClient.setCallback(mqttOnMessage);
     
     // Unique Client ID mit MAC
-    String cid = String(MQTT_CLIENT_ID) + "-" + String((uint32_t)ESP.getEfuseMac(), HEX);
+    String cid = String(MQTT_CLIENT_ID) + "-" + String(halChipId(), HEX);
     
     // LWT setzen (Retained = true)
     if (mqttClient.connect(cid.c_str(), 0, 0, TOPIC_LWT, 1, true, MQTT_PAYLOAD_OFFLINE)) {
         logInfo("MQTT Connected");
+        metricInc(MC_MQTT_RECONNECTS);
         // Sofort Online melden
-        mqttClient.publish(TOPIC_LWT, MQTT_PAYLOAD_ONLINE, true);
+        mqttPub(TOPIC_LWT, MQTT_PAYLOAD_ONLINE, true);
         
         mqttClient.subscribe(TOPIC_CMD);
         mqttClient.subscribe(TOPIC_CFG);
@@ -93,18 +102,13 @@ void mqttLoop() {
     if (!wifiIsConnected()) return;
     
     if (!mqttClient.connected()) {
-        unsigned long now = millis();
+        unsigned long now = clockMillis();
         if (now - lastMqttReconnectAttempt > 5000) {
             lastMqttReconnectAttempt = now;
             mqttReconnect();
         }
     } else {
         mqttClient.loop();
-        // History Queue abarbeiten (wenn Puffer voll läuft)
-        if (!historyQueue.empty()) {
-            mqttClient.publish(TOPIC_HISTORY, historyQueue.front().c_str(), false);
-            historyQueue.erase(historyQueue.begin());
-        }
     }
 }
 
@@ -112,28 +116,20 @@ void mqttSetCommandCallback(MqttCommandCallback cb) { commandCallback = cb; }
 
 // === HIER WAR DER FEHLER ===
 void mqttPublishState(const String &s) {
-    if(mqttClient.connected()) {
-        // ALT/FALSCH: mqttClient.publish(TOPIC_STATE, ("{\"state\":\""+s+"\"}").c_str(), true);
-        
-        // NEU/RICHTIG (für dein ioBroker Script): Einfach "OPEN" oder "CLOSED"
-        mqttClient.publish(TOPIC_STATE, s.c_str(), true);
-    }
+    // ALT/FALSCH: mqttClient.publish(TOPIC_STATE, ("{\"state\":\""+s+"\"}").c_str(), true);
+
+    // NEU/RICHTIG (für dein ioBroker Script): Einfach "OPEN" oder "CLOSED"
+    mqttPub(TOPIC_STATE, s.c_str(), true);
 }
 // ===========================
 
 void mqttPublishDiag(const String &m) {
-    if(mqttClient.connected()) mqttClient.publish(TOPIC_DIAG, m.c_str());
+    mqttPub(TOPIC_DIAG, m.c_str(), false);
 }
 void mqttPublishUsage(long u, long l) {
-    if(mqttClient.connected()) {
-        mqttClient.publish(TOPIC_USAGE, String(u).c_str(), true);
-        mqttClient.publish(TOPIC_LIMIT, String(l).c_str(), true);
-    }
-}
-void mqttLogDataPoint(String j) {
-    if(mqttClient.connected()) mqttClient.publish(TOPIC_HISTORY, j.c_str(), false);
-    else if(historyQueue.size() < 150) historyQueue.push_back(j);
+    mqttPub(TOPIC_USAGE, String(u).c_str(), true);
+    mqttPub(TOPIC_LIMIT, String(l).c_str(), true);
 }
-void mqttPublish(const char* t, const char* p) {
-    if(mqttClient.connected()) mqttClient.publish(t, p);
+bool mqttPublish(const char* t, const char* p, bool retained) {
+    return mqttPub(t, p, retained);
 }
\ No newline at end of file
@@ -12,10 +12,7 @@ void mqttSetCommandCallback(MqttCommandCallback callback);
 void mqttPublishState(const String &state);     // Sendet OPEN/CLOSED
 void mqttPublishDiag(const String &msg);        // Sendet Text Diagnose
 void mqttPublishUsage(long usageSec, long limitSec); // Sendet /usage und /limit
-void mqttPublish(const char* topic, const char* payload);
-
-// Data Logging (History)
-void mqttLogDataPoint(String jsonPayload);
+bool mqttPublish(const char* topic, const char* payload, bool retained = false);
 
 // === NEU (Wiederhergestellt): JSON Events ===
 // Sendet strukturiertes Event an /event (für ioBroker Skripte)
@@ -24,9 +21,9 @@ void mqttPublishEvent(const String &eventName, const String &extraJson = "");
 // Diagnose & Status Helper
 String mqttGetStateString();    // "Connected", "Disconnected"...
 String mqttGetLastError();      // Letzter Fehlergrund
+int    mqttGetStateCode();      // PubSubClient state() als Zahl
 bool   mqttIsConnected();       // Verbindung da?
 void   mqttGracefulRestart();   // Sendet "Offline", wartet kurz, rebootet
 
 // NEU: Diagnose Getter
-size_t mqttGetQueueSize();
 unsigned long mqttGetLastReconnectMs();
\ No newline at end of file
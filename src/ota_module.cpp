@@ -0,0 +1,510 @@
+#include "ota_module.h"
+#include "config.h"
+#include "logger.h"
+#include "wifi_module.h"
+#include "mqtt_module.h"
+#include "valve_module.h"
+#include "flow_module.h"
+#include "irrigation_module.h"
+#include "runlog_module.h"
+#include <Update.h>
+#include <HTTPClient.h>
+#include <esp_ota_ops.h>
+#include <mbedtls/sha256.h>
+#include <rom/miniz.h>
+#include <atomic>
+
+// Arduino-Core: true = Image nach dem Boot NICHT sofort als gültig markieren,
+// das übernimmt otaLoop() nach dem Selbsttest.
+extern "C" bool verifyRollbackLater() { return true; }
+
+static mbedtls_sha256_context shaCtx;
+static char expectedSha[65] = "";
+static char lastSha[65] = "";
+static char lastError[48] = "";
+
+static std::atomic<uint8_t>  state((uint8_t)OtaState::IDLE);
+static std::atomic<uint8_t>  owner((uint8_t)OtaOwner::NONE);
+static std::atomic<uint32_t> written(0);
+static std::atomic<uint32_t> total(0);
+
+// Selbsttest nach Update
+static bool pendingVerify = false;
+static unsigned long verifyStartMs = 0;
+
+// Pull-OTA (eigener Task)
+static const uint32_t PULL_TASK_STACK = 8192;
+static const int      PULL_MAX_RESUMES = 10;
+static const unsigned long PULL_STALL_MS = 15000;   // keine Daten -> neu verbinden
+static const unsigned long PULL_WIFI_WAIT_MS = 240000;
+static String pullUrl;
+static String pullSha;
+static TaskHandle_t pullTaskHandle = nullptr;
+static std::atomic<bool> pullActive(false);     // Web-Task liest mit
+static std::atomic<uint8_t> pullResumes(0);
+static std::atomic<bool> restartPending(false);
+
+static void otaSetState(OtaState s) { state.store((uint8_t)s); }
+
+// Sitzung belegen: frei oder schon unsere (Pull reserviert beim Start)
+static bool otaClaim(OtaOwner who) {
+    uint8_t expected = (uint8_t)OtaOwner::NONE;
+    return owner.load() == (uint8_t)who || owner.compare_exchange_strong(expected, (uint8_t)who);
+}
+
+static bool otaIsOwner(OtaOwner who) {
+    return who != OtaOwner::NONE && owner.load() == (uint8_t)who;
+}
+
+// Sitzung zu Ende: Web-Upload gibt frei, der Pull erst am Ende seines Tasks
+static void otaRelease() {
+    if (owner.load() == (uint8_t)OtaOwner::WEB) owner.store((uint8_t)OtaOwner::NONE);
+}
+
+static void toHex(const uint8_t* d, size_t n, char* out) {
+    static const char HEX_CHARS[] = "0123456789abcdef";
+    for (size_t i = 0; i < n; i++) {
+        out[i * 2]     = HEX_CHARS[d[i] >> 4];
+        out[i * 2 + 1] = HEX_CHARS[d[i] & 0x0F];
+    }
+    out[n * 2] = '\0';
+}
+
+// === KOMPRIMIERTE IMAGES ===
+// Format von tools/ota_compress.py: "OTZ1" + Rohgröße (uint32 LE) + zlib-Stream.
+// Entpackt wird mit tinfl aus dem ROM in ein Ringfenster, dessen Größe der
+// zlib-Header vorgibt (Host-Tool: 8 KB). Alles andere gilt als Roh-Image.
+static const uint8_t OTZ_MAGIC[4] = { 'O', 'T', 'Z', '1' };
+static const size_t  OTZ_HEADER_LEN = 8;
+
+enum class OtaFormat : uint8_t { UNKNOWN, RAW, ZLIB };
+static OtaFormat format = OtaFormat::UNKNOWN;
+static uint8_t hdrBuf[OTZ_HEADER_LEN];
+static size_t hdrLen = 0;
+static size_t transferSize = 0;
+static uint32_t imageSize = 0;          // entpackt, 0 = unbekannt
+
+static tinfl_decompressor* inflator = nullptr;
+static uint8_t* window = nullptr;
+static size_t windowSize = 0;
+static size_t windowPos = 0;
+static bool inflateDone = false;
+
+static void otaFreeBuffers() {
+    free(inflator);
+    free(window);
+    inflator = nullptr;
+    window = nullptr;
+}
+
+static void otaFail(const char* reason) {
+    strncpy(lastError, reason, sizeof(lastError) - 1);
+    lastError[sizeof(lastError) - 1] = '\0';
+    otaSetState(OtaState::FAILED);
+    otaRelease();
+    logError(String("OTA failed: ") + reason);
+}
+
+// Fehler mitten im Update: Flash-Schreiben abbrechen, Puffer freigeben
+static void otaFailWriting(const char* reason) {
+    if (Update.isRunning()) Update.abort();
+    mbedtls_sha256_free(&shaCtx);
+    otaFreeBuffers();
+    otaFail(reason);
+}
+
+static bool otaFlashWrite(const uint8_t* data, size_t len) {
+    if (Update.write((uint8_t*)data, len) != len) {
+        otaFailWriting(Update.errorString());
+        return false;
+    }
+    return true;
+}
+
+// Format steht fest (Header komplett oder erstes Byte passt nicht)
+static bool otaStartImage() {
+    bool compressed = hdrLen == OTZ_HEADER_LEN && memcmp(hdrBuf, OTZ_MAGIC, sizeof(OTZ_MAGIC)) == 0;
+    if (compressed) {
+        format = OtaFormat::ZLIB;
+        imageSize = hdrBuf[4] | (hdrBuf[5] << 8) | (hdrBuf[6] << 16) | ((uint32_t)hdrBuf[7] << 24);
+    } else {
+        format = OtaFormat::RAW;
+        imageSize = transferSize;
+    }
+    if (!Update.begin(imageSize > 0 ? imageSize : UPDATE_SIZE_UNKNOWN)) {
+        otaFailWriting(Update.errorString());
+        return false;
+    }
+    logInfo(String("OTA image ") + (compressed ? "zlib" : "raw") + ", size=" + String((unsigned long)imageSize));
+    // Bei Roh-Images gehören die gepufferten Bytes schon zum Image
+    return compressed || otaFlashWrite(hdrBuf, hdrLen);
+}
+
+static bool otaInflate(const uint8_t* in, size_t len) {
+    if (inflateDone) return true;   // Rest nach dem Stream ignorieren
+    if (window == nullptr) {
+        // CMF-Byte: obere 4 Bit = log2(Fenster) - 8
+        windowSize = 1u << ((in[0] >> 4) + 8);
+        if ((in[0] & 0x0F) != 8 || windowSize > OTA_INFLATE_MAX_WINDOW) {
+            otaFailWriting("bad zlib header");
+            return false;
+        }
+        inflator = (tinfl_decompressor*)malloc(sizeof(tinfl_decompressor));
+        window = (uint8_t*)malloc(windowSize);
+        if (!inflator || !window) {
+            otaFailWriting("no memory for inflate");
+            return false;
+        }
+        tinfl_init(inflator);
+        windowPos = 0;
+    }
+
+    for (;;) {
+        size_t inBytes = len;
+        size_t outBytes = windowSize - windowPos;
+        tinfl_status st = tinfl_decompress(inflator, in, &inBytes, window, window + windowPos, &outBytes,
+                                           TINFL_FLAG_PARSE_ZLIB_HEADER | TINFL_FLAG_HAS_MORE_INPUT |
+                                           TINFL_FLAG_COMPUTE_ADLER32);
+        in += inBytes;
+        len -= inBytes;
+        if (outBytes > 0 && !otaFlashWrite(window + windowPos, outBytes)) return false;
+        windowPos = (windowPos + outBytes) & (windowSize - 1);
+
+        if (st == TINFL_STATUS_DONE) {
+            inflateDone = true;
+            return true;
+        }
+        if (st < 0) {
+            otaFailWriting(st == TINFL_STATUS_ADLER32_MISMATCH ? "adler32 mismatch" : "inflate error");
+            return false;
+        }
+        if (st == TINFL_STATUS_NEEDS_MORE_INPUT && len == 0) return true;
+    }
+}
+
+OtaOwner otaBegin(OtaOwner who, size_t size, const String &sha256Hex) {
+    if (who == OtaOwner::NONE || otaGetState() == OtaState::WRITING || !otaClaim(who)) {
+        logWarn("OTA busy, new update rejected");
+        return OtaOwner::NONE;
+    }
+
+    String sha = sha256Hex;
+    sha.trim();
+    sha.toLowerCase();
+    if (sha.length() != 0 && sha.length() != 64) {
+        otaFail("bad sha256 length");
+        return OtaOwner::NONE;
+    }
+    if (OTA_REQUIRE_SHA256 && sha.length() == 0) {
+        otaFail("sha256 required");
+        return OtaOwner::NONE;
+    }
+    strncpy(expectedSha, sha.c_str(), sizeof(expectedSha) - 1);
+    expectedSha[sizeof(expectedSha) - 1] = '\0';
+    lastError[0] = '\0';
+    lastSha[0] = '\0';
+
+    written.store(0);
+    total.store(size);
+    transferSize = size;
+    format = OtaFormat::UNKNOWN;
+    hdrLen = 0;
+    imageSize = 0;
+    inflateDone = false;
+
+    // Update.begin() erst, wenn das Format (und damit die Image-Größe) feststeht
+    mbedtls_sha256_init(&shaCtx);
+    mbedtls_sha256_starts(&shaCtx, 0);   // 0 = SHA-256 (nicht 224)
+    otaSetState(OtaState::WRITING);
+    logInfo("OTA start, transfer=" + String((unsigned long)size) + (expectedSha[0] ? " (sha256 check)" : " (unverified)"));
+    return who;
+}
+
+// data/len: übertragene Bytes (roh oder komprimiert). Hash und Fortschritt
+// beziehen sich auf die übertragene Datei.
+bool otaWrite(OtaOwner who, const uint8_t* data, size_t len) {
+    if (otaGetState() != OtaState::WRITING || !otaIsOwner(who)) return false;
+    if (len == 0) return true;
+    mbedtls_sha256_update(&shaCtx, data, len);
+    written.fetch_add(len);
+
+    if (format == OtaFormat::UNKNOWN) {
+        while (len > 0 && hdrLen < OTZ_HEADER_LEN) {
+            hdrBuf[hdrLen++] = *data++;
+            len--;
+            if (hdrLen <= sizeof(OTZ_MAGIC) && hdrBuf[hdrLen - 1] != OTZ_MAGIC[hdrLen - 1]) break;
+        }
+        bool magicOk = hdrLen > sizeof(OTZ_MAGIC) || hdrBuf[hdrLen - 1] == OTZ_MAGIC[hdrLen - 1];
+        if (magicOk && hdrLen < OTZ_HEADER_LEN) return true;   // Header noch unvollständig
+        if (!otaStartImage()) return false;
+    }
+    if (len == 0) return true;
+    return (format == OtaFormat::ZLIB) ? otaInflate(data, len) : otaFlashWrite(data, len);
+}
+
+bool otaFinish(OtaOwner who) {
+    if (otaGetState() != OtaState::WRITING || !otaIsOwner(who)) return false;
+    if (format == OtaFormat::UNKNOWN && (hdrLen == 0 || !otaStartImage())) {
+        if (otaGetState() == OtaState::WRITING) otaFailWriting("empty image");
+        return false;
+    }
+    if (format == OtaFormat::ZLIB && !inflateDone) {
+        otaFailWriting("compressed image truncated");
+        return false;
+    }
+    otaFreeBuffers();
+
+    uint8_t digest[32];
+    mbedtls_sha256_finish(&shaCtx, digest);
+    mbedtls_sha256_free(&shaCtx);
+    toHex(digest, sizeof(digest), lastSha);
+
+    if (expectedSha[0] && strcmp(expectedSha, lastSha) != 0) {
+        Update.abort();
+        otaFail("sha256 mismatch");
+        logError(String("OTA expected ") + expectedSha + " got " + lastSha);
+        return false;
+    }
+    if (!Update.end(true)) {
+        otaFail(Update.errorString());
+        return false;
+    }
+    otaSetState(OtaState::DONE);
+    otaRelease();
+    logInfo(String("OTA written, sha256=") + lastSha);
+    return true;
+}
+
+void otaAbort(OtaOwner who, const char* reason) {
+    if (otaGetState() != OtaState::WRITING || !otaIsOwner(who)) return;
+    otaFailWriting(reason);
+}
+
+bool otaPullRunning() { return pullActive.load(); }
+
+OtaState otaGetState() { return (OtaState)state.load(); }
+
+int otaGetProgressPct() {
+    OtaState s = otaGetState();
+    if (s == OtaState::IDLE || s == OtaState::FAILED) return -1;
+    if (s == OtaState::DONE) return 100;
+    uint32_t t = total.load();
+    if (t == 0) return 0;   // Größe unbekannt
+    return (int)((uint64_t)written.load() * 100 / t);
+}
+
+const char* otaGetError() { return lastError; }
+String otaGetSha256() { return String(lastSha); }
+bool otaIsPendingVerify() { return pendingVerify; }
+
+// === SELBSTTEST NACH UPDATE ===
+void otaInit() {
+    const esp_partition_t* running = esp_ota_get_running_partition();
+    esp_ota_img_states_t st;
+    if (running && esp_ota_get_state_partition(running, &st) == ESP_OK && st == ESP_OTA_IMG_PENDING_VERIFY) {
+        pendingVerify = true;
+        verifyStartMs = millis();
+        logWarn("OTA: new image pending verify (" + String(OTA_VERIFY_WINDOW_MS / 1000) + " s window)");
+    }
+}
+
+static bool otaSelfTestOk() {
+    if (!wifiIsConnected() || !mqttIsConnected()) return false;
+    if (!valveSelfTest()) return false;
+    // Ventil zu -> es darf nichts fließen (Sensor/ISR spinnt nicht)
+    if (valveGetState() == ValveState::CLOSED && flowGetLpm() > OTA_SELFTEST_MAX_LPM) return false;
+    return true;
+}
+
+static void otaPublishProgress() {
+    static uint8_t lastState = 0xFF;
+    static int lastPct = -2;
+    uint8_t s = state.load();
+    int pct = otaGetProgressPct();
+    // nur bei Zustandswechsel oder alle 5 %
+    if (s == lastState && (pct < 0 || pct - lastPct < 5)) return;
+    lastState = s;
+    lastPct = pct;
+    if ((OtaState)s == OtaState::IDLE) return;
+
+    static const char* NAMES[] = { "idle", "writing", "done", "failed" };
+    String j = "{\"state\":\"" + String(NAMES[s]) + "\",\"pct\":" + String(pct);
+    j += ",\"bytes\":" + String((unsigned long)written.load());
+    if (pullResumes.load() > 0) j += ",\"resumes\":" + String(pullResumes.load());
+    if (lastSha[0]) j += ",\"sha256\":\"" + String(lastSha) + "\"";
+    if (lastError[0]) j += ",\"error\":\"" + String(lastError) + "\"";
+    j += "}";
+    mqttPublish(TOPIC_OTA, j.c_str());
+}
+
+// === PULL-OTA ===
+// Ein GET-Versuch ab 'written'. true = Datei komplett, false = abgebrochen.
+// Harte Fehler (HTTP-Status, Range ignoriert, Flash) beenden das Update.
+static bool otaPullAttempt(uint8_t* buf, size_t bufSize) {
+    uint32_t offset = written.load();
+    WiFiClient client;
+    HTTPClient http;
+    http.setConnectTimeout(5000);
+    http.setTimeout(PULL_STALL_MS);
+    if (!http.begin(client, pullUrl)) {
+        otaFail("bad url");
+        return false;
+    }
+    const char* hdrs[] = { "Content-Range" };
+    http.collectHeaders(hdrs, 1);
+    if (offset > 0) http.addHeader("Range", "bytes=" + String((unsigned long)offset) + "-");
+
+    int code = http.GET();
+    if (code <= 0) {                       // Verbindungsfehler -> Resume
+        logWarn("OTA pull: " + HTTPClient::errorToString(code));
+        http.end();
+        return false;
+    }
+    if (offset == 0) {
+        if (code != HTTP_CODE_OK) {
+            otaFail("http status");
+            logError("OTA pull: HTTP " + String(code));
+            http.end();
+            return false;
+        }
+        int len = http.getSize();
+        if (otaBegin(OtaOwner::PULL, len > 0 ? len : 0, pullSha) != OtaOwner::PULL) {
+            http.end();
+            return false;
+        }
+    } else {
+        // Server muss genau ab offset liefern, sonst passt der Hash nicht mehr
+        String cr = http.header("Content-Range");
+        if (code != HTTP_CODE_PARTIAL_CONTENT || !cr.startsWith("bytes " + String((unsigned long)offset) + "-")) {
+            otaAbort(OtaOwner::PULL, "range not supported");
+            http.end();
+            return false;
+        }
+        logInfo("OTA pull: resumed at " + String((unsigned long)offset));
+    }
+
+    WiFiClient* stream = http.getStreamPtr();
+    unsigned long lastDataMs = millis();
+    bool eof = false;
+    while (otaGetState() == OtaState::WRITING) {
+        uint32_t t = total.load();
+        if (t > 0 && written.load() >= t) break;
+
+        size_t avail = stream->available();
+        if (avail > 0) {
+            size_t n = stream->readBytes(buf, avail < bufSize ? avail : bufSize);
+            if (n > 0 && !otaWrite(OtaOwner::PULL, buf, n)) break;
+            lastDataMs = millis();
+        } else if (!http.connected()) {
+            eof = true;
+            break;
+        } else if (millis() - lastDataMs > PULL_STALL_MS) {
+            logWarn("OTA pull: stalled");
+            break;
+        } else {
+            vTaskDelay(pdMS_TO_TICKS(5));
+        }
+    }
+    http.end();
+
+    if (otaGetState() != OtaState::WRITING) return false;
+    uint32_t t = total.load();
+    // Größe unbekannt: Ende der Verbindung = Ende der Datei, der Hash entscheidet
+    return (t > 0) ? (written.load() >= t) : eof;
+}
+
+static void otaPullTask(void*) {
+    static uint8_t buf[2048];
+    written.store(0);
+    pullResumes.store(0);
+    logInfo("OTA pull: " + pullUrl);
+
+    bool complete = false;
+    for (int attempt = 0; attempt <= PULL_MAX_RESUMES; attempt++) {
+        if (attempt > 0) {
+            // Auf WLAN warten (wifiLoop() im Haupt-Loop verbindet neu)
+            unsigned long waitStart = millis();
+            while (!wifiIsConnected() && millis() - waitStart < PULL_WIFI_WAIT_MS) vTaskDelay(pdMS_TO_TICKS(1000));
+            vTaskDelay(pdMS_TO_TICKS(2000UL * attempt));
+            pullResumes.fetch_add(1);
+        }
+        complete = otaPullAttempt(buf, sizeof(buf));
+        if (complete) break;
+        OtaState s = otaGetState();
+        if (s == OtaState::FAILED) break;   // harter Fehler, kein Resume
+    }
+
+    if (complete && otaFinish(OtaOwner::PULL)) {
+        restartPending.store(true);
+    } else if (otaGetState() == OtaState::WRITING) {
+        otaAbort(OtaOwner::PULL, "too many resumes");
+    } else if (otaGetState() == OtaState::IDLE) {
+        otaFail("download failed");
+    }
+    pullTaskHandle = nullptr;
+    owner.store((uint8_t)OtaOwner::NONE);
+    pullActive.store(false);
+    vTaskDelete(NULL);
+}
+
+bool otaPullStart(const String &url, const String &sha256Hex) {
+    if (pullTaskHandle != nullptr || otaGetState() == OtaState::WRITING) {
+        logWarn("OTA pull rejected: update running");
+        return false;
+    }
+    if (!url.startsWith("http://")) {
+        otaFail("only http:// urls");
+        return false;
+    }
+    // Sitzung für die ganze Pull-Dauer reservieren (Web-Upload läuft -> ablehnen)
+    if (!otaClaim(OtaOwner::PULL)) {
+        logWarn("OTA pull rejected: web upload running");
+        return false;
+    }
+    pullActive.store(true);
+    pullUrl = url;
+    pullSha = sha256Hex;
+    lastError[0] = '\0';
+    otaSetState(OtaState::IDLE);   // alten FAILED-Status vergessen
+
+    // wie beim Web-Upload: Ventil sicher zu, Automatik aus, kein Resume nach dem Neustart
+    runlogNoteStop(RunStop::OTA);
+    irrigationCancelRun("OTA");
+    irrigationSetMode(IrrigationMode::MANUAL);
+    valveSet(ValveState::CLOSED);
+
+    if (xTaskCreate(otaPullTask, "ota_pull", PULL_TASK_STACK, nullptr, 1, &pullTaskHandle) != pdPASS) {
+        owner.store((uint8_t)OtaOwner::NONE);
+        pullActive.store(false);
+        otaFail("no task");
+        return false;
+    }
+    return true;
+}
+
+void otaLoop() {
+    otaPublishProgress();
+
+    // Pull-OTA fertig: Endstatus ist gemeldet, jetzt neu starten
+    static unsigned long restartAtMs = 0;
+    if (restartPending.load()) {
+        if (restartAtMs == 0) restartAtMs = millis() + 1000;
+        else if ((long)(millis() - restartAtMs) >= 0) mqttGracefulRestart();
+    }
+
+    if (!pendingVerify) return;
+    if (otaSelfTestOk()) {
+        esp_ota_mark_app_valid_cancel_rollback();
+        pendingVerify = false;
+        logInfo("OTA: self-test passed, image marked valid");
+        mqttPublishEvent("ota_valid");
+        return;
+    }
+    if (millis() - verifyStartMs > OTA_VERIFY_WINDOW_MS) {
+        logError("OTA: self-test failed, rolling back");
+        mqttPublishEvent("ota_rollback");
+        valveSafeBeforeUpdate();
+        delay(500);
+        esp_ota_mark_app_invalid_rollback_and_reboot();
+    }
+}
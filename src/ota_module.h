@@ -0,0 +1,40 @@
+#pragma once
+#include <Arduino.h>
+
+// Firmware-Update mit laufender SHA-256 Prüfung. Roh-Images oder mit
+// tools/ota_compress.py komprimierte (.otz), die beim Schreiben entpackt werden.
+// otaBegin/otaWrite/otaFinish dürfen aus dem Web-Task kommen; Fortschritt
+// und Fehler liest der Haupt-Loop (MQTT) bzw. der Snapshot (SSE).
+// Jede Sitzung hat einen Besitzer (Web-Upload oder Pull-Task): nur er darf
+// schreiben, abschließen oder abbrechen. Ein Pull hält die Sitzung vom Start
+// bis zum Ende des Tasks (auch über Resumes), Web-Uploads werden solange
+// abgelehnt und umgekehrt.
+//
+// Nach dem Neustart ist das neue Image "pending verify": otaLoop() markiert
+// es erst als gültig, wenn WLAN, MQTT und der Ventil/Flow-Selbsttest
+// innerhalb von OTA_VERIFY_WINDOW_MS bestanden sind, sonst Rollback.
+
+enum class OtaState : uint8_t { IDLE, WRITING, DONE, FAILED };
+enum class OtaOwner : uint8_t { NONE, WEB, PULL };
+
+void otaInit();
+void otaLoop();
+
+// size: 0 = unbekannt. sha256Hex: 64 Hex-Zeichen oder leer (dann nur berechnet)
+// Rückgabe: Besitzer der neuen Sitzung (= who), NONE = abgelehnt (belegt, Fehler)
+OtaOwner otaBegin(OtaOwner who, size_t size, const String &sha256Hex);
+bool otaWrite(OtaOwner who, const uint8_t* data, size_t len);
+bool otaFinish(OtaOwner who);           // Hash prüfen, Image aktivieren
+void otaAbort(OtaOwner who, const char* reason);
+bool otaPullRunning();                  // Pull-Task aktiv (aus jedem Task)
+
+OtaState otaGetState();
+int otaGetProgressPct();                // -1 = kein Update aktiv
+const char* otaGetError();
+String otaGetSha256();                  // Hash des letzten Uploads
+bool otaIsPendingVerify();              // läuft gerade ein ungeprüftes Image?
+
+// Pull-OTA: lädt url (http://, lokaler Server) in einem eigenen Task.
+// Bei Abbruch (WLAN weg) wird per HTTP Range ab dem letzten Byte fortgesetzt.
+// Nach Erfolg startet otaLoop() neu. Aufruf nur aus dem Haupt-Loop.
+bool otaPullStart(const String &url, const String &sha256Hex);
@@ -0,0 +1,381 @@
+#include "rules_module.h"
+#include "config.h"
+#include "clock_module.h"
+#include "hal.h"
+#include "logger.h"
+
+// Transponierte Masken: Bit i = Regel i erlaubt diesen Wert
+struct RuleTable {
+    uint32_t minute[60];
+    uint32_t hour[24];
+    uint32_t dom[32];       // 1..31
+    uint32_t month[13];     // 1..12
+    uint32_t dow[7];        // 0 = So
+    uint32_t domDowOr;      // Tag UND Wochentag eingeschränkt -> ODER (wie cron)
+    uint32_t enabled;
+    uint32_t skip;
+};
+
+static RuleSpec specs[MAX_RULES];
+static int specCount = 0;
+static portMUX_TYPE specMux = portMUX_INITIALIZER_UNLOCKED;
+
+static RuleTable table;
+static int32_t cachedDay = -1;
+static uint32_t cachedDayMask = 0;      // Datumsbereich + "every" für cachedDay
+static uint32_t version = 0;            // steigt bei jedem rulesSet()
+
+// === DATUM ===
+// Tage seit 1970-01-01 (proleptischer Gregorianischer Kalender, ohne Zeitzone)
+static int32_t daysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+static void civilFromDays(int32_t z, int &y, int &m, int &d) {
+    z += 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int doe = z - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp + (mp < 10 ? 3 : -9);
+    y = yoe + era * 400 + (m <= 2);
+}
+
+static bool parseDate(const String &s, int32_t &day) {
+    int y, m, d;
+    if (sscanf(s.c_str(), "%d-%d-%d", &y, &m, &d) != 3 || m < 1 || m > 12 || d < 1 || d > 31) return false;
+    day = daysFromCivil(y, m, d);
+    return true;
+}
+
+static String formatDate(int32_t day) {
+    int y, m, d;
+    civilFromDays(day, y, m, d);
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%04d-%02d-%02d", y, m, d);
+    return String(buf);
+}
+
+// === CRON-FELDER ===
+// "*", "*/n", "a", "a-b", "a-b/n", "a/n", durch ',' getrennt
+static bool parseField(const char* f, int lo, int hi, uint64_t &bits) {
+    bits = 0;
+    while (*f) {
+        int a, b, step = 1;
+        char* end;
+        if (*f == '*') {
+            a = lo;
+            b = hi;
+            f++;
+        } else {
+            a = strtol(f, &end, 10);
+            if (end == f) return false;
+            f = end;
+            b = a;
+            if (*f == '-') {
+                b = strtol(f + 1, &end, 10);
+                if (end == f + 1) return false;
+                f = end;
+            }
+        }
+        if (*f == '/') {
+            step = strtol(f + 1, &end, 10);
+            if (end == f + 1 || step <= 0) return false;
+            if (a == b) b = hi;   // "a/n" = ab a alle n
+            f = end;
+        }
+        if (a < lo || b > hi || a > b) return false;
+        for (int v = a; v <= b; v += step) bits |= 1ULL << v;
+        if (*f == ',') f++;
+        else if (*f) return false;
+    }
+    return bits != 0;
+}
+
+static bool compileRule(const RuleSpec &r, int idx, RuleTable &t, String &err) {
+    char buf[sizeof(r.cron)];
+    strncpy(buf, r.cron, sizeof(buf));
+    buf[sizeof(buf) - 1] = '\0';
+
+    char* fields[5];
+    int n = 0;
+    for (char* tok = strtok(buf, " \t"); tok && n < 5; tok = strtok(NULL, " \t")) fields[n++] = tok;
+    if (n != 5) {
+        err = "rule " + String(idx + 1) + ": cron needs 5 fields";
+        return false;
+    }
+
+    static const int LO[5] = { 0, 0, 1, 1, 0 };
+    static const int HI[5] = { 59, 23, 31, 12, 7 };
+    uint64_t bits[5];
+    for (int i = 0; i < 5; i++) {
+        if (!parseField(fields[i], LO[i], HI[i], bits[i])) {
+            err = "rule " + String(idx + 1) + ": bad field '" + String(fields[i]) + "'";
+            return false;
+        }
+    }
+    if (bits[4] & (1ULL << 7)) bits[4] |= 1;   // 7 = Sonntag
+
+    uint32_t bit = 1UL << idx;
+    for (int v = 0; v < 60; v++) if (bits[0] & (1ULL << v)) t.minute[v] |= bit;
+    for (int v = 0; v < 24; v++) if (bits[1] & (1ULL << v)) t.hour[v] |= bit;
+    for (int v = 1; v < 32; v++) if (bits[2] & (1ULL << v)) t.dom[v] |= bit;
+    for (int v = 1; v < 13; v++) if (bits[3] & (1ULL << v)) t.month[v] |= bit;
+    for (int v = 0; v < 7; v++)  if (bits[4] & (1ULL << v)) t.dow[v] |= bit;
+    if (fields[2][0] != '*' && fields[4][0] != '*') t.domDowOr |= bit;
+    if (r.enabled) t.enabled |= bit;
+    if (r.skip) t.skip |= bit;
+    return true;
+}
+
+static bool compileAll(const RuleSpec* s, int count, RuleTable &t, String &err) {
+    memset(&t, 0, sizeof(t));
+    if (count > MAX_RULES) {
+        err = "max " + String(MAX_RULES) + " rules";
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        if (!compileRule(s[i], i, t, err)) return false;
+        if (!s[i].skip && s[i].durationSec == 0 && s[i].volumeDl == 0) {
+            err = "rule " + String(i + 1) + ": dur or vol missing";
+            return false;
+        }
+        if (s[i].zones >> VALVE_ZONES) {
+            err = "rule " + String(i + 1) + ": only " + String(VALVE_ZONES) + " zones";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool rulesValidate(const RuleSpec* s, int count, String &err) {
+    RuleTable t;
+    return compileAll(s, count, t, err);
+}
+
+// === JSON IMPORT ===
+// Flaches Array aus Objekten mit String-, Zahl- und bool-Werten
+static void skipWs(const char* &p) { while (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t') p++; }
+
+static bool readString(const char* &p, String &out) {
+    if (*p != '"') return false;
+    p++;
+    out = "";
+    while (*p && *p != '"') {
+        if (*p == '\\' && p[1]) p++;
+        out += *p++;
+    }
+    if (*p != '"') return false;
+    p++;
+    return true;
+}
+
+int rulesParseJson(const String &json, RuleSpec* out, int maxRules, String &err) {
+    const char* p = json.c_str();
+    int count = 0;
+    skipWs(p);
+    if (*p++ != '[') { err = "expected ["; return -1; }
+    skipWs(p);
+    if (*p == ']') return 0;
+
+    for (;;) {
+        skipWs(p);
+        if (*p++ != '{') { err = "expected {"; return -1; }
+        if (count >= maxRules) { err = "max " + String(maxRules) + " rules"; return -1; }
+        RuleSpec &r = out[count];
+        memset(&r, 0, sizeof(r));
+        r.enabled = true;
+
+        skipWs(p);
+        while (*p != '}') {
+            String key, sval;
+            if (!readString(p, key)) { err = "expected key"; return -1; }
+            skipWs(p);
+            if (*p++ != ':') { err = "expected :"; return -1; }
+            skipWs(p);
+            double num = 0;
+            bool isStr = (*p == '"');
+            if (isStr) {
+                if (!readString(p, sval)) { err = "bad string"; return -1; }
+            } else if (strncmp(p, "true", 4) == 0) {
+                num = 1; p += 4;
+            } else if (strncmp(p, "false", 5) == 0) {
+                num = 0; p += 5;
+            } else {
+                char* end;
+                num = strtod(p, &end);
+                if (end == p) { err = "bad value for " + key; return -1; }
+                p = end;
+            }
+
+            if (key == "cron") {
+                if (sval.length() >= sizeof(r.cron)) { err = "cron too long"; return -1; }
+                strncpy(r.cron, sval.c_str(), sizeof(r.cron) - 1);
+            } else if (key == "dur") {
+                r.durationSec = (num < 0) ? 0 : (num > 3600 ? 3600 : num);
+            } else if (key == "vol") {
+                r.volumeDl = (num < 0) ? 0 : (num > 6000 ? 60000 : lround(num * 10));
+            } else if (key == "prio") {
+                r.priority = (num < 0) ? 0 : (num > 255 ? 255 : num);
+            } else if (key == "zones") {
+                r.zones = (num < 0 || num > 255) ? 255 : num;
+            } else if (key == "en") {
+                r.enabled = num != 0;
+            } else if (key == "skip") {
+                r.skip = num != 0;
+            } else if (key == "every") {
+                r.everyDays = (num < 0) ? 0 : num;
+            } else if (key == "from" || key == "to") {
+                int32_t d;
+                if (sval.length() > 0 && !parseDate(sval, d)) { err = "bad date " + sval; return -1; }
+                if (sval.length() > 0) (key == "from" ? r.fromDay : r.toDay) = d;
+            }
+            skipWs(p);
+            if (*p == ',') { p++; skipWs(p); }
+        }
+        p++;
+        if (r.everyDays > 1 && r.fromDay == 0) { err = "rule " + String(count + 1) + ": every needs from"; return -1; }
+        count++;
+
+        skipWs(p);
+        if (*p == ',') { p++; continue; }
+        if (*p == ']') return count;
+        err = "expected , or ]";
+        return -1;
+    }
+}
+
+// === EXPORT ===
+String rulesExportJson() {
+    RuleSpec copy[MAX_RULES];
+    int n;
+    portENTER_CRITICAL(&specMux);
+    n = specCount;
+    memcpy(copy, specs, n * sizeof(RuleSpec));
+    portEXIT_CRITICAL(&specMux);
+
+    String j = "[";
+    for (int i = 0; i < n; i++) {
+        const RuleSpec &r = copy[i];
+        if (i > 0) j += ",";
+        j += "{\"cron\":\"" + String(r.cron) + "\",\"dur\":" + String(r.durationSec);
+        j += ",\"en\":" + String(r.enabled ? 1 : 0);
+        if (r.zones > 1) j += ",\"zones\":" + String(r.zones);
+        if (r.volumeDl) j += ",\"vol\":" + String(r.volumeDl / 10.0f, 1);
+        if (r.priority) j += ",\"prio\":" + String(r.priority);
+        if (r.skip) j += ",\"skip\":1";
+        if (r.fromDay) j += ",\"from\":\"" + formatDate(r.fromDay) + "\"";
+        if (r.toDay) j += ",\"to\":\"" + formatDate(r.toDay) + "\"";
+        if (r.everyDays > 1) j += ",\"every\":" + String(r.everyDays);
+        j += "}";
+    }
+    j += "]";
+    return j;
+}
+
+int rulesGetCount() { return specCount; }
+
+// === HAUPT-LOOP ===
+void rulesSet(const RuleSpec* s, int count) {
+    String err;
+    RuleTable t;
+    if (!compileAll(s, count, t, err)) {
+        logWarn("Rules rejected: " + err);
+        return;
+    }
+    portENTER_CRITICAL(&specMux);
+    memcpy(specs, s, count * sizeof(RuleSpec));
+    specCount = count;
+    portEXIT_CRITICAL(&specMux);
+    table = t;
+    cachedDay = -1;
+    version++;
+
+    HalNvs p;
+    p.begin("irr-rules", false);
+    p.putUChar("n", count);
+    p.putBytes("specs", specs, count * sizeof(RuleSpec));
+    p.end();
+    logInfo("Saved " + String(count) + " rules");
+}
+
+uint32_t rulesGetVersion() { return version; }
+
+void rulesInit() {
+    HalNvs p;
+    p.begin("irr-rules", true);
+    int n = p.getUChar("n", 0);
+    size_t len = (n > 0 && n <= MAX_RULES) ? p.getBytes("specs", specs, n * sizeof(RuleSpec)) : 0;
+    p.end();
+
+    String err;
+    if (len != n * sizeof(RuleSpec) || !compileAll(specs, n, table, err)) {
+        if (n > 0) logWarn("Stored rules invalid, ignored " + err);
+        specCount = 0;
+        memset(&table, 0, sizeof(table));
+        return;
+    }
+    specCount = n;
+    if (n > 0) logInfo("Loaded " + String(n) + " rules");
+}
+
+// Datumsbereich und "every" gelten für ganze Tage -> einmal pro Tag rechnen
+static uint32_t dayMask(int32_t day) {
+    uint32_t m = 0;
+    for (int i = 0; i < specCount; i++) {
+        const RuleSpec &r = specs[i];
+        if (r.fromDay && day < r.fromDay) continue;
+        if (r.toDay && day > r.toDay) continue;
+        if (r.everyDays > 1 && (day - r.fromDay) % r.everyDays != 0) continue;
+        m |= 1UL << i;
+    }
+    return m;
+}
+
+uint32_t rulesMatchMinute(time_t minuteEpoch) {
+    if (specCount == 0) return 0;
+    struct tm t;
+    clockLocal(minuteEpoch, t);
+
+    int32_t day = daysFromCivil(t.tm_year + 1900, t.tm_mon + 1, t.tm_mday);
+    if (day != cachedDay) {
+        cachedDayMask = dayMask(day);
+        cachedDay = day;
+    }
+
+    uint32_t dom = table.dom[t.tm_mday];
+    uint32_t dow = table.dow[t.tm_wday];
+    uint32_t dayHit = (dom & dow & ~table.domDowOr) | ((dom | dow) & table.domDowOr);
+    uint32_t hit = table.minute[t.tm_min] & table.hour[t.tm_hour] & table.month[t.tm_mon + 1]
+                 & dayHit & cachedDayMask & table.enabled;
+
+    if (hit & table.skip) return 0;
+    return hit;
+}
+
+uint8_t rulesGetPriority(int rule) {
+    if (rule < 0 || rule >= specCount || specs[rule].priority == 0) return IRR_PRIO_SCHEDULE;
+    return specs[rule].priority;
+}
+
+float rulesGetVolumeL(int rule) {
+    if (rule < 0 || rule >= specCount) return 0.0f;
+    return specs[rule].volumeDl / 10.0f;
+}
+
+uint8_t rulesGetZones(int rule) {
+    if (rule < 0 || rule >= specCount) return 0;
+    return specs[rule].zones;
+}
+
+int rulesGetDuration(int rule) {
+    if (rule < 0 || rule >= specCount) return 0;
+    return specs[rule].durationSec;
+}
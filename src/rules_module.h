@@ -0,0 +1,52 @@
+#pragma once
+#include <Arduino.h>
+
+// Zeitplan-Regeln im Cron-Stil, zusätzlich zu den festen Slots.
+//
+//   "cron": "min std tag monat wochentag"   z.B. "0 6-18/2 * 4-10 *"
+//           je Feld: *  */n  a  a-b  a-b/n  Listen mit ','; Wochentag 0-7 (0,7 = So)
+//   "dur":  Laufzeit in s (je Zone)
+//   "vol":  Zielmenge in L je Zone (optional, "dur" ist dann Obergrenze)
+//   "zones": Bitmaske der Zonen, Bit 0 = Zone 1 (optional, Standard Zone 1)
+//   "prio": Priorität in der Warteschlange, höher = früher (optional)
+//   "from"/"to": "YYYY-MM-DD" Datumsbereich (optional)
+//   "every": nur jeden n-ten Tag ab "from" (optional)
+//   "skip": 1 = Ausnahme - unterdrückt alle Regeln in den passenden Minuten
+//
+// Beim Speichern wird jede Regel in Bitmasken übersetzt und transponiert
+// (pro Minuten-/Stunden-/Tag-/Monatswert eine Maske aller Regeln). Der
+// Abgleich einer Minute kostet damit eine feste Zahl AND-Operationen,
+// unabhängig von der Anzahl der Regeln.
+
+#define MAX_RULES 32
+
+struct RuleSpec {
+    char     cron[48];
+    uint16_t durationSec;
+    uint8_t  zones;         // 0 = Zone 1
+    uint8_t  priority;      // 0 = IRR_PRIO_SCHEDULE
+    int32_t  fromDay;       // Tage seit 1970-01-01, 0 = offen
+    int32_t  toDay;
+    uint16_t everyDays;     // 0/1 = jeden Tag
+    bool     enabled;
+    bool     skip;
+    uint16_t volumeDl;      // 0.1 L, 0 = nach Zeit
+};
+
+// Parser/Compiler ohne Seiteneffekte (auch aus dem Web-Task)
+int  rulesParseJson(const String &json, RuleSpec* out, int maxRules, String &err);
+bool rulesValidate(const RuleSpec* specs, int count, String &err);
+
+// Nur aus dem Haupt-Loop
+void rulesInit();
+void rulesSet(const RuleSpec* specs, int count);   // übernehmen + Flash
+uint32_t rulesGetVersion();                         // steigt bei jedem rulesSet(), nicht beim Laden
+uint32_t rulesMatchMinute(time_t minuteEpoch);      // Bit i = Regel i fällig, 0 = keine
+int  rulesGetDuration(int rule);
+uint8_t rulesGetZones(int rule);
+float   rulesGetVolumeL(int rule);
+uint8_t rulesGetPriority(int rule);
+
+// Export aus beliebigem Task
+String rulesExportJson();
+int    rulesGetCount();
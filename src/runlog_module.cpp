@@ -0,0 +1,327 @@
+#include "runlog_module.h"
+#include "config.h"
+#include "clock_module.h"
+#include "hal.h"
+#include "logger.h"
+#include "flow_module.h"
+#include "valve_module.h"
+#include "settings_module.h"
+#include "mqtt_module.h"
+
+static const uint32_t ACTIVE_MAGIC = 0x524C4731;   // "RLG1"
+static const uint32_t EMPTY_ID = 0xFFFFFFFF;
+static const uint32_t PER_SECTOR = HAL_FLASH_SECTOR / sizeof(RunRecord);
+
+// Offener Lauf: übersteht Reset/Panic im RTC-RAM
+struct ActiveRun {
+    uint32_t  magic;
+    RunRecord rec;
+    bool      program;
+};
+
+RTC_DATA_ATTR static ActiveRun act;
+static unsigned long actStartMs = 0;
+static unsigned long actLastMs = 0;
+static uint32_t actOpenMs = 0;
+static uint32_t actP0 = 0;
+
+static RunSource noteSource = RunSource::OTHER;
+static RunStop noteStop = RunStop::NONE;
+
+// Ring: Index des nächsten Datensatzes, Sektoren = Partition / 4 KB
+static uint32_t sectors = 0;
+static volatile uint32_t writeIdx = 0;
+static volatile uint32_t stored = 0;
+static volatile uint32_t lastId = 0;
+
+static uint16_t recordCheck(const RunRecord &r) {
+    const uint8_t* p = (const uint8_t*)&r;
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < offsetof(RunRecord, check); i++) h = (h ^ p[i]) * 16777619u;
+    return (uint16_t)(h ^ (h >> 16));
+}
+
+static bool readRecord(uint32_t idx, RunRecord &r) {
+    return halFlashRead(idx * sizeof(RunRecord), &r, sizeof(r));
+}
+
+static bool recordValid(const RunRecord &r) {
+    return r.id != EMPTY_ID && r.check == recordCheck(r);
+}
+
+static float pulsesPerLiter() {
+    float k = settingsGetFlowFactor();
+    return k <= 0.1f ? 450.0f : k;
+}
+
+static uint8_t openMask() {
+    uint8_t m = 0;
+    for (int z = 0; z < VALVE_ZONES; z++) if (valveZoneIsOpen(z)) m |= 1 << z;
+    return m;
+}
+
+static time_t validNow() {
+    time_t now = clockNow();
+    return now > 1577836800 ? now : 0;
+}
+
+// Erste gültige id im Sektor (0 = leer), nur für die Suche beim Start
+static uint32_t sectorFirstId(uint32_t s) {
+    RunRecord r;
+    for (uint32_t i = 0; i < PER_SECTOR; i++) {
+        if (!readRecord(s * PER_SECTOR + i, r) || r.id == EMPTY_ID) return 0;
+        if (recordValid(r)) return r.id;
+    }
+    return 0;
+}
+
+static void ringScan() {
+    sectors = halFlashSize() / HAL_FLASH_SECTOR;
+    writeIdx = stored = lastId = 0;
+    if (sectors < 2) {
+        sectors = 0;
+        logError("Run log: no data partition");
+        return;
+    }
+    uint32_t head = 0, headId = 0, used = 0;
+    for (uint32_t s = 0; s < sectors; s++) {
+        uint32_t id = sectorFirstId(s);
+        if (id == 0) continue;
+        used++;
+        if (id > headId) {
+            headId = id;
+            head = s;
+        }
+    }
+    if (used == 0) return;
+
+    // Im neuesten Sektor bis zum ersten leeren Platz (abgerissene Datensätze überspringen)
+    uint32_t i = 0;
+    RunRecord r;
+    for (; i < PER_SECTOR; i++) {
+        if (!readRecord(head * PER_SECTOR + i, r) || r.id == EMPTY_ID) break;
+        if (recordValid(r) && r.id > lastId) lastId = r.id;
+    }
+    writeIdx = (head * PER_SECTOR + i) % (sectors * PER_SECTOR);
+    stored = min((used - 1) * PER_SECTOR + i, runlogCapacity());
+}
+
+static void ringAppend(RunRecord &r) {
+    if (sectors == 0) return;
+    uint32_t idx = writeIdx;
+    if (idx % PER_SECTOR == 0) {
+        // neuer Sektor: löschen, dabei fällt beim Überlauf der älteste weg
+        halFlashEraseSector(idx * sizeof(RunRecord));
+        if (stored > (sectors - 1) * PER_SECTOR) stored = (sectors - 1) * PER_SECTOR;
+    }
+    r.id = lastId + 1;
+    r.reserved = 0xFFFF;
+    r.check = recordCheck(r);
+    if (!halFlashWrite(idx * sizeof(RunRecord), &r, sizeof(r))) {
+        logError("Run log: flash write failed");
+    }
+    lastId = r.id;
+    stored = stored + 1;
+    writeIdx = (idx + 1) % (sectors * PER_SECTOR);
+}
+
+// === LAUFENDER LAUF ===
+static void actUpdate(unsigned long now) {
+    RunRecord &r = act.rec;
+    if (valveOpenCount() > 0) actOpenMs += now - actLastMs;
+    actLastMs = now;
+    r.zones |= openMask();
+    r.durationS = (now - actStartMs) / 1000UL;
+    r.liters = (flowGetIsrPulses() - actP0) / pulsesPerLiter();
+    float lpm = flowGetLpm();
+    if (lpm * 100.0f > r.peakCpm) r.peakCpm = (uint16_t)min(lpm * 100.0f, 65535.0f);
+    if (actOpenMs > 0) r.avgCpm = (uint16_t)min(r.liters * 6000000.0f / actOpenMs, 65535.0f);
+    r.endEpoch = validNow();
+}
+
+static void actBegin(RunSource src, uint8_t number, uint8_t zones, bool program) {
+    unsigned long now = clockMillis();
+    memset(&act, 0, sizeof(act));
+    act.rec.source = src;
+    act.rec.number = number;
+    act.rec.zones = zones;
+    act.rec.startEpoch = validNow();
+    act.program = program;
+    actStartMs = actLastMs = now;
+    actOpenMs = 0;
+    actP0 = flowGetIsrPulses();
+    act.magic = ACTIVE_MAGIC;
+}
+
+static void actEnd(RunStop stop) {
+    if (act.magic != ACTIVE_MAGIC) return;
+    actUpdate(clockMillis());
+    act.magic = 0;
+    RunRecord r = act.rec;
+    r.stop = noteStop != RunStop::NONE ? noteStop : stop;
+    noteStop = RunStop::NONE;
+    ringAppend(r);
+    logInfo("Run #" + String(r.id) + " logged: " + String(r.liters, 1) + " L, " + String(r.durationS) +
+            " s, " + runSourceName(r.source) + " / " + runStopName(r.stop));
+}
+
+void runlogInit() {
+    ringScan();
+    if (act.magic == ACTIVE_MAGIC) {
+        // vor dem Reset offen: mit dem letzten Stand aus dem RTC-RAM ablegen
+        act.magic = 0;
+        RunRecord r = act.rec;
+        r.stop = RunStop::REBOOT;
+        ringAppend(r);
+        logWarn("Run #" + String(r.id) + " interrupted by reset (" + String(r.liters, 1) + " L)");
+    }
+    act.magic = 0;
+    if (sectors) {
+        logInfo("Run log: " + String(stored) + "/" + String(runlogCapacity()) + " runs, last #" + String(lastId));
+    }
+}
+
+void runlogLoop() {
+    unsigned long now = clockMillis();
+    bool open = valveOpenCount() > 0;
+    if (act.magic != ACTIVE_MAGIC) {
+        if (open) {
+            actBegin(noteSource, 0, openMask(), false);     // manuell geöffnet
+            noteSource = RunSource::OTHER;
+        }
+        return;
+    }
+    actUpdate(now);
+    if (!act.program && !open) actEnd(RunStop::CLOSED);
+}
+
+void runlogProgramStart(RunSource src, uint8_t number, uint8_t zones) {
+    if (act.magic == ACTIVE_MAGIC) actEnd(RunStop::CLOSED);   // abgelöst
+    if (src == RunSource::OTHER) {
+        src = noteSource;           // Lauf ohne Slot: Auslöser aus dem Kommando
+        noteSource = RunSource::OTHER;
+    }
+    actBegin(src, number, zones, true);
+}
+
+void runlogProgramEnd(RunStop stop) {
+    if (act.magic == ACTIVE_MAGIC && act.program) actEnd(stop);
+}
+
+void runlogNoteSource(RunSource src) { noteSource = src; }
+
+void runlogNoteStop(RunStop stop) {
+    // nur für einen offenen Lauf, sonst erbt ihn der nächste
+    if (act.magic == ACTIVE_MAGIC || valveOpenCount() > 0) noteStop = stop;
+}
+
+// === ABFRAGE ===
+int runlogQuery(uint32_t since, uint32_t afterId, int limit, RunlogVisitor fn, void* ctx, bool &more) {
+    more = false;
+    if (sectors == 0 || stored == 0 || limit <= 0) return 0;
+    uint32_t total = sectors * PER_SECTOR;
+    uint32_t last = (writeIdx + total - 1) % total;    // zuletzt geschrieben
+    uint32_t lastSector = last / PER_SECTOR;
+    int n = 0;
+    RunRecord r;
+    for (uint32_t k = 1; k <= sectors; k++) {
+        uint32_t s = (lastSector + k) % sectors;     // ältester zuerst
+        uint32_t end = s == lastSector ? last % PER_SECTOR : PER_SECTOR - 1;
+        // ganzen Sektor überspringen, wenn schon sein letzter Lauf zu alt ist
+        if (!readRecord(s * PER_SECTOR + end, r) || r.id == EMPTY_ID) continue;
+        if (recordValid(r) && (r.id <= afterId || (since && r.startEpoch && r.startEpoch < since))) continue;
+        for (uint32_t i = 0; i <= end; i++) {
+            if (!readRecord(s * PER_SECTOR + i, r) || r.id == EMPTY_ID) break;
+            if (!recordValid(r) || r.id <= afterId || (since && r.startEpoch < since)) continue;
+            if (n >= limit) {
+                more = true;
+                return n;
+            }
+            fn(r, ctx);
+            n++;
+        }
+    }
+    return n;
+}
+
+String runlogRecordJson(const RunRecord &r) {
+    String j = "{\"id\":" + String(r.id);
+    j += ",\"start\":" + String(r.startEpoch);
+    j += ",\"end\":" + String(r.endEpoch);
+    j += ",\"dur\":" + String(r.durationS);
+    j += ",\"src\":\"" + String(runSourceName(r.source)) + "\"";
+    j += ",\"n\":" + String(r.number);
+    j += ",\"zones\":" + String(r.zones);
+    j += ",\"l\":" + String(r.liters, 2);
+    j += ",\"peak\":" + String(r.peakCpm / 100.0f, 2);
+    j += ",\"avg\":" + String(r.avgCpm / 100.0f, 2);
+    j += ",\"stop\":\"" + String(runStopName(r.stop)) + "\"}";
+    return j;
+}
+
+struct MqttPage {
+    String head;        // {"req":"..",
+    String body;
+    uint32_t lastId;
+};
+
+static void mqttPageFlush(MqttPage &p) {
+    if (p.body.length() == 0) return;
+    String msg = p.head + "\"runs\":[" + p.body + "]}";
+    mqttPublish(TOPIC_RUNS, msg.c_str());
+    p.body = "";
+}
+
+static void mqttPageAdd(const RunRecord &r, void* ctx) {
+    MqttPage &p = *(MqttPage*)ctx;
+    String j = runlogRecordJson(r);
+    if (p.head.length() + p.body.length() + j.length() + 12 > RUNLOG_MQTT_MSG_BYTES) mqttPageFlush(p);
+    if (p.body.length() > 0) p.body += ",";
+    p.body += j;
+    p.lastId = r.id;
+}
+
+void runlogPublish(const String &reqId, uint32_t since, uint32_t afterId, int limit) {
+    if (limit <= 0 || limit > RUNLOG_MQTT_MAX) limit = RUNLOG_MQTT_MAX;
+    MqttPage p;
+    p.head = "{\"req\":\"" + reqId + "\",";
+    p.lastId = afterId;
+    bool more;
+    int n = runlogQuery(since, afterId, limit, mqttPageAdd, &p, more);
+    mqttPageFlush(p);
+    // Abschluss: Fortsetzung mit "after":next
+    String done = p.head + "\"done\":true,\"count\":" + String(n) + ",\"more\":" + String(more ? "true" : "false");
+    done += ",\"next\":" + String(p.lastId) + ",\"stored\":" + String(stored) + "}";
+    mqttPublish(TOPIC_RUNS, done.c_str());
+}
+
+uint32_t runlogStored() { return stored; }
+// Höchstens gleichzeitig im Ring (alle Sektoren voll); der nächste Lauf löscht
+// den ältesten Sektor, danach sind es (sectors - 1) * PER_SECTOR + 1.
+uint32_t runlogCapacity() { return sectors * PER_SECTOR; }
+uint32_t runlogLastId() { return lastId; }
+
+const char* runSourceName(RunSource s) {
+    switch (s) {
+        case RunSource::SCHEDULE: return "slot";
+        case RunSource::RULE:     return "rule";
+        case RunSource::MQTT:     return "mqtt";
+        case RunSource::WEB:      return "web";
+        case RunSource::RESUME:   return "resume";
+        default:                  return "other";
+    }
+}
+
+const char* runStopName(RunStop s) {
+    switch (s) {
+        case RunStop::DONE:   return "done";
+        case RunStop::MQTT:   return "mqtt";
+        case RunStop::WEB:    return "web";
+        case RunStop::GUARD:  return "guard";
+        case RunStop::LIMIT:  return "limit";
+        case RunStop::OTA:    return "ota";
+        case RunStop::REBOOT: return "reboot";
+        case RunStop::CLOSED: return "closed";
+        default:              return "none";
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <Arduino.h>
+
+// Lauf-Protokoll: ein Datensatz (32 Byte) je Bewässerungslauf im Daten-Flash,
+// Ring über die ganze Partition (128 Läufe je 4-KB-Sektor, bei 128 KB ~4000
+// Läufe; beim Überlauf fällt der älteste Sektor weg).
+// Lauf = Programm-Lauf (irrigationStart bis Ende/Abbruch, alle Zonen und
+// Pausen) oder manuelles Öffnen, bis alle Zonen wieder zu sind. Der offene
+// Lauf steht im RTC-RAM; nach einem Reset wird er mit Grund "reboot" abgelegt.
+// Abfragen lesen Datensatz für Datensatz aus dem Flash (kein RAM-Puffer).
+
+enum class RunSource : uint8_t { OTHER, SCHEDULE, RULE, MQTT, WEB, RESUME };
+enum class RunStop : uint8_t { NONE, DONE, MQTT, WEB, GUARD, LIMIT, OTA, REBOOT, CLOSED };
+
+struct RunRecord {
+    uint32_t  id;           // fortlaufend ab 1, 0xFFFFFFFF = leer
+    uint32_t  startEpoch;   // 0 = ohne gültige Zeit
+    uint32_t  endEpoch;
+    uint32_t  durationS;    // Start bis Ende, auch ohne gültige Zeit
+    float     liters;
+    uint16_t  peakCpm;      // Spitze in 0,01 L/min
+    uint16_t  avgCpm;       // Menge / offene Zeit, 0,01 L/min
+    RunSource source;
+    uint8_t   number;       // Slot bzw. Regel (1..), 0 = keine
+    uint8_t   zones;        // Bit 0 = Zone 1
+    RunStop   stop;
+    uint16_t  reserved;
+    uint16_t  check;        // FNV-1a (gefaltet) über alles davor
+};
+static_assert(sizeof(RunRecord) == 32, "run record must stay 32 bytes (flash layout)");
+
+void runlogInit();
+void runlogLoop();
+
+// Programm-Läufe (aus irrigation_module)
+void runlogProgramStart(RunSource src, uint8_t number, uint8_t zones);
+void runlogProgramEnd(RunStop stop);
+// Hinweise der Auslöser: wer öffnet den nächsten Lauf ohne Slot, warum
+// schließt der laufende (gilt vor dem Standardgrund)
+void runlogNoteSource(RunSource src);
+void runlogNoteStop(RunStop stop);
+
+// Abfrage aus beliebigem Task: Start >= since (0 = alle) und id > afterId,
+// älteste zuerst, höchstens limit. more = es gibt weitere.
+typedef void (*RunlogVisitor)(const RunRecord &r, void* ctx);
+int runlogQuery(uint32_t since, uint32_t afterId, int limit, RunlogVisitor fn, void* ctx, bool &more);
+// {"id":12,"start":...,"end":...,"dur":600,"src":"slot","n":1,"zones":1,"l":12.3,"peak":12.5,"avg":12.3,"stop":"done"}
+String runlogRecordJson(const RunRecord &r);
+// MQTT-Antwort auf TOPIC_RUNS, in Stücken unter RUNLOG_MQTT_MSG_BYTES
+void runlogPublish(const String &reqId, uint32_t since, uint32_t afterId, int limit);
+
+uint32_t runlogStored();
+uint32_t runlogCapacity();
+uint32_t runlogLastId();
+const char* runSourceName(RunSource s);
+const char* runStopName(RunStop s);
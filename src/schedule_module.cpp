@@ -0,0 +1,85 @@
+#include "schedule_module.h"
+#include "clock_module.h"
+#include <algorithm>
+
+static ScheduleEntry heap[MAX_PROGRAM_SLOTS];
+static int heapSize = 0;
+
+// Zuletzt verbrauchter Termin je Slot: nach einem Zeitsprung rückwärts wird
+// nicht noch einmal derselbe Start eingeplant.
+static time_t lastDue[MAX_PROGRAM_SLOTS];
+
+// std::*_heap baut einen Max-Heap -> "größer" heißt hier "später fällig"
+static bool laterDue(const ScheduleEntry &a, const ScheduleEntry &b) {
+    return a.due > b.due;
+}
+
+// Startzeit des Slots am Tag 'base + d' (lokal). mktime mit tm_isdst = -1
+// rät bei der doppelten Stunde im Herbst abhängig vom vorigen Aufruf -
+// deshalb beide Deutungen rechnen: gültig ist, was als hh:mm zurückkommt,
+// bei zweien die frühere (sonst startet der Slot um 02:30 zweimal). Fehlt
+// die Uhrzeit (Frühjahr), gilt die Normalzeit-Deutung: 02:30 -> 03:30.
+static time_t slotTimeOnDay(const IrrigationSlot &slot, const struct tm &base, int d, int &wday) {
+    time_t best = 0;
+    for (int dst = 1; dst >= 0; dst--) {
+        struct tm t = {};
+        t.tm_year = base.tm_year;
+        t.tm_mon = base.tm_mon;
+        t.tm_mday = base.tm_mday + d;
+        t.tm_hour = slot.startHour;
+        t.tm_min = slot.startMinute;
+        t.tm_isdst = dst;
+        time_t cand = mktime(&t);      // normalisiert auch tm_wday
+        wday = t.tm_wday;
+        struct tm check;
+        bool valid = clockLocal(cand, check) && check.tm_hour == slot.startHour && check.tm_min == slot.startMinute;
+        if (valid && (best == 0 || cand < best)) best = cand;
+        if (dst == 0 && best == 0) best = cand;
+    }
+    return best;
+}
+
+time_t scheduleNextOccurrence(const IrrigationSlot &slot, time_t after) {
+    if ((slot.weekDays & 0x7F) == 0) return 0;
+
+    struct tm base;
+    clockLocal(after, base);
+
+    // Heute + 7 Tage reicht für jede Wochentag-Maske
+    for (int d = 0; d <= 7; d++) {
+        int wday;
+        time_t cand = slotTimeOnDay(slot, base, d, wday);
+        if (cand <= after) continue;
+        if ((slot.weekDays >> wday) & 1) return cand;
+    }
+    return 0;
+}
+
+void schedulePush(ScheduleEntry e) {
+    if (heapSize >= MAX_PROGRAM_SLOTS) return;
+    heap[heapSize++] = e;
+    std::push_heap(heap, heap + heapSize, laterDue);
+}
+
+void scheduleRebuild(const IrrigationSlot* slots, int count, time_t after) {
+    heapSize = 0;
+    for (int i = 0; i < count && i < MAX_PROGRAM_SLOTS; i++) {
+        if (!slots[i].enabled) continue;
+        time_t due = scheduleNextOccurrence(slots[i], std::max(after, lastDue[i]));
+        if (due != 0) schedulePush({ due, (uint8_t)i });
+    }
+}
+
+bool scheduleEmpty() { return heapSize == 0; }
+
+time_t scheduleGetLastDue(int slot) { return lastDue[slot]; }
+void scheduleSetLastDue(int slot, time_t due) { lastDue[slot] = due; }
+
+const ScheduleEntry &schedulePeek() { return heap[0]; }
+
+ScheduleEntry schedulePop() {
+    std::pop_heap(heap, heap + heapSize, laterDue);
+    ScheduleEntry e = heap[--heapSize];
+    lastDue[e.slot] = e.due;
+    return e;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <time.h>
+#include "irrigation_module.h"
+
+// Zeitplan als Min-Heap: pro aktivem Slot der nächste Startzeitpunkt (Epoch).
+// irrigationLoop() vergleicht nur noch time(NULL) mit der Heap-Spitze;
+// localtime/mktime laufen nur beim Neuaufbau und nach einem Start.
+
+struct ScheduleEntry {
+    time_t  due;
+    uint8_t slot;
+};
+
+// Erster Start von 'slot' echt nach 'after' (lokale Zeit). Sommerzeit: doppelte
+// Uhrzeit im Herbst zählt einmal (die erste), fehlende im Frühjahr eine Stunde später.
+// 0 = Slot ohne Wochentag.
+time_t scheduleNextOccurrence(const IrrigationSlot &slot, time_t after);
+
+// Heap komplett neu aus den Slots aufbauen (Boot, Slot-Änderung, Zeitsprung).
+// Bereits per schedulePop() verbrauchte Termine werden nicht erneut geplant.
+void scheduleRebuild(const IrrigationSlot* slots, int count, time_t after);
+
+bool scheduleEmpty();
+const ScheduleEntry &schedulePeek();          // nur wenn !scheduleEmpty()
+ScheduleEntry schedulePop();
+void schedulePush(ScheduleEntry e);
+
+// Verbrauchte Termine (für Persistenz über Reboots)
+time_t scheduleGetLastDue(int slot);
+void scheduleSetLastDue(int slot, time_t due);
@@ -0,0 +1,173 @@
+#include "sequencer_module.h"
+#include "config.h"
+#include "logger.h"
+#include "valve_module.h"
+
+struct ZoneRun {
+    uint8_t  zone;
+    uint16_t durationSec;
+};
+
+struct ActiveZone {
+    bool          on;
+    unsigned long startMs;
+    unsigned long durationMs;
+};
+
+static const int LANES = VALVE_MAX_OPEN < VALVE_ZONES ? VALVE_MAX_OPEN : VALVE_ZONES;
+static const uint32_t GAP_S = (VALVE_ZONE_GAP_MS + 999) / 1000;
+
+static ZoneRun queue[SEQ_QUEUE_LEN];
+static int qHead = 0;
+static int qCount = 0;
+
+static ActiveZone active[VALVE_ZONES];
+static unsigned long lastSwitchMs = 0;
+static bool switched = false;           // Pause erst nach dem ersten Schaltvorgang
+static unsigned long lastNowMs = 0;
+
+// === PLANUNG (Restzeit, Resume) ===
+// Jede "Lane" ist ein Platz für eine gleichzeitig offene Zone;
+// Wert = Sekunden ab jetzt, bis die Lane frei wird.
+struct Plan {
+    uint32_t lane[LANES];
+    bool     used[LANES];
+};
+
+static void planPlace(Plan &p, uint32_t durationSec, uint32_t &start, uint32_t &end) {
+    int best = 0;
+    for (int i = 1; i < LANES; i++) if (p.lane[i] < p.lane[best]) best = i;
+    start = p.lane[best] + (p.used[best] ? GAP_S : 0);
+    end = start + durationSec;
+    p.lane[best] = end;
+    p.used[best] = true;
+}
+
+void seqInit() {
+    qHead = qCount = 0;
+    memset(active, 0, sizeof(active));
+    switched = false;
+}
+
+bool seqEnqueue(uint8_t zone, uint16_t durationSec) {
+    if (zone >= VALVE_ZONES || durationSec == 0) return false;
+    if (qCount >= SEQ_QUEUE_LEN) {
+        logWarn("Zone queue full, zone " + String(zone + 1) + " dropped");
+        return false;
+    }
+    queue[(qHead + qCount) % SEQ_QUEUE_LEN] = { zone, durationSec };
+    qCount++;
+    return true;
+}
+
+int seqEnqueueProgram(uint16_t zoneMask, uint16_t durationSec, uint32_t skipSec) {
+    Plan p = {};
+    int n = 0;
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        if (!((zoneMask >> z) & 1)) continue;
+        uint32_t start, end;
+        planPlace(p, durationSec, start, end);
+        if (end <= skipSec) continue;                      // schon gelaufen
+        uint16_t d = (start < skipSec) ? end - skipSec : durationSec;
+        if (seqEnqueue(z, d)) n++;
+    }
+    return n;
+}
+
+void seqCancel() {
+    qCount = 0;
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        if (!active[z].on) continue;
+        active[z].on = false;
+        valveZoneSet(z, false);
+        lastSwitchMs = lastNowMs;
+        switched = true;
+    }
+}
+
+void seqFinishZone(uint8_t zone) {
+    if (zone >= VALVE_ZONES || !active[zone].on) return;
+    active[zone].on = false;
+    valveZoneSet(zone, false);
+    lastSwitchMs = lastNowMs;
+    switched = true;
+}
+
+bool seqIsBusy() {
+    if (qCount > 0) return true;
+    for (int z = 0; z < VALVE_ZONES; z++) if (active[z].on) return true;
+    return false;
+}
+
+static bool zoneOverLimit(int zone) {
+    return VALVE_ZONE_LIMIT_S > 0 && valveZoneGetDailyOpenMs(zone) >= VALVE_ZONE_LIMIT_S * 1000UL;
+}
+
+void seqLoop(unsigned long nowMs) {
+    lastNowMs = nowMs;
+
+    // 1. Laufende Zonen: Ablauf, Tageslimit, extern geschlossen (Failsafe, manuell)
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        ActiveZone &a = active[z];
+        if (!a.on) continue;
+        if (!valveZoneIsOpen(z)) {
+            a.on = false;
+            continue;
+        }
+        bool done = nowMs - a.startMs >= a.durationMs;
+        if (!done && zoneOverLimit(z)) {
+            logWarn("Zone " + String(z + 1) + " daily limit reached");
+            done = true;
+        }
+        if (done) {
+            a.on = false;
+            valveZoneSet(z, false);
+            lastSwitchMs = nowMs;
+            switched = true;
+        }
+    }
+
+    // 2. Nächste Zone: Budget frei und Pause eingehalten (ein Start pro Durchlauf)
+    if (qCount == 0) return;
+    if (valveOpenCount() >= LANES) return;
+    if (switched && nowMs - lastSwitchMs < VALVE_ZONE_GAP_MS) return;
+
+    ZoneRun r = queue[qHead];
+    if (valveZoneIsOpen(r.zone)) return;       // Zone noch (manuell) offen -> warten
+    qHead = (qHead + 1) % SEQ_QUEUE_LEN;
+    qCount--;
+
+    if (zoneOverLimit(r.zone)) {
+        logWarn("Zone " + String(r.zone + 1) + " skipped (daily limit)");
+        return;
+    }
+    if (!valveZoneSet(r.zone, true)) {
+        logWarn("Zone " + String(r.zone + 1) + " locked, queue cleared");
+        seqCancel();
+        return;
+    }
+    active[r.zone] = { true, nowMs, r.durationSec * 1000UL };
+    lastSwitchMs = nowMs;
+    switched = true;
+}
+
+uint32_t seqGetRemainingSec(unsigned long nowMs) {
+    Plan p = {};
+    int lane = 0;
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        if (!active[z].on) continue;
+        uint32_t elapsed = nowMs - active[z].startMs;
+        uint32_t rest = elapsed < active[z].durationMs ? (active[z].durationMs - elapsed + 999) / 1000 : 0;
+        int i = lane < LANES ? lane++ : 0;
+        if (rest > p.lane[i]) p.lane[i] = rest;
+        p.used[i] = true;
+    }
+    uint32_t total = 0;
+    for (int i = 0; i < LANES; i++) total = max(total, p.lane[i]);
+    for (int k = 0; k < qCount; k++) {
+        uint32_t start, end;
+        planPlace(p, queue[(qHead + k) % SEQ_QUEUE_LEN].durationSec, start, end);
+        total = max(total, end);
+    }
+    return total;
+}
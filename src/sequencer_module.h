@@ -0,0 +1,23 @@
+#pragma once
+#include <Arduino.h>
+
+// Zonen-Sequencer: Warteschlange von Zonen-Läufen.
+// Öffnet höchstens VALVE_MAX_OPEN Zonen gleichzeitig (auch manuell geöffnete
+// zählen mit), hält VALVE_ZONE_GAP_MS zwischen zwei Schaltvorgängen und
+// schließt eine Zone bei Ablauf oder bei VALVE_ZONE_LIMIT_S.
+// Die Zeit kommt als Parameter, damit die Logik ohne Hardware prüfbar ist.
+
+void seqInit();
+void seqLoop(unsigned long nowMs);
+
+bool seqEnqueue(uint8_t zone, uint16_t durationSec);
+
+// Zonen aus 'zoneMask' (Bit 0 = Zone 1) nacheinander einreihen. Die ersten
+// 'skipSec' des geplanten Ablaufs werden übersprungen (Resume nach Reboot).
+// Rückgabe: Anzahl eingereihter Läufe.
+int  seqEnqueueProgram(uint16_t zoneMask, uint16_t durationSec, uint32_t skipSec);
+
+void seqCancel();                       // Queue leeren, eigene Zonen schließen
+void seqFinishZone(uint8_t zone);       // Zone vorzeitig beenden (Menge erreicht)
+bool seqIsBusy();                       // Queue oder eigene Zone aktiv
+uint32_t seqGetRemainingSec(unsigned long nowMs);   // Schätzung inkl. Pausen
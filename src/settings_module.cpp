@@ -1,9 +1,9 @@
 #include "settings_module.h"
 #include "config.h"
+#include "hal.h"
 #include "logger.h"
-#include <Preferences.h>
 
-static Preferences prefs;
+static HalNvs prefs;
 
 // Lokale Variablen (Cache) mit Defaults
 static int dailyLimitSec = 900; // Default: 15 Minuten
@@ -11,6 +11,7 @@ static float batMin = 3.3;      // Default Batterie Min
 static float batFactor = 6.47;  // Default Bat Kalibrierung
 static float flowFactor = 450.0f; // NEU: Default Flow Faktor (Imp/L)
 static int rebootHour = -1;     // Default: Aus (-1)
+static int leakSens = LEAK_DEFAULT_SENS;
 
 // MQTT Variablen
 static String mqttHost = "192.168.1.10";
@@ -31,6 +32,7 @@ void settingsLoad() {
     flowFactor = prefs.getFloat("flow_k", 450.0f);
     
     rebootHour = prefs.getInt("reb_h", -1);
+    leakSens = prefs.getInt("leak_sens", LEAK_DEFAULT_SENS);
     mqttHost = prefs.getString("mqtt_host", "192.168.1.10");
     mqttPort = prefs.getInt("mqtt_port", 1883);
 
@@ -50,6 +52,7 @@ void settingsSave() {
     prefs.putFloat("flow_k", flowFactor);
     
     prefs.putInt("reb_h", rebootHour);
+    prefs.putInt("leak_sens", leakSens);
     prefs.putString("mqtt_host", mqttHost);
     prefs.putInt("mqtt_port", mqttPort);
 
@@ -89,6 +92,13 @@ void settingsSetFlowFactor(float f) {
     }
 }
 
+int settingsGetLeakSensitivity() { return leakSens; }
+void settingsSetLeakSensitivity(int s) {
+    if (s < 0) s = 0;
+    if (s > 10) s = 10;
+    if (s != leakSens) { leakSens = s; settingsSave(); }
+}
+
 String settingsGetMqttHost() { return mqttHost; }
 void settingsSetMqttHost(const String& host) {
     if (mqttHost != host) { mqttHost = host; settingsSave(); }
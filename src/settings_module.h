@@ -24,6 +24,10 @@ void settingsSetBatFactor(float f);
 float settingsGetFlowFactor();
 void settingsSetFlowFactor(float f);
 
+// Leck-Erkennung: 0 = aus, 1 (nur deutliche Lecks) .. 10 (feinste Tropfen)
+int settingsGetLeakSensitivity();
+void settingsSetLeakSensitivity(int s);
+
 // --- MQTT Konfiguration ---
 String settingsGetMqttHost();
 void settingsSetMqttHost(const String& host);
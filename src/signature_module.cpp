@@ -0,0 +1,234 @@
+#include "signature_module.h"
+#include "config.h"
+#include "clock_module.h"
+#include "hal.h"
+#include "logger.h"
+#include "flow_module.h"
+#include "valve_module.h"
+#include "settings_module.h"
+#include "mqtt_module.h"
+
+static const uint32_t SIG_MAGIC = 0x53494731;    // "SIG1"
+static const float LPM_FLOOR = 0.3f;              // kleinste Streuung L/min (Zähler-Auflösung)
+static const float LITERS_FLOOR = 1.0f;
+static const float REL_FLOOR = 0.05f;             // und mindestens 5 % vom Mittelwert
+static const float NO_SUPPLY_FRAC = 0.1f;         // < 10 % vom gelernten Plateau = kein Wasser
+
+enum SigKind : uint8_t { K_OK, K_NO_SUPPLY, K_LOW_FLOW, K_HIGH_FLOW, K_SLOW_RAMP, K_FAST_RAMP, K_LOW_VOLUME, K_HIGH_VOLUME };
+static const char* const KIND_NAMES[] = {
+    "ok", "no_supply", "low_flow", "high_flow", "slow_ramp", "fast_ramp", "low_volume", "high_volume"
+};
+
+struct SigBlob {
+    uint32_t      magic;
+    SlotSignature slot[MAX_PROGRAM_SLOTS];
+};
+
+enum class Stage : uint8_t { IDLE, WAIT_OPEN, RAMP, PLATEAU, EARLY_DONE, SKIPPED };
+
+struct RunTrack {
+    int8_t        slot;
+    Stage         stage;
+    unsigned long t0;
+    uint32_t      p0;           // Impulse beim Öffnen der ersten Zone
+    uint32_t      pRamp;
+    float         rampLpm;
+    float         lpm;
+    float         score;
+    SigKind       kind;
+    bool          scored;       // Signatur war gelernt, Score gültig
+};
+
+static SigBlob blob;
+static RunTrack run = { -1, Stage::IDLE, 0, 0, 0, 0, 0, 0, K_OK, false };
+static bool haveResult = false;     // letzter Lauf für valve_close
+
+static float pulsesPerLiter() {
+    float k = settingsGetFlowFactor();
+    return k <= 0.1f ? 450.0f : k;
+}
+
+static float lpmOver(uint32_t pulses, unsigned long ms) {
+    return ms ? pulses / pulsesPerLiter() * 60000.0f / ms : 0.0f;
+}
+
+static void sigSave() {
+    HalNvs p;
+    p.begin("flow-sig", false);
+    p.putBytes("sig", &blob, sizeof(blob));
+    p.end();
+}
+
+// EWMA, die ersten SIG_WINDOW Läufe als echter Mittelwert (n = bisher gelernt)
+static void statAdd(SigStat &s, uint16_t n, float x) {
+    if (n == 0) {
+        s.mean = x;
+        s.var = 0.0f;
+        return;
+    }
+    float a = 1.0f / min((int)n + 1, SIG_WINDOW);
+    float d = x - s.mean;
+    s.mean += a * d;
+    s.var = (1.0f - a) * (s.var + a * d * d);
+}
+
+// Vorzeichenbehaftet: negativ = weniger als gelernt
+static float zScore(const SigStat &s, float x, float absFloor) {
+    float sd = max(sqrtf(max(s.var, 0.0f)), max(REL_FLOOR * fabsf(s.mean), absFloor));
+    return (x - s.mean) / sd;
+}
+
+static void sigEarlyCheck() {
+    const SlotSignature &sig = blob.slot[run.slot];
+    run.stage = Stage::EARLY_DONE;
+    if (sig.runs < SIG_MIN_RUNS) {
+        logInfo("Flow signature slot " + String(run.slot + 1) + ": learning (" + String(sig.runs) + "/" + String(SIG_MIN_RUNS) + ")");
+        return;
+    }
+
+    float zRamp = zScore(sig.ramp, run.rampLpm, LPM_FLOOR);
+    float zLpm = zScore(sig.lpm, run.lpm, LPM_FLOOR);
+    run.scored = true;
+    run.score = max(fabsf(zRamp), fabsf(zLpm));
+    if (run.lpm < NO_SUPPLY_FRAC * sig.lpm.mean)  run.kind = K_NO_SUPPLY;    // Hauptventil zu, Pumpe aus
+    else if (zLpm <= -SIG_Z_ALARM)                run.kind = K_LOW_FLOW;     // Tropfer verstopft, Filter
+    else if (zLpm >= SIG_Z_ALARM)                 run.kind = K_HIGH_FLOW;    // Leitung ab/gebrochen
+    else if (zRamp <= -SIG_Z_ALARM)               run.kind = K_SLOW_RAMP;    // Druck baut sich schlecht auf
+    else if (zRamp >= SIG_Z_ALARM)                run.kind = K_FAST_RAMP;    // kein Gegendruck
+    else                                          run.kind = K_OK;
+    if (run.kind == K_OK) return;
+
+    logWarn("Flow anomaly slot " + String(run.slot + 1) + ": " + KIND_NAMES[run.kind] + " " + String(run.lpm, 2) +
+            " L/min (expected " + String(sig.lpm.mean, 2) + ", z " + String(run.score, 1) + ")");
+    String extra = "\"slot\":" + String(run.slot + 1);
+    extra += ",\"kind\":\"" + String(KIND_NAMES[run.kind]) + "\"";
+    extra += ",\"score\":" + String(run.score, 1);
+    extra += ",\"lpm\":" + String(run.lpm, 2);
+    extra += ",\"expected_lpm\":" + String(sig.lpm.mean, 2);
+    extra += ",\"ramp_lpm\":" + String(run.rampLpm, 2);
+    extra += ",\"expected_ramp\":" + String(sig.ramp.mean, 2);
+    mqttPublishEvent("flow_anomaly", extra);
+}
+
+void sigInit() {
+    HalNvs p;
+    p.begin("flow-sig", true);
+    size_t len = p.getBytes("sig", &blob, sizeof(blob));
+    p.end();
+    if (len != sizeof(blob) || blob.magic != SIG_MAGIC) {
+        memset(&blob, 0, sizeof(blob));
+        blob.magic = SIG_MAGIC;
+    } else {
+        int learned = 0;
+        for (int i = 0; i < MAX_PROGRAM_SLOTS; i++) if (blob.slot[i].runs >= SIG_MIN_RUNS) learned++;
+        logInfo("Flow signatures loaded: " + String(learned) + " slots learned");
+    }
+    run.slot = -1;
+    run.stage = Stage::IDLE;
+    haveResult = false;
+}
+
+void sigLoop() {
+    unsigned long now = clockMillis();
+    bool open = valveOpenCount() > 0;
+    switch (run.stage) {
+        case Stage::IDLE:
+            // Handbetrieb/Regel: Score des letzten Slot-Laufs gehört nicht dazu
+            if (open) haveResult = false;
+            break;
+        case Stage::WAIT_OPEN:
+            if (!open) break;
+            run.t0 = now;
+            run.p0 = flowGetIsrPulses();
+            run.stage = Stage::RAMP;
+            break;
+        case Stage::RAMP:
+        case Stage::PLATEAU:
+            if (!open) {
+                // erste Zone kürzer als SIG_EARLY_MS: nichts Vergleichbares
+                run.stage = Stage::SKIPPED;
+                break;
+            }
+            if (run.stage == Stage::RAMP && now - run.t0 >= SIG_RAMP_MS) {
+                run.pRamp = flowGetIsrPulses();
+                run.rampLpm = lpmOver(run.pRamp - run.p0, now - run.t0);
+                run.stage = Stage::PLATEAU;
+            } else if (run.stage == Stage::PLATEAU && now - run.t0 >= SIG_EARLY_MS) {
+                run.lpm = lpmOver(flowGetIsrPulses() - run.pRamp, now - run.t0 - SIG_RAMP_MS);
+                sigEarlyCheck();
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void sigRunStart(int slot) {
+    run = { -1, Stage::IDLE, 0, 0, 0, 0, 0, 0, K_OK, false };
+    haveResult = false;
+    if (slot < 0 || slot >= MAX_PROGRAM_SLOTS) return;
+    run.slot = slot;
+    run.stage = Stage::WAIT_OPEN;
+}
+
+void sigRunEnd(bool completed) {
+    if (run.slot < 0 || run.stage == Stage::IDLE) return;
+    bool early = run.stage == Stage::EARLY_DONE;
+    run.stage = Stage::IDLE;
+    haveResult = run.scored;
+    if (!early) return;                 // zu kurz oder nie geöffnet: nichts lernen
+
+    SlotSignature &sig = blob.slot[run.slot];
+    float liters = (flowGetIsrPulses() - run.p0) / pulsesPerLiter();
+    if (completed && sig.fullRuns >= SIG_MIN_RUNS) {
+        float zL = zScore(sig.liters, liters, LITERS_FLOOR);
+        run.score = max(run.score, fabsf(zL));
+        run.scored = haveResult = true;
+        if (run.kind == K_OK && fabsf(zL) >= SIG_Z_ALARM) {
+            run.kind = zL < 0 ? K_LOW_VOLUME : K_HIGH_VOLUME;
+            logWarn("Flow anomaly slot " + String(run.slot + 1) + ": " + KIND_NAMES[run.kind] + " " + String(liters, 1) +
+                    " L (expected " + String(sig.liters.mean, 1) + ")");
+        }
+    }
+
+    if (run.scored && run.kind != K_OK) {
+        sig.strikes = sig.strikeKind == run.kind ? sig.strikes + 1 : 1;
+        sig.strikeKind = run.kind;
+        if (sig.strikes < SIG_RELEARN) {
+            sigSave();
+            return;
+        }
+        // hartnäckig anders (neuer Tropfschlauch, anderer Druck): neu lernen
+        logInfo("Flow signature slot " + String(run.slot + 1) + ": relearning");
+        sig = {};
+    }
+    sig.strikes = sig.strikeKind = 0;
+    statAdd(sig.ramp, sig.runs, run.rampLpm);
+    statAdd(sig.lpm, sig.runs, run.lpm);
+    if (sig.runs < 0xFFFF) sig.runs++;
+    if (completed) {
+        statAdd(sig.liters, sig.fullRuns, liters);
+        if (sig.fullRuns < 0xFFFF) sig.fullRuns++;
+    }
+    sigSave();
+}
+
+bool sigGetScore(int &slot, float &score, const char* &kind) {
+    bool valid = run.slot >= 0 && (haveResult || (run.stage == Stage::EARLY_DONE && run.scored));
+    if (!valid) return false;
+    slot = run.slot;
+    score = run.score;
+    kind = KIND_NAMES[run.kind];
+    return true;
+}
+
+void sigGetSignatures(SlotSignature* out) {
+    memcpy(out, blob.slot, sizeof(blob.slot));
+}
+
+void sigResetSlot(int slot) {
+    if (slot < 0 || slot >= MAX_PROGRAM_SLOTS || blob.slot[slot].runs == 0) return;
+    blob.slot[slot] = {};
+    sigSave();
+    logInfo("Flow signature slot " + String(slot + 1) + " reset");
+}
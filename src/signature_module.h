@@ -0,0 +1,43 @@
+#pragma once
+#include <Arduino.h>
+#include "irrigation_module.h"
+
+// Durchfluss-Signatur je Zeitplan-Slot: ein Slot gießt immer dieselbe Zone,
+// der Verlauf ist also gut wiederholbar. Gelernt werden drei Merkmale als
+// gleitender Mittelwert + Varianz (EWMA über ~SIG_WINDOW Läufe, fester
+// Speicher je Slot, Flash):
+//   ramp   L/min in den ersten SIG_RAMP_MS nach dem Öffnen der ersten Zone
+//   lpm    L/min-Plateau von SIG_RAMP_MS bis SIG_EARLY_MS
+//   liters Gesamtmenge des Laufs (nur vollständige Läufe)
+// Nach SIG_EARLY_MS wird verglichen; Abweichung > SIG_Z_ALARM meldet Event
+// "flow_anomaly" (no_supply, low_flow, high_flow, slow_ramp, fast_ramp). Anomale Läufe
+// werden nicht gelernt, außer dieselbe Anomalie SIG_RELEARN Mal hintereinander
+// (neuer Normalzustand, z.B. anderer Tropfschlauch).
+
+struct SigStat {
+    float mean;
+    float var;
+};
+
+struct SlotSignature {
+    SigStat  ramp;
+    SigStat  lpm;
+    SigStat  liters;
+    uint16_t runs;          // gelernte Läufe (Plateau)
+    uint16_t fullRuns;      // davon vollständig (Menge)
+    uint8_t  strikes;       // gleiche Anomalie hintereinander
+    uint8_t  strikeKind;
+};
+
+void sigInit();
+void sigLoop();
+
+// Aus irrigationStart()/-Stop(): slot < 0 oder Regel = nicht verfolgt
+void sigRunStart(int slot);
+void sigRunEnd(bool completed);
+
+// Letzter/laufender Lauf: Abweichung in Standardabweichungen (max. über die
+// Merkmale). false = kein verfolgter Lauf oder Signatur noch nicht gelernt.
+bool sigGetScore(int &slot, float &score, const char* &kind);
+void sigGetSignatures(SlotSignature* out);   // MAX_PROGRAM_SLOTS Einträge
+void sigResetSlot(int slot);                 // Slot geändert: neu lernen
@@ -0,0 +1,228 @@
+#include "snapshot_module.h"
+#include "config.h"
+#include "clock_module.h"
+#include "hal.h"
+#include "logger.h"
+#include "flow_module.h"
+#include "battery_module.h"
+#include "wifi_module.h"
+#include "mqtt_module.h"
+#include "settings_module.h"
+#include "time_module.h"
+#include "watchdog_module.h"
+#include "ota_module.h"
+#include "history_module.h"
+#include <atomic>
+
+// Langsame Felder (Strings, Settings, Slots) nur jede Sekunde neu holen,
+// damit der Publish pro Loop-Durchlauf nicht allokiert.
+static const unsigned long SLOW_REFRESH_MS = 1000;
+
+// Double Buffer: der Schreiber füllt immer den Puffer, den gerade niemand
+// lesen soll, und schaltet dann 'published' um. Jeder Puffer hat zusätzlich
+// einen eigenen Sequenzzähler (ungerade = wird geschrieben), damit ein Leser,
+// der sehr lange kopiert, einen Überholvorgang erkennt und neu liest.
+static DeviceSnapshot buffers[2];
+static std::atomic<uint32_t> bufSeq[2];
+static std::atomic<uint32_t> published(0);
+
+static DeviceSnapshot work;       // nur im Haupt-Loop benutzt
+static unsigned long lastSlowMs = 0;
+
+static void copyStr(char* dst, size_t size, const String &src) {
+    strncpy(dst, src.c_str(), size - 1);
+    dst[size - 1] = '\0';
+}
+
+static void collectSlow() {
+    copyStr(work.ip, sizeof(work.ip), wifiGetIp());
+    work.rssi = wifiGetRssi();
+    work.mqttState = mqttGetStateCode();
+    work.mqttReconnectAgeMs = mqttGetLastReconnectMs();
+    work.heapFree = halFreeHeap();
+    work.histPoints = historyStored();
+    work.histBytes = historyBytes();
+    copyStr(work.lastDiag, sizeof(work.lastDiag), logGetLastDiag());
+
+    work.dailyLimitSec = settingsGetDailyLimitSec();
+    work.rebootHour = settingsGetRebootHour();
+    work.batMin = settingsGetBatMin();
+    work.batFactor = settingsGetBatFactor();
+    work.flowFactor = settingsGetFlowFactor();
+    work.leakSens = settingsGetLeakSensitivity();
+    work.flowRunOnL = flowGetRunOnL();
+    copyStr(work.mqttHost, sizeof(work.mqttHost), settingsGetMqttHost());
+    work.mqttPort = settingsGetMqttPort();
+
+    irrigationGetSlots(work.slots);
+    sigGetSignatures(work.sig);
+    work.activeSlots = 0;
+    for (int i = 0; i < MAX_PROGRAM_SLOTS; i++) if (work.slots[i].enabled) work.activeSlots++;
+    int nextSlot;
+    work.nextRunEpoch = irrigationGetNextRun(nextSlot);
+    work.nextRunSlot = nextSlot;
+}
+
+static void collectFast(unsigned long now) {
+    work.uptimeMs = now;
+    work.epoch = clockNow();
+    work.timeValid = timeIsValid();
+
+    work.valve = valveGetState();
+    work.mode = irrigationGetMode();
+    work.irrRunning = irrigationIsRunning();
+    work.remainingSec = irrigationGetRemainingSec();
+    irrigationGetVolume(work.runTargetL, work.runDeliveredL);
+    work.dailyOpenSec = valveGetDailyOpenSec();
+    work.zoneOpenMask = 0;
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        if (valveZoneIsOpen(z)) work.zoneOpenMask |= 1 << z;
+        work.zoneOpenSec[z] = valveZoneGetDailyOpenSec(z);
+        ValveLatency lo, lc;
+        valveZoneGetLatency(z, lo, lc);
+        work.zonePhase[z] = valveZoneGetPhase(z);
+        work.zoneOpenLatMs[z] = valveLatencyAvgMs(lo);
+        work.zoneCloseLatMs[z] = valveLatencyAvgMs(lc);
+    }
+
+    if (!guardGetTrip(work.guardTrip)) memset(&work.guardTrip, 0, sizeof(work.guardTrip));
+    work.guardReason = work.guardTrip.reason;
+    leakGetStatus(work.leak);
+
+    work.flowLpm = flowGetLpm();
+    work.flowTotalL = flowGetTotalLiters();
+    work.pulses = flowGetTotalPulses();
+    work.batV = batteryGetVoltage();
+    work.batRawV = batteryGetRawValue();
+
+    work.mqttConnected = mqttIsConnected();
+    work.mqttQueue = (uint16_t)min(historyPending(), (uint32_t)0xFFFF);
+    work.loopAvgUs = watchdogGetLoopAvgUs();
+    work.loopMaxUs = watchdogGetLoopMaxUs();
+    work.otaPct = otaGetProgressPct();
+    work.queueVersion = irrigationGetQueueVersion();
+    work.queueLen = irrigationGetQueue(work.queue);
+}
+
+void snapshotInit() {
+    memset(&work, 0, sizeof(work));
+    memset(buffers, 0, sizeof(buffers));
+    collectSlow();
+    lastSlowMs = clockMillis();
+    snapshotPublish();
+}
+
+void snapshotPublish() {
+    unsigned long now = clockMillis();
+    if (now - lastSlowMs >= SLOW_REFRESH_MS) {
+        collectSlow();
+        lastSlowMs = now;
+    }
+    collectFast(now);
+
+    uint32_t next = published.load(std::memory_order_relaxed) + 1;
+    work.seq = next;
+
+    int idx = next & 1;
+    bufSeq[idx].fetch_add(1, std::memory_order_relaxed);        // ungerade: in Arbeit
+    std::atomic_thread_fence(std::memory_order_release);
+    buffers[idx] = work;
+    bufSeq[idx].fetch_add(1, std::memory_order_release);        // gerade: fertig
+    published.store(next, std::memory_order_release);
+}
+
+void snapshotGet(DeviceSnapshot &out) {
+    for (;;) {
+        uint32_t p = published.load(std::memory_order_acquire);
+        int idx = p & 1;
+        uint32_t s1 = bufSeq[idx].load(std::memory_order_acquire);
+        if (s1 & 1) continue;
+        out = buffers[idx];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (bufSeq[idx].load(std::memory_order_relaxed) == s1) return;
+    }
+}
+
+uint32_t snapshotGetSeq() {
+    return published.load(std::memory_order_acquire);
+}
+
+String snapshotZonesJson(const DeviceSnapshot &s) {
+    String j = "[";
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        if (z > 0) j += ",";
+        j += "{\"z\":" + String(z + 1);
+        j += ",\"open\":" + String((s.zoneOpenMask >> z) & 1);
+        j += ",\"sec\":" + String(s.zoneOpenSec[z]);
+        j += ",\"phase\":\"" + String(valvePhaseName(s.zonePhase[z])) + "\"";
+        j += ",\"open_ms\":" + String(s.zoneOpenLatMs[z]);
+        j += ",\"close_ms\":" + String(s.zoneCloseLatMs[z]);
+        j += ",\"lim\":" + String(VALVE_ZONE_LIMIT_S) + "}";
+    }
+    j += "]";
+    return j;
+}
+
+String snapshotGuardJson(const DeviceSnapshot &s) {
+    const GuardTrip &t = s.guardTrip;
+    String j = "{\"alarm\":\"" + String(guardReasonName(s.guardReason)) + "\"";
+    if (s.guardReason != GuardReason::NONE) {
+        j += ",\"zones\":" + String(t.zones);
+        j += ",\"lpm\":" + String(t.lpm, 2);
+        j += ",\"max_lpm\":" + String(t.limitLpm, 2);
+        j += ",\"run_l\":" + String(t.runL, 2);
+        j += ",\"max_l\":" + String(t.limitL, 1);
+        j += ",\"elapsed_ms\":" + String(t.elapsedMs);
+        j += ",\"ts\":" + String(t.epoch);
+    }
+    j += "}";
+    return j;
+}
+
+String snapshotLeakJson(const DeviceSnapshot &s) {
+    const LeakStatus &l = s.leak;
+    String j = "{\"score\":" + String(l.score);
+    j += ",\"alarm\":" + String(l.alarm ? "true" : "false");
+    j += ",\"base_lpm\":" + String(l.baseLpm, 3);
+    j += ",\"hours\":" + String(l.hours);
+    j += ",\"wet_hours\":" + String(l.wetHours);
+    j += ",\"regularity\":" + String(l.regularityPct);
+    j += ",\"sens\":" + String(s.leakSens) + "}";
+    return j;
+}
+
+String snapshotSigJson(const DeviceSnapshot &s) {
+    String j = "[";
+    bool first = true;
+    for (int i = 0; i < MAX_PROGRAM_SLOTS; i++) {
+        const SlotSignature &g = s.sig[i];
+        if (g.runs == 0) continue;
+        if (!first) j += ",";
+        first = false;
+        j += "{\"slot\":" + String(i + 1) + ",\"runs\":" + String(g.runs);
+        j += ",\"lpm\":" + String(g.lpm.mean, 2) + ",\"lpm_sd\":" + String(sqrtf(g.lpm.var), 2);
+        j += ",\"ramp\":" + String(g.ramp.mean, 2) + ",\"ramp_sd\":" + String(sqrtf(g.ramp.var), 2);
+        j += ",\"liters\":" + String(g.liters.mean, 1) + ",\"liters_sd\":" + String(sqrtf(g.liters.var), 1);
+        j += ",\"strikes\":" + String(g.strikes) + "}";
+    }
+    j += "]";
+    return j;
+}
+
+String snapshotQueueJson(const DeviceSnapshot &s) {
+    String j = "[";
+    for (int i = 0; i < s.queueLen; i++) {
+        const QueuedRun &r = s.queue[i];
+        if (i > 0) j += ",";
+        const char* src = r.slot < 0 ? "manual" : (r.slot >= MAX_PROGRAM_SLOTS ? "rule" : "slot");
+        int n = r.slot < 0 ? 0 : (r.slot >= MAX_PROGRAM_SLOTS ? r.slot - MAX_PROGRAM_SLOTS + 1 : r.slot + 1);
+        j += "{\"src\":\"" + String(src) + "\",\"n\":" + String(n);
+        j += ",\"zones\":" + String(r.zones);
+        j += ",\"dur\":" + String(r.durationSec);
+        j += ",\"vol\":" + String(r.volumeDl / 10.0f, 1);
+        j += ",\"prio\":" + String(r.priority);
+        j += ",\"wait_s\":" + String((s.uptimeMs - r.queuedMs) / 1000) + "}";
+    }
+    j += "]";
+    return j;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <Arduino.h>
+#include "valve_module.h"
+#include "irrigation_module.h"
+#include "guard_module.h"
+#include "leak_module.h"
+#include "signature_module.h"
+#include "config.h"
+
+// Konsistenter Zustand aller Module, einmal pro loop()-Durchlauf erzeugt.
+// Einzige Datenquelle für alle Serializer (MQTT tele/hist, Web-API, SSE).
+// POD: darf per Zuweisung/memcpy kopiert werden.
+struct DeviceSnapshot {
+    uint32_t seq;           // fortlaufende Nummer, steigt bei jedem Publish
+    uint32_t uptimeMs;
+    time_t   epoch;
+    bool     timeValid;
+
+    ValveState     valve;
+    IrrigationMode mode;
+    bool     irrRunning;
+    int32_t  remainingSec;
+    float    runTargetL;     // Mengen-Lauf, 0 = nach Zeit
+    float    runDeliveredL;
+    uint32_t dailyOpenSec;
+    uint16_t zoneOpenMask;                  // Bit 0 = Zone 1
+    uint32_t zoneOpenSec[VALVE_ZONES];      // heute offen je Zone
+    ValvePhase zonePhase[VALVE_ZONES];      // beobachteter Zustand (Durchfluss)
+    uint16_t zoneOpenLatMs[VALVE_ZONES];    // Mittel Befehl -> erster Impuls
+    uint16_t zoneCloseLatMs[VALVE_ZONES];   // Mittel Befehl -> letzter Impuls
+
+    GuardReason guardReason;    // NONE = kein Alarm (verriegelt bis Quittierung)
+    GuardTrip   guardTrip;
+    LeakStatus  leak;
+
+    float    flowLpm;
+    float    flowTotalL;
+    uint32_t pulses;
+    float    batV;
+    float    batRawV;
+
+    char     ip[16];
+    int16_t  rssi;
+    bool     mqttConnected;
+    int16_t  mqttState;
+    uint32_t mqttReconnectAgeMs;
+    uint16_t mqttQueue;         // Verlauf noch nicht gesendet
+    uint32_t histPoints;        // Verlauf im RAM (history_module)
+    uint32_t histBytes;
+
+    uint32_t heapFree;
+    uint32_t loopAvgUs;
+    uint32_t loopMaxUs;
+    char     lastDiag[64];
+    int8_t   otaPct;         // -1 = kein Update aktiv
+
+    // Einstellungen
+    int32_t  dailyLimitSec;
+    int8_t   rebootHour;
+    float    batMin;
+    float    batFactor;
+    float    flowFactor;
+    int8_t   leakSens;
+    float    flowRunOnL;     // gelernter Nachlauf
+    char     mqttHost[64];
+    uint16_t mqttPort;
+
+    IrrigationSlot slots[MAX_PROGRAM_SLOTS];
+    SlotSignature  sig[MAX_PROGRAM_SLOTS];  // gelernte Durchfluss-Signatur
+    uint8_t  activeSlots;
+    time_t   nextRunEpoch;   // 0 = nichts geplant
+    int8_t   nextRunSlot;
+
+    uint8_t  queueLen;
+    uint32_t queueVersion;
+    QueuedRun queue[IRR_RUN_QUEUE_LEN];
+};
+
+void snapshotInit();
+void snapshotPublish();                  // nur aus loop(), einmal pro Durchlauf
+void snapshotGet(DeviceSnapshot &out);   // aus beliebigem Task, ohne Lock
+uint32_t snapshotGetSeq();
+
+// [{"z":1,"open":0,"sec":120,"lim":0},...] für Diag und MQTT
+String snapshotZonesJson(const DeviceSnapshot &s);
+// {"alarm":"burst","zones":1,"lpm":31.5,"max_lpm":25,"run_l":3.2,"max_l":400,"elapsed_ms":820,"ts":...}
+String snapshotGuardJson(const DeviceSnapshot &s);
+// {"score":80,"alarm":true,"base_lpm":0.052,"hours":12,"wet_hours":10,"regularity":95}
+String snapshotLeakJson(const DeviceSnapshot &s);
+// [{"slot":1,"runs":8,"lpm":12.1,"lpm_sd":0.2,"ramp":9.8,"ramp_sd":0.4,"liters":120.5,"liters_sd":1.1,"strikes":0},...]
+String snapshotSigJson(const DeviceSnapshot &s);
+// [{"src":"slot","n":2,"zones":1,"dur":600,"vol":0,"prio":1,"wait_s":30},...]
+String snapshotQueueJson(const DeviceSnapshot &s);
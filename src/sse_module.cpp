@@ -0,0 +1,182 @@
+#include "sse_module.h"
+#include "config.h"
+#include "clock_module.h"
+#include "logger.h"
+#include "snapshot_module.h"
+#include <lwip/sockets.h>
+
+static const unsigned long SSE_TICK_MS      = 500;    // max. 2 Hz
+static const unsigned long SSE_IDLE_MS      = 15000;  // Ventil zu, kein Flow
+static const unsigned long SSE_KEEPALIVE_MS = 30000;  // Kommentar-Frame, erkennt tote Clients
+static const size_t        SSE_FRAME_MAX    = 192;
+
+// Werte gerundet wie in der Anzeige -> Rauschen erzeugt keine Deltas
+struct SseValues {
+    int8_t valve;   // 0/1, -1 = noch nichts gesendet
+    long lpmC;      // L/min * 100
+    long totD;      // Liter * 10
+    long batC;      // Volt * 100
+    long rem;       // Restlaufzeit s
+    long used;      // Tagesnutzung s
+    int8_t ota;     // Update-Fortschritt %, -1 = keins
+    long dlvD;      // Mengen-Lauf: geliefert, Liter * 10
+    long tgtD;      // Mengen-Lauf: Ziel, Liter * 10 (0 = nach Zeit)
+};
+
+struct SseClient {
+    bool active;
+    WiFiClient client;
+    SseValues sent;
+    unsigned long lastSendMs;
+    char pending[SSE_FRAME_MAX];
+    uint16_t pendingLen;
+    uint16_t pendingPos;
+};
+
+static SseClient clients[SSE_MAX_CLIENTS];
+static unsigned long lastTickMs = 0;
+static unsigned long coalescedFrames = 0;
+
+static void sseDrop(SseClient &c) {
+    c.client.stop();
+    c.active = false;
+    c.pendingLen = c.pendingPos = 0;
+}
+
+// Nicht-blockierend schreiben: was der Socket-Puffer nicht aufnimmt, bleibt in
+// 'pending'. Solange dort Reste liegen, bekommt der Client keine neuen Frames
+// (Backpressure) - beim nächsten Frame wird gegen 'sent' verglichen, es geht
+// also nichts verloren, Zwischenstände werden nur zusammengefasst.
+static bool sseFlush(SseClient &c) {
+    while (c.pendingPos < c.pendingLen) {
+        ssize_t n = lwip_send(c.client.fd(), c.pending + c.pendingPos, c.pendingLen - c.pendingPos, MSG_DONTWAIT);
+        if (n > 0) {
+            c.pendingPos += n;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return false;
+        } else {
+            sseDrop(c);
+            return false;
+        }
+    }
+    c.pendingLen = c.pendingPos = 0;
+    return true;
+}
+
+static void sseQueue(SseClient &c, const char* data, size_t len) {
+    if (len >= SSE_FRAME_MAX) len = SSE_FRAME_MAX - 1;
+    memcpy(c.pending, data, len);
+    c.pendingLen = len;
+    c.pendingPos = 0;
+    sseFlush(c);
+}
+
+static SseValues sseReadValues(const DeviceSnapshot &snap) {
+    SseValues v;
+    v.valve = (snap.valve == ValveState::OPEN) ? 1 : 0;
+    v.lpmC = lroundf(snap.flowLpm * 100.0f);
+    v.totD = lroundf(snap.flowTotalL * 10.0f);
+    v.batC = lroundf(snap.batV * 100.0f);
+    v.rem = snap.remainingSec;
+    v.used = snap.dailyOpenSec;
+    v.ota = snap.otaPct;
+    v.dlvD = lroundf(snap.runDeliveredL * 10.0f);
+    v.tgtD = lroundf(snap.runTargetL * 10.0f);
+    return v;
+}
+
+// Baut "data:{...}\n\n" nur mit geänderten Feldern. Rückgabe 0 = keine Änderung.
+static size_t sseBuildDelta(const SseValues &cur, const SseValues &old, char* buf, size_t size) {
+    size_t n = snprintf(buf, size, "data:{");
+    size_t start = n;
+    #define SSE_FIELD(fmt, ...) n += snprintf(buf + n, size - n, "%s" fmt, (n > start) ? "," : "", __VA_ARGS__)
+    if (cur.valve != old.valve) SSE_FIELD("\"v\":%d", cur.valve);
+    if (cur.lpmC != old.lpmC)   SSE_FIELD("\"lpm\":%.2f", cur.lpmC / 100.0f);
+    if (cur.totD != old.totD)   SSE_FIELD("\"tot\":%.1f", cur.totD / 10.0f);
+    if (cur.batC != old.batC)   SSE_FIELD("\"bat\":%.2f", cur.batC / 100.0f);
+    if (cur.rem != old.rem)     SSE_FIELD("\"rem\":%ld", cur.rem);
+    if (cur.used != old.used)   SSE_FIELD("\"used\":%ld", cur.used);
+    if (cur.ota != old.ota)     SSE_FIELD("\"ota\":%d", cur.ota);
+    if (cur.tgtD != old.tgtD)   SSE_FIELD("\"tgt\":%.1f", cur.tgtD / 10.0f);
+    if (cur.dlvD != old.dlvD)   SSE_FIELD("\"dlv\":%.1f", cur.dlvD / 10.0f);
+    #undef SSE_FIELD
+    if (n == start) return 0;
+    n += snprintf(buf + n, size - n, "}\n\n");
+    return (n < size) ? n : size - 1;
+}
+
+bool sseAccept(const WiFiClient &client) {
+    int slot = -1;
+    for (int i = 0; i < SSE_MAX_CLIENTS; i++) {
+        if (clients[i].active && !clients[i].client.connected()) sseDrop(clients[i]);
+        if (!clients[i].active && slot < 0) slot = i;
+    }
+    if (slot < 0) return false;
+
+    SseClient &c = clients[slot];
+    c.active = true;
+    c.client = client;
+    c.client.setNoDelay(true);
+    c.sent.valve = -1;   // erster Frame enthält alle Felder
+    c.sent.ota = -2;
+    c.sent.tgtD = -1;
+    c.lastSendMs = 0;
+
+    static const char HEADER[] =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: text/event-stream\r\n"
+        "Cache-Control: no-cache\r\n"
+        "Connection: keep-alive\r\n\r\n"
+        "retry: 5000\n\n";
+    sseQueue(c, HEADER, sizeof(HEADER) - 1);
+    lastTickMs = 0;      // Snapshot sofort senden
+    logInfo("SSE client connected (" + String(sseGetClientCount()) + "/" + String(SSE_MAX_CLIENTS) + ")");
+    return true;
+}
+
+void sseLoop() {
+    unsigned long now = clockMillis();
+    if (now - lastTickMs < SSE_TICK_MS) return;
+    lastTickMs = now;
+
+    DeviceSnapshot snap;
+    snapshotGet(snap);
+    bool live = (snap.valve == ValveState::OPEN) || (snap.flowLpm > 0.0f) || (snap.otaPct >= 0);
+    unsigned long interval = live ? SSE_TICK_MS : SSE_IDLE_MS;
+    SseValues cur = sseReadValues(snap);
+
+    for (int i = 0; i < SSE_MAX_CLIENTS; i++) {
+        SseClient &c = clients[i];
+        if (!c.active) continue;
+        if (!c.client.connected()) { sseDrop(c); continue; }
+
+        // Backpressure: alter Frame hängt noch
+        if (c.pendingLen > 0 && !sseFlush(c)) {
+            if (c.active) coalescedFrames++;
+            continue;
+        }
+
+        bool valveChanged = (cur.valve != c.sent.valve);
+        if (!valveChanged && now - c.lastSendMs < interval) continue;
+
+        char frame[SSE_FRAME_MAX];
+        size_t len = sseBuildDelta(cur, c.sent, frame, sizeof(frame));
+        if (len == 0) {
+            if (now - c.lastSendMs < SSE_KEEPALIVE_MS) continue;
+            len = snprintf(frame, sizeof(frame), ":\n\n");
+        }
+        c.sent = cur;
+        c.lastSendMs = now;
+        sseQueue(c, frame, len);
+    }
+}
+
+int sseGetClientCount() {
+    int n = 0;
+    for (int i = 0; i < SSE_MAX_CLIENTS; i++) if (clients[i].active) n++;
+    return n;
+}
+
+unsigned long sseGetCoalescedCount() {
+    return coalescedFrames;
+}
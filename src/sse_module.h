@@ -0,0 +1,17 @@
+#pragma once
+#include <Arduino.h>
+#include <WiFi.h>
+
+// Server-Sent Events (/events): Live-Telemetrie für die Web-UI.
+// Gesendet werden nur Änderungen (Deltas) gegenüber dem, was der jeweilige
+// Browser zuletzt bekommen hat: max. 2 Hz bei offenem Ventil, sonst selten.
+
+#define SSE_MAX_CLIENTS 3
+
+// Übernimmt die Verbindung des aktuellen Requests. false = alle Plätze belegt.
+bool sseAccept(const WiFiClient &client);
+void sseLoop();
+int  sseGetClientCount();
+
+// Diagnose: Frames, die wegen langsamer Clients zusammengefasst wurden
+unsigned long sseGetCoalescedCount();
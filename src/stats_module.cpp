@@ -0,0 +1,208 @@
+#include "stats_module.h"
+#include "config.h"
+#include "clock_module.h"
+#include "hal.h"
+#include "logger.h"
+#include "flow_module.h"
+#include "valve_module.h"
+#include "settings_module.h"
+#include "runlog_module.h"
+#include "mqtt_module.h"
+
+static const uint32_t STATS_MAGIC = 0x53544131;   // "STA1"
+static const char* const PERIOD_NAMES[STATS_PERIODS] = { "day", "week", "month" };
+
+struct StatsState {
+    uint32_t magic;
+    StatsAgg cur[STATS_PERIODS];
+    StatsAgg prev[STATS_PERIODS];
+    uint32_t check;
+};
+
+RTC_DATA_ATTR static StatsState rtcState;
+static StatsState st;
+static unsigned long lastMs = 0;
+static unsigned long lastFlashMs = 0;
+static unsigned long lastRtcMs = 0;
+static unsigned long lastPublishMs = 0;
+static unsigned long lastPulses = 0;
+static uint32_t lastRunId = 0;
+static int lastMday = -1;
+static bool wasOpen = false;        // Zustand im Intervall seit dem letzten Durchlauf
+static bool dirty = true;           // seit dem letzten Publish geändert
+static bool flashDirty = false;     // seit dem letzten Flash-Checkpoint geändert
+static bool published = false;      // nach (Wieder-)Verbindung einmal senden
+
+static uint32_t statsCheck(const StatsState &s) {
+    // FNV-1a über alles außer 'check'
+    const uint8_t* p = (const uint8_t*)&s;
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < offsetof(StatsState, check); i++) h = (h ^ p[i]) * 16777619u;
+    return h;
+}
+
+static bool statsValid(const StatsState &s) {
+    return s.magic == STATS_MAGIC && s.check == statsCheck(s);
+}
+
+static void statsSave(bool toFlash) {
+    st.magic = STATS_MAGIC;
+    st.check = statsCheck(st);
+    rtcState = st;
+    lastRtcMs = clockMillis();
+    if (!toFlash) return;
+    HalNvs p;
+    p.begin("stats", false);
+    p.putBytes("agg", &st, sizeof(st));
+    p.end();
+    lastFlashMs = lastRtcMs;
+    flashDirty = false;
+}
+
+static void statsLoad() {
+    if (statsValid(rtcState)) {
+        st = rtcState;
+        return;
+    }
+    StatsState s;
+    HalNvs p;
+    p.begin("stats", true);
+    size_t len = p.getBytes("agg", &s, sizeof(s));
+    p.end();
+    if (len == sizeof(s) && statsValid(s)) st = s;
+    else memset(&st, 0, sizeof(st));
+}
+
+// ISO 8601: Woche mit dem Donnerstag, Jahr des Donnerstags
+static int32_t isoWeekKey(const struct tm &t) {
+    int year = t.tm_year + 1900;
+    int wday = (t.tm_wday + 6) % 7;             // Mo = 0
+    int thu = t.tm_yday - wday + 3;             // Tag im Jahr des Donnerstags
+    auto daysIn = [](int y) { return (y % 4 == 0 && (y % 100 != 0 || y % 400 == 0)) ? 366 : 365; };
+    if (thu < 0) {
+        year--;
+        thu += daysIn(year);
+    } else if (thu >= daysIn(year)) {
+        thu -= daysIn(year);
+        year++;
+    }
+    return year * 100 + thu / 7 + 1;
+}
+
+static float pulsesPerLiter() {
+    float k = settingsGetFlowFactor();
+    return k <= 0.1f ? 450.0f : k;
+}
+
+static String aggJson(const StatsAgg &a) {
+    String j = "\"key\":" + String(a.key);
+    j += ",\"l\":" + String(a.pulses / pulsesPerLiter(), 2);
+    j += ",\"open_s\":" + String(a.openMs / 1000UL);
+    j += ",\"runs\":" + String(a.runs);
+    j += ",\"peak\":" + String(a.peakCpm / 100.0f, 2);
+    return j;
+}
+
+String statsJson(StatsPeriod p) {
+    String j = "{\"period\":\"" + String(PERIOD_NAMES[p]) + "\"," + aggJson(st.cur[p]);
+    j += ",\"prev\":{" + aggJson(st.prev[p]) + "}}";
+    return j;
+}
+
+static void statsPublish() {
+    for (int p = 0; p < STATS_PERIODS; p++) {
+        String topic = String(TOPIC_STATS) + "/" + PERIOD_NAMES[p];
+        mqttPublish(topic.c_str(), statsJson((StatsPeriod)p).c_str(), true);
+    }
+    dirty = false;
+    published = true;
+    lastPublishMs = clockMillis();
+}
+
+void statsInit() {
+    statsLoad();
+    lastMs = clockMillis();
+    lastPulses = flowGetTotalPulses();
+    lastRunId = runlogLastId();
+    lastMday = -1;
+    wasOpen = false;
+    published = false;
+    if (st.cur[STATS_DAY].key != 0) {
+        logInfo("Usage stats restored: day " + String(st.cur[STATS_DAY].key) + ", " +
+                String(st.cur[STATS_DAY].pulses / pulsesPerLiter(), 1) + " L");
+    }
+}
+
+void statsLoop() {
+    unsigned long now = clockMillis();
+    uint32_t dt = now - lastMs;
+    lastMs = now;
+
+    unsigned long p = flowGetTotalPulses();
+    uint32_t d = p >= lastPulses ? p - lastPulses : 0;     // Zähler aus älterem Flash-Stand: neu aufsetzen
+    lastPulses = p;
+    uint32_t runId = runlogLastId();
+    uint32_t runs = runId - lastRunId;
+    lastRunId = runId;
+    bool open = wasOpen;
+    wasOpen = valveOpenCount() > 0;
+    float lpm = open || wasOpen ? flowGetLpm() : 0.0f;
+    uint16_t cpm = (uint16_t)min(lpm * 100.0f, 65535.0f);
+
+    if (d || runs || open || cpm) {
+        for (int i = 0; i < STATS_PERIODS; i++) {
+            StatsAgg &a = st.cur[i];
+            a.pulses += d;
+            if (open) a.openMs += dt;
+            a.runs = (uint16_t)min<uint32_t>(a.runs + runs, 0xFFFF);
+            if (cpm > a.peakCpm) a.peakCpm = cpm;
+        }
+        dirty = true;
+        flashDirty = true;
+    }
+
+    // Flash nur, wenn sich seit dem letzten Checkpoint etwas geändert hat (Verschleiß)
+    if (flashDirty && now - lastFlashMs >= STATS_FLASH_MS) statsSave(true);
+    else if (dirty && now - lastRtcMs >= STATS_RTC_MS) statsSave(false);
+
+    if (!mqttIsConnected()) {
+        published = false;
+    } else if (!published || (dirty && now - lastPublishMs >= STATS_PUBLISH_MS)) {
+        statsPublish();
+    }
+}
+
+void statsRoll(const struct tm &t) {
+    if (t.tm_mday == lastMday) return;          // Schlüssel nur bei Datumswechsel rechnen
+    lastMday = t.tm_mday;
+    int32_t keys[STATS_PERIODS] = {
+        (t.tm_year + 1900) * 10000 + (t.tm_mon + 1) * 100 + t.tm_mday,
+        isoWeekKey(t),
+        (t.tm_year + 1900) * 100 + t.tm_mon + 1
+    };
+    bool rolled = false, changed = false;
+    for (int i = 0; i < STATS_PERIODS; i++) {
+        StatsAgg &a = st.cur[i];
+        if (a.key == keys[i]) continue;
+        changed = true;
+        if (a.key != 0) {
+            // abgeschlossene Periode
+            st.prev[i] = a;
+            memset(&a, 0, sizeof(a));
+            rolled = true;
+        }
+        a.key = keys[i];                        // unbekanntes Datum: bisherige Werte zählen für heute
+    }
+    if (!changed) return;
+    statsSave(true);                            // alle Perioden in einem Schritt
+    dirty = true;
+    if (rolled) {
+        logInfo("Usage stats rolled over: yesterday " + String(st.prev[STATS_DAY].pulses / pulsesPerLiter(), 1) + " L");
+        if (mqttIsConnected()) statsPublish();
+    }
+}
+
+void statsGet(StatsPeriod p, StatsAgg &cur, StatsAgg &prev) {
+    cur = st.cur[p];
+    prev = st.prev[p];
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <Arduino.h>
+#include <time.h>
+
+// Verbrauch je Tag, Woche (ISO, ab Montag) und Monat auf dem Gerät:
+// Liter (aus dem Impulszähler), offene Sekunden (irgendeine Zone offen),
+// Läufe (Lauf-Protokoll) und Spitze L/min. Laufende und letzte
+// abgeschlossene Periode, RTC-RAM + Flash-Checkpoint.
+// Wechsel um lokale Mitternacht an derselben Stelle wie valveRollDay(),
+// alle drei Perioden in einem Schritt und einem Flash-Schreibvorgang.
+// Retained auf <base>/stats/day|week|month.
+
+enum StatsPeriod : uint8_t { STATS_DAY, STATS_WEEK, STATS_MONTH, STATS_PERIODS };
+
+struct StatsAgg {
+    int32_t  key;           // 20261019 / 202642 (ISO-Jahr, Woche) / 202610, 0 = ohne Datum
+    uint32_t pulses;
+    uint32_t openMs;
+    uint16_t runs;
+    uint16_t peakCpm;       // 0,01 L/min
+};
+
+void statsInit();
+void statsLoop();
+void statsRoll(const struct tm &local);   // jede Sekunde mit gültiger Ortszeit
+void statsGet(StatsPeriod p, StatsAgg &cur, StatsAgg &prev);
+// {"period":"day","key":20261019,"l":120.5,"open_s":1800,"runs":2,"peak":12.4,"prev":{...}}
+String statsJson(StatsPeriod p);
@@ -1,7 +1,8 @@
 #include "time_module.h"
 #include "config.h"
+#include "clock_module.h"
+#include "hal.h"
 #include "logger.h"
-#include <WiFi.h>
 #include <time.h>
 
 static bool timeSynced = false;
@@ -9,29 +10,28 @@ static bool timeSynced = false;
 void timeInit() {
     // 1. Zeitzone konfigurieren
     // NTP_TZ_OFFSET_S ist in config.h definiert (7 * 3600 für Thailand)
-    configTime(NTP_TZ_OFFSET_S, 0, NTP_SERVER_1);
+    halSntpStart(NTP_TZ_OFFSET_S, NTP_SERVER_1);
     
     // FIX: Korrekter POSIX-String für Thailand (Indochina Time, UTC+7)
     // In POSIX bedeutet 'ICT-7', dass man 7h abziehen muss, um auf UTC zu kommen.
-    setenv("TZ", "ICT-7", 1); 
+    setenv("TZ", TIME_TZ_POSIX, 1);
     tzset();
 
-    logInfo("Time Client init (Target: UTC+7 / ICT-7)");
+    logInfo("Time Client init (Target: UTC+7 / " TIME_TZ_POSIX ")");
 }
 
 void timeLoop() {
     static unsigned long lastCheck = 0;
-    if (millis() - lastCheck > 1000) {
-        lastCheck = millis();
+    if (clockMillis() - lastCheck > 1000) {
+        lastCheck = clockMillis();
         
         if (!timeSynced) {
-            time_t now;
-            time(&now);
+            time_t now = clockNow();
             // Wir prüfen, ob wir eine Zeit > 2020 haben (Epoch > 1577836800)
             if (now > 1577836800) {
                 timeSynced = true;
                 struct tm timeinfo;
-                localtime_r(&now, &timeinfo);
+                clockLocal(now, timeinfo);
                 char buf[64];
                 sprintf(buf, "NTP Sync Success: %02d.%02d.%04d %02d:%02d:%02d", 
                         timeinfo.tm_mday, timeinfo.tm_mon + 1, timeinfo.tm_year + 1900,
@@ -43,12 +43,11 @@ void timeLoop() {
 }
 
 String timeGetStr() {
-    time_t now;
-    time(&now);
+    time_t now = clockNow();
     if (now < 1577836800) return "--:--:--";
     
     struct tm timeinfo;
-    localtime_r(&now, &timeinfo);
+    clockLocal(now, timeinfo);
     char buf[16];
     sprintf(buf, "%02d:%02d:%02d", timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
     return String(buf);
@@ -61,9 +60,8 @@ bool timeIsValid() {
 }
 
 void timeGetLocal(struct tm &out) {
-    time_t now;
-    time(&now);
-    localtime_r(&now, &out);
+    time_t now = clockNow();
+    clockLocal(now, out);
 }
 
 bool timeIsDailyResetTime() {
@@ -0,0 +1,226 @@
+#include "tscodec_module.h"
+#include <string.h>
+#include <math.h>
+
+static const int DELTA_COLS = TS_COL_VALVE;     // ts, flow, total, vbat: Token-Spalten
+
+static size_t varintLen(uint64_t v) {
+    size_t n = 1;
+    while (v >= 0x80) { v >>= 7; n++; }
+    return n;
+}
+
+static size_t varintPut(uint8_t* out, uint64_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        out[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+static bool varintGet(const uint8_t* &p, const uint8_t* end, uint64_t &v) {
+    v = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t b = *p++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static uint64_t zigzag(int32_t v) { return (uint32_t)((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+static int32_t unzigzag(uint64_t z) { return (int32_t)((uint32_t)(z >> 1) ^ (0U - (uint32_t)(z & 1))); }
+
+// 0,01-Festkomma; NaN/unsinnige Werte als 0
+static int32_t fixed100(float x) {
+    if (!(x > -2.0e7f && x < 2.0e7f)) return 0;
+    return (int32_t)lroundf(x * 100.0f);
+}
+
+// === ENCODER ===
+static bool colPut(TsEncoder &e, int c, uint64_t v) {
+    TsColumn &col = e.col[c];
+    if (col.len + varintLen(v) > TS_BLOCK_MAX) return false;
+    col.len += varintPut(e.data[c] + col.len, v);
+    return true;
+}
+
+static bool colDelta(TsEncoder &e, int c, int32_t d) {
+    TsColumn &col = e.col[c];
+    if (d == 0) {
+        col.run++;
+        return true;
+    }
+    if (col.run) {
+        if (!colPut(e, c, ((uint64_t)col.run << 1) | 1)) return false;
+        col.run = 0;
+    }
+    return colPut(e, c, zigzag(d) << 1);
+}
+
+// Offene Null-Folge bzw. Lauflänge, erst in tsEncFinish() geschrieben
+static uint64_t pendingToken(const TsEncoder &e, int c) {
+    const TsColumn &col = e.col[c];
+    if (c == TS_COL_VALVE) return e.count ? ((uint64_t)col.run << 1) | (uint32_t)col.prev : 0;
+    return col.run ? ((uint64_t)col.run << 1) | 1 : 0;
+}
+
+static size_t colSize(const TsEncoder &e, int c) {
+    uint64_t t = pendingToken(e, c);
+    return e.col[c].len + (t ? varintLen(t) : 0);
+}
+
+void tsEncBegin(TsEncoder &e, size_t cap) {
+    e.cap = cap > TS_BLOCK_MAX ? TS_BLOCK_MAX : (uint16_t)cap;
+    e.count = 0;
+    memset(e.col, 0, sizeof(e.col));
+}
+
+size_t tsEncSize(const TsEncoder &e) {
+    size_t n = 1 + varintLen(e.count);
+    for (int c = 0; c < TS_COLS; c++) {
+        size_t len = colSize(e, c);
+        if (c < DELTA_COLS) n += varintLen(len);
+        n += len;
+    }
+    return n;
+}
+
+bool tsEncAdd(TsEncoder &e, const TsPoint &p) {
+    if (e.count >= TS_MAX_POINTS) return false;
+    TsColumn saved[TS_COLS];
+    memcpy(saved, e.col, sizeof(saved));
+
+    TsColumn &ts = e.col[TS_COL_TS];
+    TsColumn &valve = e.col[TS_COL_VALVE];
+    bool ok;
+    if (e.count == 0) {
+        ok = colPut(e, TS_COL_TS, p.ts);
+        ts.prevDelta = 0;
+    } else {
+        int32_t delta = (int32_t)(p.ts - (uint32_t)ts.prev);
+        ok = colDelta(e, TS_COL_TS, (int32_t)((uint32_t)delta - (uint32_t)ts.prevDelta));
+        ts.prevDelta = delta;
+    }
+    ts.prev = (int32_t)p.ts;
+
+    const float v[] = { p.flowLpm, p.totalL, p.batV };
+    for (int c = TS_COL_FLOW; ok && c < DELTA_COLS; c++) {
+        int32_t x = fixed100(v[c - TS_COL_FLOW]);
+        ok = colDelta(e, c, (int32_t)((uint32_t)x - (uint32_t)e.col[c].prev));
+        e.col[c].prev = x;
+    }
+
+    int32_t open = p.valveOpen ? 1 : 0;
+    if (e.count == 0 || open != valve.prev) {
+        if (ok && e.count) ok = colPut(e, TS_COL_VALVE, ((uint64_t)valve.run << 1) | (uint32_t)valve.prev);
+        valve.prev = open;
+        valve.run = 1;
+    } else {
+        valve.run++;
+    }
+
+    e.count++;
+    if (!ok || tsEncSize(e) > e.cap) {
+        e.count--;
+        memcpy(e.col, saved, sizeof(saved));
+        return false;
+    }
+    return true;
+}
+
+size_t tsEncFinish(const TsEncoder &e, uint8_t* out, size_t cap) {
+    if (tsEncSize(e) > cap) return 0;
+    size_t n = 0;
+    out[n++] = TS_VERSION;
+    n += varintPut(out + n, e.count);
+    for (int c = 0; c < DELTA_COLS; c++) n += varintPut(out + n, colSize(e, c));
+    for (int c = 0; c < TS_COLS; c++) {
+        memcpy(out + n, e.data[c], e.col[c].len);
+        n += e.col[c].len;
+        uint64_t t = pendingToken(e, c);
+        if (t) n += varintPut(out + n, t);
+    }
+    return n;
+}
+
+// === DECODER ===
+static bool curToken(TsCursor &c, int32_t &d) {
+    if (c.run) {
+        c.run--;
+        d = 0;
+        return true;
+    }
+    uint64_t t;
+    if (!varintGet(c.p, c.end, t)) return false;
+    if (t & 1) {
+        if ((t >> 1) == 0) return false;
+        c.run = (uint32_t)(t >> 1) - 1;
+        d = 0;
+    } else {
+        d = unzigzag(t >> 1);
+    }
+    return true;
+}
+
+bool tsDecBegin(TsDecoder &d, const uint8_t* buf, size_t len) {
+    memset(&d, 0, sizeof(d));
+    d.error = true;
+    const uint8_t* p = buf;
+    const uint8_t* end = buf + len;
+    uint64_t count, colLen[DELTA_COLS];
+    if (len < 1 || *p++ != TS_VERSION) return false;
+    if (!varintGet(p, end, count) || count > TS_MAX_POINTS) return false;
+    for (int c = 0; c < DELTA_COLS; c++) {
+        if (!varintGet(p, end, colLen[c])) return false;
+    }
+    for (int c = 0; c < DELTA_COLS; c++) {
+        if (colLen[c] > (uint64_t)(end - p)) return false;
+        d.col[c].p = p;
+        d.col[c].end = p + colLen[c];
+        p += colLen[c];
+    }
+    d.col[TS_COL_VALVE].p = p;
+    d.col[TS_COL_VALVE].end = end;
+    d.count = (uint16_t)count;
+    d.error = false;
+    return true;
+}
+
+bool tsDecNext(TsDecoder &d, TsPoint &p) {
+    if (d.error || d.done >= d.count) return false;
+    int32_t v;
+    TsCursor &ts = d.col[TS_COL_TS];
+    if (d.done == 0) {
+        uint64_t t0;
+        if (!varintGet(ts.p, ts.end, t0)) { d.error = true; return false; }
+        ts.prev = (int32_t)(uint32_t)t0;
+    } else {
+        if (!curToken(ts, v)) { d.error = true; return false; }
+        ts.prevDelta = (int32_t)((uint32_t)ts.prevDelta + (uint32_t)v);
+        ts.prev = (int32_t)((uint32_t)ts.prev + (uint32_t)ts.prevDelta);
+    }
+    p.ts = (uint32_t)ts.prev;
+
+    float* out[] = { &p.flowLpm, &p.totalL, &p.batV };
+    for (int c = TS_COL_FLOW; c < DELTA_COLS; c++) {
+        TsCursor &col = d.col[c];
+        if (!curToken(col, v)) { d.error = true; return false; }
+        col.prev = (int32_t)((uint32_t)col.prev + (uint32_t)v);
+        *out[c - TS_COL_FLOW] = col.prev / 100.0f;
+    }
+
+    TsCursor &valve = d.col[TS_COL_VALVE];
+    if (valve.run == 0) {
+        uint64_t t;
+        if (!varintGet(valve.p, valve.end, t) || (t >> 1) == 0) { d.error = true; return false; }
+        valve.run = (uint32_t)(t >> 1);
+        valve.prev = (int32_t)(t & 1);
+    }
+    valve.run--;
+    p.valveOpen = valve.prev != 0;
+    d.done++;
+    return true;
+}
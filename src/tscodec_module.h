@@ -0,0 +1,82 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// Kompakte Spalten-Kodierung für Zeitreihen mit den Feldern des Verlaufs
+// (TOPIC_HISTORY: ts, flow_l_min, total_l, vbat, valve). Als JSON kostet ein
+// Punkt ~90 Byte, hier typisch 1..4 Byte.
+//
+// Block (in sich geschlossen, höchstens TS_BLOCK_MAX Byte):
+//   u8      TS_VERSION
+//   varint  Anzahl Punkte
+//   varint  Länge der Spalten ts, flow, total, vbat (valve = Rest)
+//   Spalten hintereinander:
+//     ts     varint erster Zeitstempel, danach Delta-of-Delta (Minutentakt = 0)
+//     flow   0,01 L/min  |
+//     total  0,01 L      | Delta zum Vorgänger (Start bei 0)
+//     vbat   0,01 V      |
+//     valve  Lauflängen: varint(n << 1 | offen)
+//   Deltas als Token: varint(zigzag(d) << 1), n Nullen hintereinander als
+//   varint(n << 1 | 1) - Minuten ohne Änderung kosten fast nichts.
+// Werte werden auf 0,01 gerundet (so viel steht auch im JSON).
+//
+// Streaming: tsEncAdd() nimmt Punkt für Punkt, bis der Block voll ist;
+// tsEncFinish() schreibt den Block, ohne den Encoder zu verändern (der
+// wachsende Block ist so jederzeit lesbar). tsDecNext() liefert Punkt für
+// Punkt direkt aus dem Block, ohne Zwischenpuffer.
+// Reines C++ ohne Arduino/HAL: tools/tsc_tool.cpp baut es auf dem PC mit.
+
+#define TS_VERSION      1
+#define TS_BLOCK_MAX    256     // Block- und Spaltenpuffer (Encoder ~1,3 KB RAM)
+#define TS_MAX_POINTS   4096    // Punkte je Block
+
+enum TsColumnId : uint8_t { TS_COL_TS, TS_COL_FLOW, TS_COL_TOTAL, TS_COL_VBAT, TS_COL_VALVE, TS_COLS };
+
+struct TsPoint {
+    uint32_t ts;            // Epoch (s)
+    float    flowLpm;
+    float    totalL;
+    float    batV;
+    bool     valveOpen;
+};
+
+struct TsColumn {
+    uint16_t len;
+    uint16_t run;           // noch nicht geschriebene Null-Deltas bzw. Lauflänge (valve)
+    int32_t  prev;          // letzter Wert (ts: Zeitstempel, valve: Zustand)
+    int32_t  prevDelta;     // nur ts
+};
+
+struct TsEncoder {
+    uint16_t cap;
+    uint16_t count;
+    TsColumn col[TS_COLS];
+    uint8_t  data[TS_COLS][TS_BLOCK_MAX];
+};
+
+struct TsCursor {
+    const uint8_t* p;
+    const uint8_t* end;
+    int32_t        prev;
+    int32_t        prevDelta;
+    uint32_t       run;     // offene Null-Folge bzw. Rest der Lauflänge
+};
+
+struct TsDecoder {
+    uint16_t count;
+    uint16_t done;
+    bool     error;         // Block kaputt oder abgeschnitten
+    TsCursor col[TS_COLS];
+};
+
+// cap = Blockgröße in Byte (höchstens TS_BLOCK_MAX)
+void   tsEncBegin(TsEncoder &e, size_t cap);
+// false = Block voll, Punkt nicht übernommen (neuen Block beginnen)
+bool   tsEncAdd(TsEncoder &e, const TsPoint &p);
+size_t tsEncSize(const TsEncoder &e);
+// Schreibt den Block nach out; 0 = out zu klein
+size_t tsEncFinish(const TsEncoder &e, uint8_t* out, size_t cap);
+
+bool   tsDecBegin(TsDecoder &d, const uint8_t* buf, size_t len);
+// false = Ende oder Fehler (d.error)
+bool   tsDecNext(TsDecoder &d, TsPoint &p);
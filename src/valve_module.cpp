@@ -1,67 +1,374 @@
 #include "valve_module.h"
 #include "config.h"
+#include "clock_module.h"
+#include "hal.h"
 #include "logger.h"
-#include <esp_task_wdt.h> 
+#include "metrics_module.h"
+#include "flow_module.h"
+#include "mqtt_module.h"
 
-static ValveState currentState = ValveState::CLOSED;
-static unsigned long dailyOpenSeconds = 0;
-static unsigned long lastCountMs = 0;
+static const uint8_t ZONE_PINS[] = VALVE_ZONE_PINS;
+static_assert(sizeof(ZONE_PINS) == VALVE_ZONES, "VALVE_ZONE_PINS needs one pin per zone");
+
+static bool zoneOpen[VALVE_ZONES];
+static bool locked = false;             // während OTA nichts öffnen
+static volatile bool emergency = false; // Guard hat abgeschaltet, bis Quittierung nichts öffnen
+
+// === ÖFFNUNGSZEIT-KONTO ===
+// Abgerechnet wird in ms zwischen den Schaltzeitpunkten, nicht im Sekundentakt.
+// Das Konto (Datum + ms je Zone) liegt im RTC-RAM (überlebt Reset, Panic,
+// Auto-Reboot) und als Checkpoint im Flash (überlebt Stromausfall).
+static const uint32_t ACCOUNT_MAGIC = 0x41434331;   // "ACC1"
+
+struct OpenAccount {
+    uint32_t magic;
+    int32_t  day;               // JJJJMMTT, 0 = Datum noch unbekannt
+    uint32_t openMs[VALVE_ZONES];
+    uint32_t check;
+};
+
+RTC_DATA_ATTR static OpenAccount rtcAccount;
+static OpenAccount account;                     // bis openSinceMs abgerechnet
+static unsigned long openSinceMs[VALVE_ZONES];
+static unsigned long lastRtcMs = 0;
+static unsigned long lastFlashMs = 0;
+
+static uint32_t accountCheck(const OpenAccount &a) {
+    // FNV-1a über alles außer 'check'
+    const uint8_t* p = (const uint8_t*)&a;
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < offsetof(OpenAccount, check); i++) h = (h ^ p[i]) * 16777619u;
+    return h;
+}
+
+static bool accountValid(const OpenAccount &a) {
+    return a.magic == ACCOUNT_MAGIC && a.check == accountCheck(a);
+}
+
+// offene Zonen bis 'now' abrechnen
+static void accountFold(unsigned long now) {
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        if (!zoneOpen[z]) continue;
+        account.openMs[z] += now - openSinceMs[z];
+        openSinceMs[z] = now;
+    }
+}
+
+static void accountSave(bool toFlash) {
+    account.magic = ACCOUNT_MAGIC;
+    account.check = accountCheck(account);
+    rtcAccount = account;
+    if (toFlash) {
+        HalNvs p;
+        p.begin("valve-acc", false);
+        p.putBytes("acc", &account, sizeof(account));
+        p.end();
+        lastFlashMs = clockMillis();
+    }
+}
+
+static void accountLoad() {
+    if (accountValid(rtcAccount)) {
+        account = rtcAccount;
+    } else {
+        OpenAccount a;
+        HalNvs p;
+        p.begin("valve-acc", true);
+        size_t len = p.getBytes("acc", &a, sizeof(a));
+        p.end();
+        if (len == sizeof(a) && accountValid(a)) account = a;
+        else memset(&account, 0, sizeof(account));
+    }
+    if (account.day != 0 || valveGetDailyOpenMs() > 0) {
+        logInfo("Valve open time restored: " + String(valveGetDailyOpenMs()) + " ms (day " + String(account.day) + ")");
+    }
+}
+
+// === ZUSTANDSAUTOMAT ===
+struct ZoneFsm {
+    ValvePhase    phase;
+    bool          measured;     // Impulse gehören nur zu dieser Zone
+    unsigned long actUs;        // letzter Schaltbefehl (clockMicros)
+    ValveLatency  openLat;
+    ValveLatency  closeLat;
+};
+
+static ZoneFsm fsm[VALVE_ZONES];
 
 // DEINE SPEZIELLE HARDWARE-LOGIK (Wiederhergestellt)
-static void valveApplyHardware() {
-    if (currentState == ValveState::OPEN) {
-        // Öffnen: Pin als Output treiben + LOW ziehen
-        pinMode(PIN_RELAY, OUTPUT);
-        digitalWrite(PIN_RELAY, LOW); 
+static void valveApplyHardware(int zone) {
+    uint8_t pin = ZONE_PINS[zone];
+    if (zoneOpen[zone]) {
+        // Öffnen: Pin als Output treiben + LOW ziehen. Gesperrt, damit der
+        // Guard-Timer nicht zwischen Prüfung und Schalten abschaltet.
+        halInterruptsOff();
+        if (!emergency) {
+            halPinMode(pin, OUTPUT);
+            halDigitalWrite(pin, LOW);
+        }
+        halInterruptsOn();
     } else {
         // Schließen: Pin hochohmig machen (Pullup)
-        pinMode(PIN_RELAY, INPUT_PULLUP);
+        halPinMode(pin, INPUT_PULLUP);
         // Zur Sicherheit High schreiben, falls er doch Output wird
-        digitalWrite(PIN_RELAY, HIGH); 
+        halDigitalWrite(pin, HIGH);
+    }
+}
+
+static void latencyAdd(ValveLatency &l, uint32_t ms) {
+    if (ms > 0xFFFF) ms = 0xFFFF;
+    if (l.count == 0xFFFF) {            // halbieren, Mittelwert bleibt
+        l.count /= 2;
+        l.sumMs /= 2;
+    }
+    if (l.count == 0 || ms < l.minMs) l.minMs = ms;
+    if (ms > l.maxMs) l.maxMs = ms;
+    l.lastMs = ms;
+    l.sumMs += ms;
+    l.count++;
+}
+
+uint16_t valveLatencyAvgMs(const ValveLatency &l) {
+    return l.count ? l.sumMs / l.count : 0;
+}
+
+// Andere Zone offen oder im Übergang -> der eine Sensor ist nicht zuordenbar
+static bool sensorShared(int zone) {
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        if (z != zone && (zoneOpen[z] || fsm[z].phase == ValvePhase::CLOSING)) return true;
+    }
+    return false;
+}
+
+static bool flowStopped(unsigned long nowUs, unsigned long &lastUs) {
+    if (!flowGetLastPulseUs(lastUs)) return true;
+    return nowUs - lastUs >= VALVE_FLOW_QUIET_MS * 1000UL;
+}
+
+static void fsmEvent(int zone, const char* event, const char* fault, uint32_t elapsedMs) {
+    const ZoneFsm &f = fsm[zone];
+    String extra = "\"zone\":" + String(zone + 1);
+    if (fault) extra += ",\"fault\":\"" + String(fault) + "\"";
+    extra += ",\"elapsed_ms\":" + String(elapsedMs);
+    extra += ",\"open_ms\":" + String(valveLatencyAvgMs(f.openLat));
+    extra += ",\"close_ms\":" + String(valveLatencyAvgMs(f.closeLat));
+    extra += ",\"flow_lpm\":" + String(flowGetLpm(), 2);
+    mqttPublishEvent(event, extra);
+}
+
+static void fsmCommand(int zone, bool open) {
+    ZoneFsm &f = fsm[zone];
+    // aus einem Übergang oder Fehler heraus wäre die Latenz Unsinn
+    bool settled = f.phase == ValvePhase::CLOSED || f.phase == ValvePhase::OPEN;
+    f.measured = settled && !sensorShared(zone);
+    f.actUs = clockMicros();
+    f.phase = open ? ValvePhase::OPENING : ValvePhase::CLOSING;
+    if (open && f.measured) flowArmFirstPulse();
+}
+
+static void fsmStep(int zone) {
+    ZoneFsm &f = fsm[zone];
+    if (f.phase == ValvePhase::CLOSED || f.phase == ValvePhase::OPEN) return;
+
+    unsigned long nowUs = clockMicros();
+    uint32_t elapsedMs = (nowUs - f.actUs) / 1000;
+    unsigned long pulseUs = 0;
+    if (sensorShared(zone)) f.measured = false;
+
+    switch (f.phase) {
+    case ValvePhase::OPENING:
+        if (!f.measured) {
+            f.phase = ValvePhase::OPEN;
+        } else if (flowGetFirstPulseUs(pulseUs)) {
+            latencyAdd(f.openLat, (pulseUs - f.actUs) / 1000);
+            f.phase = ValvePhase::OPEN;
+        } else if (elapsedMs >= VALVE_OPEN_TIMEOUT_MS) {
+            f.phase = ValvePhase::FAULT;
+            metricInc(MC_VALVE_FAULTS);
+            logError("Zone " + String(zone + 1) + " stuck closed: no flow " + String(elapsedMs) + " ms after OPEN");
+            fsmEvent(zone, "valve_fault", "stuck_closed", elapsedMs);
+        }
+        break;
+
+    case ValvePhase::CLOSING:
+        if (!f.measured) {
+            f.phase = ValvePhase::CLOSED;
+        } else if (flowStopped(nowUs, pulseUs)) {
+            // letzter Impuls nach dem Befehl = Schließzeit inkl. Nachlauf
+            if (pulseUs && (long)(pulseUs - f.actUs) > 0) latencyAdd(f.closeLat, (pulseUs - f.actUs) / 1000);
+            f.phase = ValvePhase::CLOSED;
+        } else if (elapsedMs >= VALVE_CLOSE_TIMEOUT_MS) {
+            f.phase = ValvePhase::FAULT;
+            metricInc(MC_VALVE_FAULTS);
+            logError("Zone " + String(zone + 1) + " stuck open: flow " + String(elapsedMs) + " ms after CLOSE");
+            valveApplyHardware(zone);   // Ausgang nochmal auf "zu" treiben
+            fsmEvent(zone, "valve_fault", "stuck_open", elapsedMs);
+        }
+        break;
+
+    case ValvePhase::FAULT:
+        // Fehler erledigt sich, wenn der Sensor zum befohlenen Zustand passt
+        if (zoneOpen[zone] ? flowGetFirstPulseUs(pulseUs) : flowStopped(nowUs, pulseUs)) {
+            f.phase = zoneOpen[zone] ? ValvePhase::OPEN : ValvePhase::CLOSED;
+            logInfo("Zone " + String(zone + 1) + " recovered (" + valvePhaseName(f.phase) + ")");
+            fsmEvent(zone, "valve_recovered", nullptr, elapsedMs);
+        }
+        break;
+
+    default:
+        break;
     }
 }
 
 void valveInit() {
-    // Startzustand: Zu (Input Pullup)
-    pinMode(PIN_RELAY, INPUT_PULLUP);
-    currentState = ValveState::CLOSED;
-    valveApplyHardware(); 
-    logInfo("Valve initialized (Low-Side/Input Mode)");
+    // Startzustand: alle Zonen zu (Input Pullup)
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        zoneOpen[z] = false;
+        valveApplyHardware(z);
+    }
+    memset(fsm, 0, sizeof(fsm));
+    accountLoad();
+    metricSet(MG_DAILY_OPEN_SEC, valveGetDailyOpenSec());
+    logInfo("Valve initialized (Low-Side/Input Mode, " + String(VALVE_ZONES) + " zones)");
 }
 
 void valveLoop() {
-    unsigned long now = millis();
-    
-    // Zähler Logik
-    if (currentState == ValveState::OPEN) {
-        if (now - lastCountMs >= 1000) {
-            dailyOpenSeconds++;
-            lastCountMs = now;
-        }
+    for (int z = 0; z < VALVE_ZONES; z++) fsmStep(z);
+    if (valveOpenCount() == 0) return;
+
+    // Offene Zeit regelmäßig sichern; geschlossen ist das Konto schon aktuell
+    unsigned long now = clockMillis();
+    if (now - lastRtcMs >= VALVE_ACC_RTC_MS) {
+        accountFold(now);
+        accountSave(now - lastFlashMs >= VALVE_ACC_FLASH_MS);
+        lastRtcMs = now;
+        metricSet(MG_DAILY_OPEN_SEC, valveGetDailyOpenSec());
+    }
+}
+
+bool valveZoneSet(int zone, bool open) {
+    if (zone < 0 || zone >= VALVE_ZONES) return false;
+    if (open && (locked || emergency)) return false;
+    if (zoneOpen[zone] == open) return true;
+
+    unsigned long now = clockMillis();
+    if (open) {
+        openSinceMs[zone] = now;
+        if (valveOpenCount() == 0) lastRtcMs = lastFlashMs = now;
     } else {
-        lastCountMs = now; 
+        accountFold(now);
+    }
+    zoneOpen[zone] = open;
+    valveApplyHardware(zone);
+    fsmCommand(zone, open);
+    if (!open) {
+        accountSave(true);
+        metricSet(MG_DAILY_OPEN_SEC, valveGetDailyOpenSec());
     }
+    metricInc(MC_VALVE_ACTUATIONS);
+    metricSet(MG_VALVE_OPEN, valveOpenCount());
+    if (VALVE_ZONES == 1) logInfo(String("Valve set to ") + (open ? "OPEN" : "CLOSED"));
+    else logInfo("Zone " + String(zone + 1) + (open ? " OPEN" : " CLOSED"));
+    return true;
+}
+
+bool valveZoneIsOpen(int zone) {
+    return zone >= 0 && zone < VALVE_ZONES && zoneOpen[zone];
+}
+
+int valveOpenCount() {
+    int n = 0;
+    for (int z = 0; z < VALVE_ZONES; z++) if (zoneOpen[z]) n++;
+    return n;
 }
 
 void valveSet(ValveState s) {
-    if (s != currentState) {
-        currentState = s;
-        valveApplyHardware();
-        logInfo(String("Valve set to ") + (s == ValveState::OPEN ? "OPEN" : "CLOSED"));
+    if (s == ValveState::OPEN) {
+        valveZoneSet(0, true);
+    } else {
+        for (int z = 0; z < VALVE_ZONES; z++) valveZoneSet(z, false);
     }
 }
 
-ValveState valveGetState() { return currentState; }
+ValveState valveGetState() { return valveOpenCount() > 0 ? ValveState::OPEN : ValveState::CLOSED; }
 
-unsigned long valveGetDailyOpenSec() { return dailyOpenSeconds; }
-void valveResetDailyOpenSec() { dailyOpenSeconds = 0; }
+uint32_t valveZoneGetDailyOpenMs(int zone) {
+    if (zone < 0 || zone >= VALVE_ZONES) return 0;
+    uint32_t ms = account.openMs[zone];
+    if (zoneOpen[zone]) ms += clockMillis() - openSinceMs[zone];
+    return ms;
+}
+
+uint32_t valveGetDailyOpenMs() {
+    uint32_t sum = 0;
+    for (int z = 0; z < VALVE_ZONES; z++) sum += valveZoneGetDailyOpenMs(z);
+    return sum;
+}
+
+unsigned long valveZoneGetDailyOpenSec(int zone) { return valveZoneGetDailyOpenMs(zone) / 1000; }
+unsigned long valveGetDailyOpenSec() { return valveGetDailyOpenMs() / 1000; }
+
+ValvePhase valveZoneGetPhase(int zone) {
+    return (zone >= 0 && zone < VALVE_ZONES) ? fsm[zone].phase : ValvePhase::CLOSED;
+}
+
+const char* valvePhaseName(ValvePhase p) {
+    switch (p) {
+        case ValvePhase::OPENING: return "OPENING";
+        case ValvePhase::OPEN:    return "OPEN";
+        case ValvePhase::CLOSING: return "CLOSING";
+        case ValvePhase::FAULT:   return "FAULT";
+        default:                  return "CLOSED";
+    }
+}
+
+void valveZoneGetLatency(int zone, ValveLatency &open, ValveLatency &close) {
+    if (zone < 0 || zone >= VALVE_ZONES) {
+        open = close = ValveLatency();
+        return;
+    }
+    open = fsm[zone].openLat;
+    close = fsm[zone].closeLat;
+}
+
+bool valveRollDay(int32_t day) {
+    if (day == account.day) return false;
+    bool newDay = account.day != 0;     // unbekanntes Datum: bisherige Zeit zählt für heute
+    accountFold(clockMillis());
+    if (newDay) memset(account.openMs, 0, sizeof(account.openMs));
+    account.day = day;
+    accountSave(true);
+    metricSet(MG_DAILY_OPEN_SEC, valveGetDailyOpenSec());
+    return newDay;
+}
+
+void valveEmergencyClose() {
+    emergency = true;
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        halPinMode(ZONE_PINS[z], INPUT_PULLUP);
+        halDigitalWrite(ZONE_PINS[z], HIGH);
+    }
+}
+
+void valveEmergencyRelease() { emergency = false; }
+bool valveIsEmergency() { return emergency; }
 
 void valveSafeBeforeUpdate() {
     logWarn("Safe mode: Valve CLOSE for OTA");
     valveSet(ValveState::CLOSED);
-    esp_task_wdt_delete(NULL); 
+    locked = true;
+    halWdtDeleteTask();
+}
+
+bool valveSelfTest() {
+    // Offen wird der Pin aktiv getrieben, da gibt es nichts zurückzulesen
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        if (!zoneOpen[z] && halDigitalRead(ZONE_PINS[z]) != HIGH) return false;
+    }
+    return true;
 }
 
 void valveSafeAfterUpdate() {
+    locked = false;
     logInfo("Safe mode done");
-}
\ No newline at end of file
+}
@@ -5,12 +5,56 @@ enum class ValveState { CLOSED, OPEN };
 
 void valveInit();
 void valveLoop();
+
+// Sammel-Funktionen: OPEN = Zone 1 auf, CLOSED = alle Zonen zu
 void valveSet(ValveState s);
-ValveState valveGetState();
+ValveState valveGetState();          // OPEN, sobald eine Zone offen ist
+
+// === ZONEN (0 .. VALVE_ZONES-1) ===
+bool valveZoneSet(int zone, bool open);   // false = gesperrt (OTA) oder ungültig
+bool valveZoneIsOpen(int zone);
+int  valveOpenCount();
+unsigned long valveZoneGetDailyOpenSec(int zone);
+uint32_t valveZoneGetDailyOpenMs(int zone);
+
+// === ZUSTANDSAUTOMAT (je Zone) ===
+// Befohlen wird offen/zu, beobachtet über den Durchflusssensor:
+// OPENING bis zum ersten Impuls, CLOSING bis der Durchfluss steht.
+// FAULT = kein Durchfluss nach dem Öffnen (klemmt zu) oder weiter
+// Durchfluss nach dem Schließen (klemmt offen), Event "valve_fault".
+// Sind andere Zonen offen, sind Impulse nicht zuordenbar -> keine Messung.
+enum class ValvePhase : uint8_t { CLOSED, OPENING, OPEN, CLOSING, FAULT };
+
+struct ValveLatency {
+    uint16_t count;
+    uint16_t lastMs;
+    uint16_t minMs;
+    uint16_t maxMs;
+    uint32_t sumMs;
+};
+
+ValvePhase valveZoneGetPhase(int zone);
+const char* valvePhaseName(ValvePhase p);
+// Befehl -> erster Impuls (open) bzw. Befehl -> letzter Impuls inkl. Nachlauf (close)
+void valveZoneGetLatency(int zone, ValveLatency &open, ValveLatency &close);
+uint16_t valveLatencyAvgMs(const ValveLatency &l);
+
+// Notabschaltung aus dem Guard-Timer (anderer Task): schaltet nur die
+// Ausgänge ab. Zustand/Konto gleicht loop() per valveSet(CLOSED) nach,
+// bis valveEmergencyRelease() öffnet keine Zone.
+void valveEmergencyClose();
+void valveEmergencyRelease();
+bool valveIsEmergency();
 
 void valveSafeBeforeUpdate();
 void valveSafeAfterUpdate();
 
+// Pin-Rücklesen: zu = Eingang mit Pullup muss HIGH lesen (OTA-Selbsttest)
+bool valveSelfTest();
+
 // === NEU: Zähler-Funktionen ===
-unsigned long valveGetDailyOpenSec(); // Abrufen
-void valveResetDailyOpenSec();        // Auf 0 setzen (für Mitternacht)
\ No newline at end of file
+// Tageskonto in ms, übersteht Neustarts (RTC-RAM + Flash)
+unsigned long valveGetDailyOpenSec(); // Summe aller Zonen
+uint32_t valveGetDailyOpenMs();
+// Datum JJJJMMTT melden; true = neuer Tag, Konto wurde auf 0 gesetzt
+bool valveRollDay(int32_t day);
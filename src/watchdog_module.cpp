@@ -3,30 +3,52 @@
 #include "logger.h"
 #include "valve_module.h"
 #include "irrigation_module.h"
-#include <esp_task_wdt.h>
+#include "metrics_module.h"
+#include "hal.h"
 
 // 10 Sekunden Timeout
 static const int WDT_TIMEOUT_MS = 10000;
 
+// Loop-Jitter Messung
+static const unsigned long LOOP_MAX_WINDOW_MS = 10000;
+static unsigned long lastFeedUs = 0;
+static unsigned long loopAvgUs = 0;
+static unsigned long loopMaxUs = 0;       // laufendes Fenster
+static unsigned long loopMaxPrevUs = 0;   // abgeschlossenes Fenster
+static unsigned long loopWindowStartMs = 0;
+
 void watchdogInit() {
-    // --- FIX FÜR ESP32-C6 (ESP-IDF v5 API) ---
-    // Statt esp_task_wdt_init(10, true) nutzen wir jetzt eine Config-Struktur
-    esp_task_wdt_config_t twdt_config = {
-        .timeout_ms = WDT_TIMEOUT_MS,
-        .idle_core_mask = (1 << 0), // Bitmaske für Core 0 (C6 hat nur Core 0)
-        .trigger_panic = true       // Reboot bei Hänger
-    };
-    
-    esp_task_wdt_init(&twdt_config);
-    esp_task_wdt_add(NULL); // Fügt den aktuellen Loop-Task zur Überwachung hinzu
+    // ESP32-C6 (ESP-IDF v5): Config-Struktur statt esp_task_wdt_init(10, true)
+    halWdtInit(WDT_TIMEOUT_MS);
     
     logInfo("Watchdog initialized (ESP32-C6 API)");
 }
 
 void watchdogFeed() {
-    esp_task_wdt_reset();
+    halWdtReset();
+
+    unsigned long nowUs = halRealMicros();
+    if (lastFeedUs != 0) {
+        unsigned long dt = nowUs - lastFeedUs;
+        loopAvgUs = (loopAvgUs * 15 + dt) / 16;
+        if (dt > loopMaxUs) loopMaxUs = dt;
+        metricObserveLoopUs(dt);
+        metricSet(MG_LOOP_AVG_US, loopAvgUs);
+        metricSet(MG_LOOP_MAX_US, max(loopMaxUs, loopMaxPrevUs));
+    }
+    lastFeedUs = nowUs;
+
+    unsigned long nowMs = halRealMillis();
+    if (nowMs - loopWindowStartMs >= LOOP_MAX_WINDOW_MS) {
+        loopMaxPrevUs = loopMaxUs;
+        loopMaxUs = 0;
+        loopWindowStartMs = nowMs;
+    }
 }
 
+unsigned long watchdogGetLoopAvgUs() { return loopAvgUs; }
+unsigned long watchdogGetLoopMaxUs() { return max(loopMaxUs, loopMaxPrevUs); }
+
 void watchdogLoop() {
     // Täglicher Neustart-Logik
     if (timeIsDailyResetTime()) {
@@ -37,7 +59,7 @@ void watchdogLoop() {
 
         logWarn("Daily reset time reached -> safe close valve & reboot");
         valveSafeBeforeUpdate();
-        delay(500);
-        ESP.restart();
+        halDelay(500);
+        halRestart();
     }
 }
\ No newline at end of file
@@ -4,3 +4,8 @@
 void watchdogInit();
 void watchdogLoop();
 void watchdogFeed();
+
+
+// Loop-Timing (gemessen zwischen zwei watchdogFeed()-Aufrufen)
+unsigned long watchdogGetLoopAvgUs();   // gleitender Mittelwert
+unsigned long watchdogGetLoopMaxUs();   // Maximum der letzten ~10 s
@@ -1,66 +1,224 @@
 /****************************************************
  * web_module.cpp
  * Firmware: V1.2.9 - Timezone & Mode Display Fix
+ *
+ * Der Webserver läuft in einem eigenen Task (webTask). Handler lesen nur
+ * den DeviceSnapshot und schicken Aktionen als WebCommand in eine Queue,
+ * die webLoop() im Haupt-Loop abarbeitet. Ein langsamer Client oder ein
+ * OTA-Upload hält so flowLoop(), irrigationLoop() und den Failsafe nicht an.
  ****************************************************/
 
 #include "web_module.h"
 #include "config.h"
+#include "clock_module.h"
 #include "logger.h"
-#include "wifi_module.h"
 #include "valve_module.h"
-#include "flow_module.h"
-#include "battery_module.h"
 #include "irrigation_module.h"
-#include "settings_module.h" 
-#include "mqtt_module.h" 
-#include "time_module.h"
+#include "settings_module.h"
+#include "mqtt_module.h"
+#include "snapshot_module.h"
+#include "web_ui.h"
+#include "sse_module.h"
+#include "metrics_module.h"
+#include "ota_module.h"
+#include "rules_module.h"
+#include "guard_module.h"
+#include "runlog_module.h"
+#include "history_module.h"
 
 #include <WebServer.h>
-#include <Update.h>
+#include <esp_cpu.h>
+#include <atomic>
 
 static WebServer server(80);
 
-const String dayNames[] = {"Su","Mo","Tu","We","Th","Fr","Sa"};
-
-const char* COMMON_CSS = 
-"<style>"
-"body { font-family: -apple-system, BlinkMacSystemFont, 'Segoe UI', Roboto, Helvetica, Arial, sans-serif; margin: 0; padding: 10px; background: #f4f4f9; color: #333; max-width: 800px; margin: 0 auto; }"
-"h1 { font-size: 1.5rem; margin-bottom: 5px; color: #444; }"
-".header-info { background: #e9ecef; padding: 10px; border-radius: 5px; margin-bottom: 15px; display: flex; justify-content: space-between; align-items: center; font-weight: bold; font-family: monospace; font-size: 1.1rem; }"
-"h2 { font-size: 1.2rem; margin-top: 20px; border-bottom: 2px solid #ddd; padding-bottom: 5px; }"
-"p { margin: 5px 0; font-size: 0.95rem; line-height: 1.4; }"
-".card { background: white; padding: 15px; border-radius: 8px; box-shadow: 0 2px 5px rgba(0,0,0,0.05); margin-bottom: 15px; }"
-".btn { display: inline-block; padding: 12px 20px; font-size: 16px; font-weight: bold; color: white; text-decoration: none; border-radius: 5px; border: none; cursor: pointer; text-align: center; -webkit-appearance: none; margin: 5px 0; }"
-".btn-green { background-color: #28a745; width: 48%; }"
-".btn-red { background-color: #dc3545; width: 48%; }"
-".btn-blue { background-color: #007bff; width: 100%; margin-top: 10px; }"
-".btn-orange { background-color: #fd7e14; width: 100%; margin-top: 5px; }"
-".btn-gray { background-color: #6c757d; font-size: 14px; padding: 8px 12px; }"
-"input[type=number], input[type=text] { padding: 10px; font-size: 16px; border: 1px solid #ccc; border-radius: 4px; width: 60px; text-align: center; margin: 2px; }"
-"input[type=checkbox] { transform: scale(1.5); margin: 5px; }"
-"table { width: 100%; border-collapse: collapse; margin-top: 10px; }"
-"th { text-align: left; background: #eee; padding: 10px; }"
-"td { padding: 10px 5px; border-bottom: 1px solid #eee; vertical-align: middle; }"
-".day-label { display: inline-block; padding: 6px 8px; background: #eef; border-radius: 4px; margin: 2px; font-size: 12px; cursor: pointer; }"
-".nav { margin-top: 20px; padding-top: 10px; border-top: 1px solid #ccc; text-align: center; }"
-".nav a { color: #007bff; text-decoration: none; margin: 0 8px; font-weight: bold; font-size: 14px; display:inline-block; padding:5px; }"
-".progress-bg { background-color: #e9ecef; border-radius: 5px; height: 20px; width: 100%; margin: 10px 0; overflow: hidden; }"
-".progress-fill { height: 100%; text-align: center; color: white; font-size: 12px; line-height: 20px; transition: width 0.5s; }"
-".val { font-family: monospace; font-weight: bold; color: #0056b3; }"
-"</style>";
-
-String getNavFooter() {
-    String h = "<div class='nav'>";
-    h += "<a href='/'>Dashboard</a> | ";
-    h += "<a href='/schedule'>Schedule</a> | ";
-    h += "<a href='/mqtt_config'>MQTT</a> | ";
-    h += "<a href='/diag'>Diag</a> | ";
-    h += "<a href='/diag.json' target='_blank'>JSON</a> | ";
-    h += "<a href='/update'>OTA</a>";
-    h += "<br><br>";
-    h += "<form action='/restart' method='POST'><input type='submit' value='Reboot Device' class='btn-gray'></form>";
-    h += "</div>";
-    return h;
+// === ROUTEN-STATISTIK (Latenz-Histogramm, Bytes, Fehler) ===
+// Feste Buckets, keine Allokation. Gemessen mit dem CPU-Zykluszähler;
+// nur bei sehr langen Requests (> 20 s, Zähler läuft über) mit millis().
+enum HttpRoute : uint8_t {
+    R_UI, R_API_STATE, R_API_SCHEDULE, R_API_LOG, R_EVENTS, R_API_CONFIG, R_LEGACY,
+    R_SCHEDULE_SAVE, R_VALVE, R_SET_AUTO, R_SETTINGS, R_MQTT_SETTINGS, R_DIAG_JSON,
+    R_RESTART, R_CLEAR_DIAG, R_API_STATUS, R_UPDATE_GET, R_UPDATE_POST, R_METRICS,
+    R_API_RULES_GET, R_API_RULES_POST, R_API_QUEUE, R_ALARM_RESET, R_API_RUNS,
+    R_API_HISTORY,
+    R_COUNT
+};
+
+static const char* const ROUTE_NAMES[R_COUNT] = {
+    "ui", "api_state", "api_schedule", "api_log", "events", "api_config", "legacy",
+    "schedule_save", "valve", "set_auto", "settings", "mqtt_settings", "diag_json",
+    "restart", "clear_diag", "api_status", "update_get", "update_post", "metrics",
+    "api_rules_get", "api_rules_post", "api_queue", "alarm_reset", "api_runs",
+    "api_history"
+};
+
+// Obergrenzen in µs, letzter Bucket = darüber
+static const uint32_t HTTP_BUCKET_US[] = { 1000, 2000, 5000, 10000, 20000, 50000, 100000, 250000, 1000000 };
+static const int HTTP_BUCKETS = sizeof(HTTP_BUCKET_US) / sizeof(HTTP_BUCKET_US[0]) + 1;
+
+struct RouteStats {
+    uint32_t count;
+    uint32_t errors;     // Status >= 400
+    uint32_t bytes;      // Antwort-Body
+    uint32_t maxUs;
+    uint64_t totalUs;
+    uint32_t hist[HTTP_BUCKETS];
+};
+
+// Geschrieben nur im Web-Task, gelesen auch vom Haupt-Loop (MQTT-Publish):
+// Sequenzzähler je Route wie beim Snapshot (ungerade = wird geschrieben),
+// Leser kopieren mit routeStatsGet()
+static RouteStats routeStats[R_COUNT];
+static std::atomic<uint32_t> routeSeq[R_COUNT];
+static uint32_t cpuMhz = 160;
+
+// Vom aktuellen Request gesetzt (nur im Web-Task benutzt)
+static int curStatus = 0;
+static uint32_t curBytes = 0;
+
+static void httpRecord(HttpRoute r, uint32_t us) {
+    RouteStats &st = routeStats[r];
+    routeSeq[r].fetch_add(1, std::memory_order_relaxed);       // ungerade: in Arbeit
+    std::atomic_thread_fence(std::memory_order_release);
+    st.count++;
+    st.totalUs += us;
+    if (us > st.maxUs) st.maxUs = us;
+    if (curStatus >= 400) st.errors++;
+    st.bytes += curBytes;
+    int b = 0;
+    while (b < HTTP_BUCKETS - 1 && us >= HTTP_BUCKET_US[b]) b++;
+    st.hist[b]++;
+    routeSeq[r].fetch_add(1, std::memory_order_release);       // gerade: fertig
+}
+
+static void routeStatsGet(int r, RouteStats &out) {
+    for (;;) {
+        uint32_t s1 = routeSeq[r].load(std::memory_order_acquire);
+        if (s1 & 1) continue;
+        out = routeStats[r];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (routeSeq[r].load(std::memory_order_relaxed) == s1) return;
+    }
+}
+
+static WebServer::THandlerFunction timed(HttpRoute r, void (*fn)()) {
+    return [r, fn]() {
+        curStatus = 0;
+        curBytes = 0;
+        uint32_t c0 = esp_cpu_get_cycle_count();
+        unsigned long m0 = millis();
+        fn();
+        uint32_t dc = esp_cpu_get_cycle_count() - c0;
+        unsigned long dm = millis() - m0;
+        httpRecord(r, (dm > 20000) ? dm * 1000UL : dc / cpuMhz);
+    };
+}
+
+static void webSend(int code, const char* type, const String &body) {
+    curStatus = code;
+    curBytes += body.length();
+    server.send(code, type, body);
+}
+
+// === KOMMANDO-QUEUE (Web-Task -> Haupt-Loop) ===
+enum class WebCmdType : uint8_t {
+    VALVE_OPEN,
+    VALVE_CLOSE,
+    SET_AUTO,
+    SLOT_UPDATE,
+    SLOTS_SAVE,
+    SET_LIMIT,
+    SET_BAT_MIN,
+    SET_BAT_FACTOR,
+    SET_FLOW_K,
+    SET_LEAK_SENS,
+    SET_REBOOT_H,
+    SET_MQTT_HOST,
+    SET_MQTT_PORT,
+    CLEAR_DIAG,
+    RESTART,
+    RULES_APPLY,
+    ALARM_RESET
+};
+
+struct WebCommand {
+    WebCmdType type;
+    int index;
+    int iVal;
+    float fVal;
+    IrrigationSlot slot;
+    char text[64];
+};
+
+static const int WEB_CMD_QUEUE_LEN = 16;
+static const uint32_t WEB_TASK_STACK = 8192;
+static QueueHandle_t cmdQueue = nullptr;
+static TaskHandle_t webTaskHandle = nullptr;
+
+// Regeln sind zu groß für die Queue: Web-Task parst in diesen Puffer,
+// der Haupt-Loop übernimmt ihn bei RULES_APPLY und gibt ihn wieder frei.
+static RuleSpec rulesStaging[MAX_RULES];
+static int rulesStagingCount = 0;
+static std::atomic<bool> rulesStagingBusy(false);
+
+static bool webPost(WebCommand cmd) {
+    if (xQueueSend(cmdQueue, &cmd, pdMS_TO_TICKS(50)) != pdTRUE) {
+        logWarn("Web command queue full");
+        return false;
+    }
+    return true;
+}
+
+static bool webPostInt(WebCmdType type, int v) {
+    WebCommand c = {};
+    c.type = type;
+    c.iVal = v;
+    return webPost(c);
+}
+
+static bool webPostFloat(WebCmdType type, float v) {
+    WebCommand c = {};
+    c.type = type;
+    c.fVal = v;
+    return webPost(c);
+}
+
+// Läuft im Haupt-Loop: einzige Stelle, an der Web-Aktionen Module verändern
+static void webExecute(const WebCommand &c) {
+    switch (c.type) {
+        case WebCmdType::VALVE_OPEN:
+            runlogNoteSource(RunSource::WEB);
+            irrigationSetMode(IrrigationMode::MANUAL);
+            valveSet(ValveState::OPEN);
+            break;
+        case WebCmdType::VALVE_CLOSE:
+            runlogNoteStop(RunStop::WEB);
+            irrigationCancelRun("valve closed via web");
+            irrigationSetMode(IrrigationMode::MANUAL);
+            valveSet(ValveState::CLOSED);
+            break;
+        case WebCmdType::SET_AUTO:
+            irrigationSetMode(IrrigationMode::AUTO);
+            logInfo("Manual Override: Reset to AUTO Mode");
+            break;
+        case WebCmdType::SLOT_UPDATE:    irrigationUpdateSlot(c.index, c.slot); break;
+        case WebCmdType::SLOTS_SAVE:     irrigationSaveToFlash(); break;
+        case WebCmdType::SET_LIMIT:      settingsSetDailyLimitSec(c.iVal); break;
+        case WebCmdType::SET_BAT_MIN:    settingsSetBatMin(c.fVal); break;
+        case WebCmdType::SET_BAT_FACTOR: settingsSetBatFactor(c.fVal); break;
+        case WebCmdType::SET_FLOW_K:     settingsSetFlowFactor(c.fVal); break;
+        case WebCmdType::SET_LEAK_SENS:  settingsSetLeakSensitivity(c.iVal); break;
+        case WebCmdType::SET_REBOOT_H:   settingsSetRebootHour(c.iVal); break;
+        case WebCmdType::SET_MQTT_HOST:  settingsSetMqttHost(String(c.text)); break;
+        case WebCmdType::SET_MQTT_PORT:  settingsSetMqttPort(c.iVal); break;
+        case WebCmdType::CLEAR_DIAG:     logSetLastDiag("OK"); break;
+        case WebCmdType::RESTART:        mqttGracefulRestart(); break;
+        case WebCmdType::RULES_APPLY:
+            rulesSet(rulesStaging, rulesStagingCount);
+            rulesStagingBusy = false;
+            break;
+        case WebCmdType::ALARM_RESET:    guardReset(); break;
+    }
 }
 
 static void addNoCacheHeaders() {
@@ -72,345 +230,588 @@ static void addNoCacheHeaders() {
 static bool checkAuth() {
     if (String(OTA_USER).length() == 0) return true;
     if (!server.authenticate(OTA_USER, OTA_PASS)) {
+        curStatus = 401;
         server.requestAuthentication();
         return false;
     }
     return true;
 }
 
+static void redirectHome() {
+    server.sendHeader("Location", "/", true);
+    webSend(302, "text/plain", "Redirecting");
+}
+
+static void sendBusy() {
+    webSend(503, "text/plain", "Busy, try again");
+}
+
+// HH:MM:SS aus der Snapshot-Zeit (wie timeGetStr())
+static String snapTimeStr(const DeviceSnapshot &s) {
+    if (!s.timeValid) return "--:--:--";
+    struct tm ti;
+    clockLocal(s.epoch, ti);
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%02d:%02d:%02d", ti.tm_hour, ti.tm_min, ti.tm_sec);
+    return String(buf);
+}
+
+// "Mo 06:00 #2" für den nächsten geplanten Start, "-" wenn keiner
+static String snapNextRunStr(const DeviceSnapshot &s) {
+    if (s.nextRunEpoch == 0) return "-";
+    static const char* DAYS[] = { "So", "Mo", "Di", "Mi", "Do", "Fr", "Sa" };
+    struct tm ti;
+    clockLocal(s.nextRunEpoch, ti);
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%s %02d:%02d #%d", DAYS[ti.tm_wday], ti.tm_hour, ti.tm_min, s.nextRunSlot + 1);
+    return String(buf);
+}
+
+static const char* modeStr(const DeviceSnapshot &s) {
+    return s.mode == IrrigationMode::AUTO ? "AUTO" : "MANUAL";
+}
+
+static const char* valveStr(const DeviceSnapshot &s) {
+    return s.valve == ValveState::OPEN ? "OPEN" : "CLOSED";
+}
+
+// {"n":..,"err":..,"bytes":..,"avg_us":..,"max_us":..,"h":[..]} - Bucket-Grenzen siehe "h_us"
+static String webRouteStatsJson(const RouteStats &st) {
+    String j = "{\"n\":" + String(st.count);
+    j += ",\"err\":" + String(st.errors);
+    j += ",\"bytes\":" + String(st.bytes);
+    j += ",\"avg_us\":" + String(st.count ? (unsigned long)(st.totalUs / st.count) : 0UL);
+    j += ",\"max_us\":" + String(st.maxUs);
+    j += ",\"h\":[";
+    for (int b = 0; b < HTTP_BUCKETS; b++) {
+        if (b > 0) j += ",";
+        j += String(st.hist[b]);
+    }
+    j += "]}";
+    return j;
+}
+
 static String buildDiagJson() {
+    DeviceSnapshot s;
+    snapshotGet(s);
     String j = "{";
     j += "\"fw\":\"" + String(FW_VERSION) + "\",";
-    j += "\"uptime_s\":" + String(millis()/1000) + ",";
-    j += "\"heap_free\":" + String(ESP.getFreeHeap()) + ",";
-    j += "\"time_valid\":" + String(timeIsValid()?"true":"false") + ",";
-    j += "\"vbat\":" + String(batteryGetVoltage(), 2) + ",";
-    j += "\"vbat_raw\":" + String(batteryGetRawValue(), 3) + ",";
-    j += "\"flow_lpm\":" + String(flowGetLpm(), 2) + ",";
-    j += "\"valve\":\"" + String(valveGetState()==ValveState::OPEN?"OPEN":"CLOSED") + "\",";
-    j += "\"mqtt_queue\":" + String(mqttGetQueueSize());
-    j += "}";
+    j += "\"uptime_s\":" + String(s.uptimeMs/1000) + ",";
+    j += "\"heap_free\":" + String(s.heapFree) + ",";
+    j += "\"time\":\"" + snapTimeStr(s) + "\",";
+    j += "\"time_valid\":" + String(s.timeValid?"true":"false") + ",";
+    j += "\"irr_mode\":\"" + String(modeStr(s)) + "\",";
+    j += "\"last_diag\":\"" + String(s.lastDiag) + "\",";
+    j += "\"vbat\":" + String(s.batV, 2) + ",";
+    j += "\"vbat_raw\":" + String(s.batRawV, 3) + ",";
+    j += "\"flow_lpm\":" + String(s.flowLpm, 2) + ",";
+    j += "\"flow_runon_l\":" + String(s.flowRunOnL, 2) + ",";
+    j += "\"valve\":\"" + String(valveStr(s)) + "\",";
+    j += "\"mqtt_connected\":" + String(s.mqttConnected?"true":"false") + ",";
+    j += "\"mqtt_err\":\"" + String(s.mqttState) + "\",";
+    j += "\"mqtt_rec_age_s\":" + String(s.mqttReconnectAgeMs == 0 ? -1L : (long)(s.mqttReconnectAgeMs/1000)) + ",";
+    j += "\"mqtt_queue\":" + String(s.mqttQueue) + ",";
+    j += "\"hist_points\":" + String(s.histPoints) + ",";
+    j += "\"hist_bytes\":" + String(s.histBytes) + ",";
+    j += "\"loop_avg_us\":" + String(s.loopAvgUs) + ",";
+    j += "\"loop_max_us\":" + String(s.loopMaxUs) + ",";
+    j += "\"web_cmd_queue\":" + String((unsigned long)uxQueueMessagesWaiting(cmdQueue)) + ",";
+    j += "\"web_stack_free\":" + String((unsigned long)uxTaskGetStackHighWaterMark(webTaskHandle)) + ",";
+    j += "\"sse_clients\":" + String(sseGetClientCount()) + ",";
+    j += "\"sse_coalesced\":" + String(sseGetCoalescedCount()) + ",";
+    j += "\"ota_pending_verify\":" + String(otaIsPendingVerify() ? "true" : "false") + ",";
+    j += "\"ota_sha256\":\"" + otaGetSha256() + "\",";
+    j += "\"ota_error\":\"" + String(otaGetError()) + "\",";
+    j += "\"zones\":" + snapshotZonesJson(s) + ",";
+    j += "\"guard\":" + snapshotGuardJson(s) + ",";
+    j += "\"leak\":" + snapshotLeakJson(s) + ",";
+    j += "\"sig\":" + snapshotSigJson(s) + ",";
+    j += "\"http\":{\"h_us\":[";
+    for (int b = 0; b < HTTP_BUCKETS - 1; b++) {
+        if (b > 0) j += ",";
+        j += String(HTTP_BUCKET_US[b]);
+    }
+    j += "]";
+    for (int r = 0; r < R_COUNT; r++) {
+        RouteStats st;
+        routeStatsGet(r, st);
+        if (st.count == 0) continue;
+        j += ",\"" + String(ROUTE_NAMES[r]) + "\":" + webRouteStatsJson(st);
+    }
+    j += "}}";
     return j;
 }
 
-static void handleDiag() {
+// === API JSON HANDLER ===
+static void handleDiagJson() {
     if (!checkAuth()) return;
     addNoCacheHeaders();
+    webSend(200, "application/json", buildDiagJson());
+}
 
-    String html;
-    html.reserve(6000); 
-    html += F("<!DOCTYPE html><html><head><meta name='viewport' content='width=device-width, initial-scale=1'>");
-    html += COMMON_CSS; 
-    html += F("</head><body><h1>Deep Diagnostics</h1>");
-
-    html += F("<div class='card'><h2>System & Time</h2>");
-    html += "FW Version: <span class='val'>" + String(FW_VERSION) + "</span><br>";
-    html += "Local Time: <span class='val'>" + timeGetStr() + "</span>";
-    html += timeIsValid() ? " <b style='color:green'>(NTP OK)</b><br>" : " <b style='color:red'>(NOT SYNCED)</b><br>";
-    html += "Irrigation Mode: <span class='val'>" + String(irrigationGetMode()==IrrigationMode::AUTO ? "AUTO" : "MANUAL") + "</span><br>";
-    html += "Uptime: <span class='val'>" + String(millis()/1000) + " s</span><br>";
-    html += "Free Heap: <span class='val'>" + String(ESP.getFreeHeap()) + " bytes</span><br>";
-    html += "Last Diag Msg: <b>" + logGetLastDiag() + "</b>";
-    html += F("</div>");
-
-    html += F("<div class='card'><h2>MQTT Internals</h2>");
-    html += "Connected: ";
-    html += mqttIsConnected() ? "<b style='color:green'>YES</b><br>" : "<b style='color:red'>NO</b><br>";
-    html += "State Code: <span class='val'>" + mqttGetStateString() + "</span><br>";
-    html += "Last Error: <span class='val'>" + mqttGetLastError() + "</span><br>";
-    html += "Outbound Queue: <span class='val'>" + String(mqttGetQueueSize()) + " items</span><br>";
-    unsigned long recAge = mqttGetLastReconnectMs();
-    String recStr = (recAge == 0) ? "Never" : (String(recAge/1000) + " s ago");
-    html += "Last Attempt: <span class='val'>" + recStr + "</span>";
-    html += F("</div>");
-
-    html += F("<div class='card'><h2>Logs</h2><table style='font-size:12px;color:#004488;'>");
-    html += logGetFlowEventsHtml(); 
-    html += F("</table><br><table style='font-size:12px;'>");
-    html += logGetEventsHtml(); 
-    html += F("</table></div>");
-    
-    html += getNavFooter();
-    html += F("</body></html>");
-    server.send(200, "text/html", html);
+// === /metrics (OpenMetrics, chunked gestreamt) ===
+static void sendChunk(const String &chunk) {
+    curBytes += chunk.length();
+    server.sendContent(chunk);
 }
 
-// === API JSON HANDLER ===
-static void handleDiagJson() {
+static void handleMetrics() {
     if (!checkAuth()) return;
     addNoCacheHeaders();
-    server.send(200, "application/json", buildDiagJson());
+    curStatus = 200;
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, METRICS_CONTENT_TYPE, "");
+    metricsRender(sendChunk);
+    server.sendContent("");
+}
+
+// === /api/runs?since=&after=&limit= (Lauf-Protokoll, gestreamt aus dem Flash) ===
+// since = Start-Epoch ab, after = letzte id der vorigen Seite ("next")
+struct RunsPage {
+    String   buf;       // ~1 KB sammeln, dann ein Chunk
+    uint32_t lastId;
+};
+
+static void runsAdd(const RunRecord &r, void* ctx) {
+    RunsPage &p = *(RunsPage*)ctx;
+    if (p.lastId != 0) p.buf += ",";
+    p.buf += runlogRecordJson(r);
+    p.lastId = r.id;
+    if (p.buf.length() >= 1024) {
+        sendChunk(p.buf);
+        p.buf = "";
+    }
+}
+
+static void handleApiRuns() {
+    if (!checkAuth()) return;
+    addNoCacheHeaders();
+    uint32_t since = strtoul(server.arg("since").c_str(), nullptr, 10);
+    uint32_t after = strtoul(server.arg("after").c_str(), nullptr, 10);
+    long limit = server.hasArg("limit") ? server.arg("limit").toInt() : RUNLOG_PAGE_DEFAULT;
+    if (limit <= 0) limit = RUNLOG_PAGE_DEFAULT;
+    if (limit > RUNLOG_PAGE_MAX) limit = RUNLOG_PAGE_MAX;
+
+    curStatus = 200;
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "application/json", "");
+    RunsPage p;
+    p.buf = "{\"runs\":[";
+    p.lastId = 0;
+    bool more;
+    int n = runlogQuery(since, after, limit, runsAdd, &p, more);
+    p.buf += "],\"count\":" + String(n) + ",\"more\":" + String(more ? "true" : "false");
+    p.buf += ",\"next\":" + String(n ? p.lastId : after);
+    p.buf += ",\"stored\":" + String(runlogStored()) + ",\"capacity\":" + String(runlogCapacity()) + "}";
+    sendChunk(p.buf);
+    server.sendContent("");
+}
+
+// === /api/history (Verlauf roh: je Block u16 Länge little endian + tscodec-Block) ===
+// Dekodieren auf dem PC: tools/tsc_tool.cpp decode
+static void historySendBlock(const uint8_t* block, size_t len, void*) {
+    uint8_t hdr[2] = { (uint8_t)(len & 0xFF), (uint8_t)(len >> 8) };
+    server.sendContent((const char*)hdr, sizeof(hdr));
+    server.sendContent((const char*)block, len);
+    curBytes += sizeof(hdr) + len;
+}
+
+static void handleApiHistory() {
+    if (!checkAuth()) return;
+    addNoCacheHeaders();
+    curStatus = 200;
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "application/octet-stream", "");
+    historyForEachBlock(historySendBlock, nullptr);
+    server.sendContent("");
 }
 
 static String buildStatusJson() {
+    DeviceSnapshot s;
+    snapshotGet(s);
     String json = "{";
     json += "\"fw\":\"" + String(FW_VERSION) + "\",";
     json += "\"device\":\"" + String(DEVICE_NAME) + "\",";
-    json += "\"wifi_ip\":\"" + wifiGetIp() + "\",";
-    json += "\"wifi_rssi\":" + String(wifiGetRssi()) + ",";
-    json += "\"valve\":\"" + String(valveGetState() == ValveState::OPEN ? "OPEN" : "CLOSED") + "\",";
-    json += "\"flow_lpm\":" + String(flowGetLpm(), 2) + ",";
-    json += "\"flow_total_l\":" + String(flowGetTotalLiters(), 2) + ",";
-    json += "\"battery_v\":" + String(batteryGetVoltage(), 2) + ",";
-    json += "\"last_diag\":\"" + logGetLastDiag() + "\",";
-    json += "\"daily_limit_sec\":" + String(settingsGetDailyLimitSec()) + ",";
-    json += "\"daily_usage_sec\":" + String(valveGetDailyOpenSec()) + ",";
-    json += "\"irr_mode\":\"" + String(irrigationGetMode() == IrrigationMode::AUTO ? "AUTO" : "MANUAL") + "\",";
-    json += "\"irr_running\":" + String(irrigationIsRunning() ? "true" : "false") + ",";
-    IrrigationSlot slots[MAX_PROGRAM_SLOTS];
-    irrigationGetSlots(slots);
-    int activeCount = 0;
-    for(int i=0; i<MAX_PROGRAM_SLOTS; i++) if(slots[i].enabled) activeCount++;
-    json += "\"active_slots\":" + String(activeCount) + ",";
+    json += "\"wifi_ip\":\"" + String(s.ip) + "\",";
+    json += "\"wifi_rssi\":" + String(s.rssi) + ",";
+    json += "\"valve\":\"" + String(valveStr(s)) + "\",";
+    json += "\"flow_lpm\":" + String(s.flowLpm, 2) + ",";
+    json += "\"flow_total_l\":" + String(s.flowTotalL, 2) + ",";
+    json += "\"battery_v\":" + String(s.batV, 2) + ",";
+    json += "\"last_diag\":\"" + String(s.lastDiag) + "\",";
+    json += "\"daily_limit_sec\":" + String(s.dailyLimitSec) + ",";
+    json += "\"daily_usage_sec\":" + String(s.dailyOpenSec) + ",";
+    json += "\"irr_mode\":\"" + String(modeStr(s)) + "\",";
+    json += "\"irr_running\":" + String(s.irrRunning ? "true" : "false") + ",";
+    json += "\"active_slots\":" + String(s.activeSlots) + ",";
     #define GENERATE_JSON_ITEM(name, path, label) json += "\"mqtt_" #name "\":\"" + String(TOPIC_##name) + "\",";
     MQTT_TOPIC_GENERATOR(GENERATE_JSON_ITEM)
     json += "\"meta\":\"auto_generated\"}";
     return json;
 }
 
-static void handleRoot() {
+// === WEB-UI (statisch, gzip, im Browser unbegrenzt cachebar) ===
+// "private": Antwort hinter Basic-Auth, geteilte Caches/Proxies dürfen sie nicht ablegen.
+// Die Seite rendert sich im Browser aus /api/state, /api/schedule, /api/log und /api/config.
+// Nach einem FW-Update erkennt die UI die neue Version (Feld "fw") und lädt sich neu.
+static void handleUi() {
+    if (!checkAuth()) return;
+    server.sendHeader("Cache-Control", "private, max-age=31536000, immutable");
+    server.sendHeader("Content-Encoding", "gzip");
+    curStatus = 200;
+    curBytes += WEB_UI_GZ_LEN;
+    server.send_P(200, "text/html", (const char*)WEB_UI_GZ, WEB_UI_GZ_LEN);
+}
+
+// Kompakter Zustand für die UI (ca. 200 Bytes)
+static String buildStateJson() {
+    DeviceSnapshot s;
+    snapshotGet(s);
+    String json = "{";
+    json += "\"fw\":\"" FW_VERSION "\",";
+    json += "\"time\":\"" + snapTimeStr(s) + "\",";
+    json += "\"mode\":\"" + String(modeStr(s)) + "\",";
+    json += "\"ip\":\"" + String(s.ip) + "\",";
+    json += "\"rssi\":" + String(s.rssi) + ",";
+    json += "\"v\":" + String(s.valve == ValveState::OPEN ? 1 : 0) + ",";
+    json += "\"lpm\":" + String(s.flowLpm, 2) + ",";
+    json += "\"tot\":" + String(s.flowTotalL, 1) + ",";
+    json += "\"bat\":" + String(s.batV, 2) + ",";
+    json += "\"run\":" + String(s.irrRunning ? 1 : 0) + ",";
+    json += "\"rem\":" + String(s.remainingSec) + ",";
+    json += "\"tgt\":" + String(s.runTargetL, 1) + ",";
+    json += "\"dlv\":" + String(s.runDeliveredL, 1) + ",";
+    json += "\"used\":" + String(s.dailyOpenSec) + ",";
+    json += "\"lim\":" + String(s.dailyLimitSec) + ",";
+    json += "\"nxt\":\"" + snapNextRunStr(s) + "\",";
+    json += "\"q\":" + String(s.queueLen) + ",";
+    json += "\"alarm\":\"" + String(guardReasonName(s.guardReason)) + "\",";
+    json += "\"diag\":\"" + String(s.lastDiag) + "\"";
+    json += "}";
+    return json;
+}
+
+static void handleApiState() {
     if (!checkAuth()) return;
     addNoCacheHeaders();
-    String html = "<html><head><title>" DEVICE_NAME "</title><meta name='viewport' content='width=device-width, initial-scale=1'>" + String(COMMON_CSS) + "</head><body>";
-    html += "<h1>" DEVICE_NAME " (" FW_VERSION ")</h1>";
-    
-    // === NEU: HEADER MIT ZEIT UND MODE ===
-    String modeStr = (irrigationGetMode() == IrrigationMode::AUTO) ? "<span style='color:green'>AUTO</span>" : "<span style='color:orange'>MANUAL</span>";
-    html += "<div class='header-info'><span>" + timeGetStr() + "</span><span>" + modeStr + "</span></div>";
-
-    html += "<div class='card'><h2>Status</h2>";
-    html += "<p>IP: <b>" + wifiGetIp() + "</b> | RSSI: " + String(wifiGetRssi()) + " dBm</p>";
-    String vColor = (valveGetState() == ValveState::OPEN ? "green" : "black");
-    html += "<p>Valve: <b style='color:" + vColor + "; font-size:1.2rem;'>" + (valveGetState() == ValveState::OPEN ? "OPEN" : "CLOSED") + "</b></p>";
-    html += "<p>Flow: <b>" + String(flowGetLpm(), 2) + " L/min</b> | Total: " + String(flowGetTotalLiters(), 1) + " L</p>";
-    html += "<p>Battery: <b>" + String(batteryGetVoltage(), 2) + " V</b></p>";
-    
-    String diag = logGetLastDiag();
-    if (diag != "OK") { 
-        html += "<div style='background:#fdd; padding:10px; border-left:5px solid red; margin:10px 0;'>";
-        html += "<b>" + diag + "</b>";
-        html += "<form method='POST' action='/clear_diag' style='margin-top:5px;'><input type='submit' class='btn-gray' value='Acknowledge'></form></div>";
-    } else {
-        html += "<p style='color:green;'>" + diag + "</p>";
+    webSend(200, "application/json", buildStateJson());
+}
+
+// Alte Bookmarks (/schedule, /diag, /mqtt_config) auf die UI-Ansicht umleiten
+static void redirectToView(const char* view) {
+    server.sendHeader("Location", String("/#") + view, true);
+    webSend(302, "text/plain", "Moved");
+}
+
+static void handleApiSchedule() {
+    if (!checkAuth()) return;
+    addNoCacheHeaders();
+    DeviceSnapshot s;
+    snapshotGet(s);
+    String json = "[";
+    for (int i = 0; i < MAX_PROGRAM_SLOTS; i++) {
+        if (i > 0) json += ",";
+        json += "{\"en\":" + String(s.slots[i].enabled ? 1 : 0);
+        json += ",\"h\":" + String(s.slots[i].startHour);
+        json += ",\"m\":" + String(s.slots[i].startMinute);
+        json += ",\"dur\":" + String(s.slots[i].durationSec);
+        json += ",\"wd\":" + String(s.slots[i].weekDays);
+        json += ",\"z\":" + String(s.slots[i].zones ? s.slots[i].zones : 1);
+        json += ",\"vol\":" + String(s.slots[i].volumeDl / 10.0f, 1) + "}";
     }
-    html += "</div>";
+    json += "]";
+    webSend(200, "application/json", json);
+}
 
-    html += "<div class='card'><h2>Manual Control</h2>";
-    
-    // === NEU: BUTTON UM MODE AUF AUTO ZU SETZEN ===
-    if (irrigationGetMode() == IrrigationMode::MANUAL) {
-        html += "<form method='POST' action='/set_auto'><input type='submit' class='btn btn-orange' value='&#8635; Reset to AUTO Mode'></form>";
+// === LIVE PUSH (Server-Sent Events) ===
+// Die Verbindung bleibt offen und wird von sseLoop() bedient.
+static void handleEvents() {
+    if (!checkAuth()) return;
+    if (!sseAccept(server.client())) {
+        webSend(503, "text/plain", "Too many live clients");
     }
-    
-    html += "<form method='POST' action='/valve'>";
-    html += "<button name='state' value='open' class='btn btn-green'>OPEN</button> <button name='state' value='close' class='btn btn-red'>CLOSE</button></form></div>";
-    
-    html += "<a href='/schedule' class='btn btn-blue' style='padding:15px 0; font-size:18px;'>&#128197; Configure Schedule</a>";
-
-    unsigned long used = valveGetDailyOpenSec();
-    unsigned long limit = settingsGetDailyLimitSec();
-    int percent = 0; if (limit > 0) percent = (used * 100) / limit; if (percent > 100) percent = 100;
-    String barColor = (percent > 90) ? "#dc3545" : "#28a745";
-    html += "<div class='card'><h2>Usage & Settings</h2>";
-    html += "<p>Daily Usage: <b>" + String(used/60) + " min</b> / " + String(limit/60) + " min</p>";
-    html += "<div class='progress-bg'><div class='progress-fill' style='width:" + String(percent) + "%; background-color:" + barColor + ";'>" + String(percent) + "%</div></div>";
-    html += "<form method='POST' action='/settings'>";
-    html += "<p>Daily Limit (min):</p><input type='number' name='limit_min' value='" + String(settingsGetDailyLimitSec()/60) + "'>";
-    html += "<p>Auto Reboot Hour (-1 = Off):</p><input type='number' name='reb_h' value='" + String(settingsGetRebootHour()) + "'>";
-    html += "<p>Battery Min (V) / Factor:</p><input type='number' step='0.1' name='bat_min' value='" + String(settingsGetBatMin(),1) + "'> / <input type='number' step='0.01' name='bat_factor' value='" + String(settingsGetBatFactor(),2) + "'>";
-    html += "<p>Flow Factor (Imp/L):</p><input type='number' step='0.1' name='flow_k' value='" + String(settingsGetFlowFactor(),1) + "'>";
-    html += "<br><br><input type='submit' class='btn btn-blue' value='Save Settings'></form></div>";
-    
-    html += getNavFooter();
-    html += "</body></html>";
-    server.send(200, "text/html", html);
-}
-
-// ... (Restliche Handler bleiben gleich)
-
-static void handleScheduleGet() {
+}
+
+static void handleApiLog() {
     if (!checkAuth()) return;
     addNoCacheHeaders();
-    IrrigationSlot slots[MAX_PROGRAM_SLOTS];
-    irrigationGetSlots(slots);
-    String html = "<html><head><title>Schedule</title><meta name='viewport' content='width=device-width, initial-scale=1'>" + String(COMMON_CSS) + "</head><body>";
-    html += "<h1><a href='/' style='text-decoration:none; color:#333;'>&#8592;</a> Irrigation Schedule</h1>";
-    // Header Info auch hier
-    String modeStr = (irrigationGetMode() == IrrigationMode::AUTO) ? "<span style='color:green'>AUTO</span>" : "<span style='color:orange'>MANUAL</span>";
-    html += "<div class='header-info'><span>" + timeGetStr() + "</span><span>" + modeStr + "</span></div>";
-
-    html += "<form method='POST' action='/schedule_save'><div class='card' style='overflow-x:auto;'><table><tr><th>#</th><th>En</th><th>Time</th><th>Dur(s)</th><th>Days</th></tr>";
-    for(int i=0; i<MAX_PROGRAM_SLOTS; i++) {
-        String base = String(i);
-        html += "<tr" + String(i%2==0 ? " style='background:#fafafa;'" : "") + "><td><b>" + String(i+1) + "</b></td>";
-        html += "<td><input type='checkbox' name='en_" + base + "' " + (slots[i].enabled ? "checked" : "") + "></td>";
-        html += "<td style='white-space:nowrap;'><input type='number' name='h_" + base + "' min='0' max='23' value='" + String(slots[i].startHour) + "' style='width:45px'>:<input type='number' name='m_" + base + "' min='0' max='59' value='" + String(slots[i].startMinute) + "' style='width:45px'></td>";
-        html += "<td><input type='number' name='dur_" + base + "' value='" + String(slots[i].durationSec) + "' style='width:60px'></td>";
-        html += "<td>";
-        for(int d=1; d<=7; d++) {
-            int bitIndex = (d == 7) ? 0 : d; 
-            bool isSet = (slots[i].weekDays >> bitIndex) & 1;
-            html += "<label class='day-label' style='" + String(isSet ? "background:#cce5ff;border:1px solid #004085;" : "background:#eee;color:#888;") + "'>";
-            html += "<input type='checkbox' name='wd_" + base + "_" + String(bitIndex) + "' " + (isSet ? "checked" : "") + " style='margin:0; vertical-align:middle;'> " + dayNames[bitIndex] + "</label>";
-            if(d==4) html += "<br>";
-        }
-        html += "</td></tr>";
-    }
-    html += "</table></div><input type='submit' class='btn btn-blue' value='Save Schedule'></form>";
-    html += getNavFooter();
-    html += "</body></html>";
-    server.send(200, "text/html", html);
+    String json = "{\"flow\":" + logGetFlowEventsJson() + ",\"events\":" + logGetEventsJson() + "}";
+    webSend(200, "application/json", json);
 }
 
-// ... (Rest wie vorher)
+static void handleApiConfig() {
+    if (!checkAuth()) return;
+    addNoCacheHeaders();
+    DeviceSnapshot s;
+    snapshotGet(s);
+    String json = "{";
+    json += "\"device\":\"" DEVICE_NAME "\",";
+    json += "\"lim\":" + String(s.dailyLimitSec) + ",";
+    json += "\"reb\":" + String(s.rebootHour) + ",";
+    json += "\"bat_min\":" + String(s.batMin, 2) + ",";
+    json += "\"bat_factor\":" + String(s.batFactor, 2) + ",";
+    json += "\"flow_k\":" + String(s.flowFactor, 1) + ",";
+    json += "\"leak_sens\":" + String(s.leakSens) + ",";
+    json += "\"mqtt_host\":\"" + String(s.mqttHost) + "\",";
+    json += "\"mqtt_port\":" + String(s.mqttPort) + ",";
+    json += "\"zones\":" + String(VALVE_ZONES);
+    json += "}";
+    webSend(200, "application/json", json);
+}
 
 static void handleSchedulePost() {
     if (!checkAuth()) return;
+    bool ok = true;
     for (int i = 0; i < MAX_PROGRAM_SLOTS; i++) {
         String base = String(i);
         if (server.hasArg("h_" + base)) {
-            IrrigationSlot slot;
-            slot.startHour = server.arg("h_" + base).toInt();
-            slot.startMinute = server.arg("m_" + base).toInt();
-            slot.durationSec = server.arg("dur_" + base).toInt();
-            slot.enabled = (server.hasArg("en_" + base) && server.arg("en_" + base) == "on");
-            slot.weekDays = 0;
+            WebCommand c = {};
+            c.type = WebCmdType::SLOT_UPDATE;
+            c.index = i;
+            c.slot.startHour = server.arg("h_" + base).toInt();
+            c.slot.startMinute = server.arg("m_" + base).toInt();
+            c.slot.durationSec = server.arg("dur_" + base).toInt();
+            c.slot.enabled = (server.hasArg("en_" + base) && server.arg("en_" + base) == "on");
+            c.slot.zones = server.arg("z_" + base).toInt() & ((1 << VALVE_ZONES) - 1);
+            float vol = server.arg("vol_" + base).toFloat();
+            c.slot.volumeDl = (vol <= 0.0f) ? 0 : (vol > 6000.0f ? 60000 : lroundf(vol * 10.0f));
+            c.slot.weekDays = 0;
             for (int d = 0; d < 7; d++) {
                 String dParam = "wd_" + base + "_" + String(d);
-                if (server.hasArg(dParam) && server.arg(dParam) == "on") slot.weekDays |= (1 << d);
+                if (server.hasArg(dParam) && server.arg(dParam) == "on") c.slot.weekDays |= (1 << d);
             }
-            irrigationUpdateSlot(i, slot);
+            ok &= webPost(c);
         }
     }
-    irrigationSaveToFlash();
-    server.sendHeader("Location", "/schedule", true);
-    server.send(302, "text/plain", "Saved");
+    ok &= webPostInt(WebCmdType::SLOTS_SAVE, 0);
+    if (!ok) { sendBusy(); return; }
+    server.sendHeader("Location", "/#schedule", true);
+    webSend(302, "text/plain", "Saved");
 }
 
-static void handleRestart() {
+static void handleApiQueue() {
     if (!checkAuth()) return;
-    server.send(200, "text/plain", "Rebooting... Bye!");
-    delay(500);
-    mqttGracefulRestart(); 
+    addNoCacheHeaders();
+    DeviceSnapshot s;
+    snapshotGet(s);
+    webSend(200, "application/json", snapshotQueueJson(s));
 }
 
-static void handleSettingsPost() {
+static void handleApiRulesGet() {
     if (!checkAuth()) return;
-    if (server.hasArg("limit_min")) settingsSetDailyLimitSec(server.arg("limit_min").toInt() * 60); 
-    if (server.hasArg("bat_min")) settingsSetBatMin(server.arg("bat_min").toFloat());
-    if (server.hasArg("bat_factor")) settingsSetBatFactor(server.arg("bat_factor").toFloat());
-    if (server.hasArg("flow_k")) settingsSetFlowFactor(server.arg("flow_k").toFloat());
-    if (server.hasArg("reb_h")) settingsSetRebootHour(server.arg("reb_h").toInt());
-    server.sendHeader("Location", "/", true);
-    server.send(302, "text/plain", "Saved");
+    addNoCacheHeaders();
+    webSend(200, "application/json", rulesExportJson());
 }
 
-static void handleMqttConfig() {
+// Body: JSON-Array wie von GET /api/rules (ersetzt alle Regeln)
+static void handleApiRulesPost() {
     if (!checkAuth()) return;
-    addNoCacheHeaders();
-    String html = "<html><head><meta name='viewport' content='width=device-width, initial-scale=1'>" + String(COMMON_CSS) + "</head><body><h1>MQTT Setup</h1><div class='card'><form method='POST' action='/mqtt_settings'>";
-    html += "Host:<br><input type='text' name='host' value='" + settingsGetMqttHost() + "' style='width:100%'><br><br>";
-    html += "Port:<br><input type='number' name='port' value='" + String(settingsGetMqttPort()) + "' style='width:100px'><br><br>";
-    html += "<input type='submit' class='btn btn-blue' value='Save & Reboot'></form></div>";
-    html += getNavFooter();
-    html += "</body></html>";
-    server.send(200, "text/html", html);
+    if (rulesStagingBusy.exchange(true)) { sendBusy(); return; }
+
+    String err;
+    int n = rulesParseJson(server.arg("plain"), rulesStaging, MAX_RULES, err);
+    if (n < 0 || !rulesValidate(rulesStaging, n, err)) {
+        rulesStagingBusy = false;
+        webSend(400, "text/plain", err);
+        return;
+    }
+    rulesStagingCount = n;
+    if (!webPostInt(WebCmdType::RULES_APPLY, 0)) {
+        rulesStagingBusy = false;
+        sendBusy();
+        return;
+    }
+    webSend(200, "application/json", "{\"rules\":" + String(n) + "}");
+}
+
+static void handleRestart() {
+    if (!checkAuth()) return;
+    webSend(200, "text/plain", "Rebooting... Bye!");
+    webPostInt(WebCmdType::RESTART, 0);
+}
+
+static void handleSettingsPost() {
+    if (!checkAuth()) return;
+    bool ok = true;
+    if (server.hasArg("limit_min")) ok &= webPostInt(WebCmdType::SET_LIMIT, server.arg("limit_min").toInt() * 60);
+    if (server.hasArg("bat_min")) ok &= webPostFloat(WebCmdType::SET_BAT_MIN, server.arg("bat_min").toFloat());
+    if (server.hasArg("bat_factor")) ok &= webPostFloat(WebCmdType::SET_BAT_FACTOR, server.arg("bat_factor").toFloat());
+    if (server.hasArg("flow_k")) ok &= webPostFloat(WebCmdType::SET_FLOW_K, server.arg("flow_k").toFloat());
+    if (server.hasArg("reb_h")) ok &= webPostInt(WebCmdType::SET_REBOOT_H, server.arg("reb_h").toInt());
+    if (server.hasArg("leak_sens")) ok &= webPostInt(WebCmdType::SET_LEAK_SENS, server.arg("leak_sens").toInt());
+    if (!ok) { sendBusy(); return; }
+    server.sendHeader("Location", "/", true);
+    webSend(302, "text/plain", "Saved");
 }
 
 static void handleMqttSettingsPost() {
     if (!checkAuth()) return;
-    if (server.hasArg("host")) settingsSetMqttHost(server.arg("host"));
-    if (server.hasArg("port")) settingsSetMqttPort(server.arg("port").toInt());
+    if (server.hasArg("host")) {
+        WebCommand c = {};
+        c.type = WebCmdType::SET_MQTT_HOST;
+        strncpy(c.text, server.arg("host").c_str(), sizeof(c.text) - 1);
+        webPost(c);
+    }
+    if (server.hasArg("port")) webPostInt(WebCmdType::SET_MQTT_PORT, server.arg("port").toInt());
     logInfo("MQTT settings updated via Web.");
-    server.send(200, "text/plain", "Saved. Rebooting...");
-    delay(200);
-    mqttGracefulRestart();
+    webSend(200, "text/plain", "Saved. Rebooting...");
+    webPostInt(WebCmdType::RESTART, 0);
 }
 
 static void handleClearDiagPost() {
     if (!checkAuth()) return;
-    logSetLastDiag("OK");
-    server.sendHeader("Location", "/", true);
-    server.send(302, "text/plain", "Redirecting");
+    webPostInt(WebCmdType::CLEAR_DIAG, 0);
+    redirectHome();
+}
+
+static void handleAlarmResetPost() {
+    if (!checkAuth()) return;
+    webPostInt(WebCmdType::ALARM_RESET, 0);
+    redirectHome();
 }
 
 static void handleValvePost() {
     if (!checkAuth()) return;
     if (server.hasArg("state")) {
         String s = server.arg("state");
-        irrigationSetMode(IrrigationMode::MANUAL);
-        if (s == "open") valveSet(ValveState::OPEN);
-        else valveSet(ValveState::CLOSED);
+        if (!webPostInt(s == "open" ? WebCmdType::VALVE_OPEN : WebCmdType::VALVE_CLOSE, 0)) { sendBusy(); return; }
     }
-    server.sendHeader("Location", "/", true);
-    server.send(302, "text/plain", "Redirecting");
+    redirectHome();
 }
 
 // === NEU: SET AUTO HANDLER ===
 static void handleSetAutoPost() {
     if (!checkAuth()) return;
-    irrigationSetMode(IrrigationMode::AUTO);
-    logInfo("Manual Override: Reset to AUTO Mode");
-    server.sendHeader("Location", "/", true);
-    server.send(302, "text/plain", "Redirecting");
+    webPostInt(WebCmdType::SET_AUTO, 0);
+    redirectHome();
 }
 
 static void handleApiStatus() {
     if (!checkAuth()) return;
     addNoCacheHeaders();
-    server.send(200, "application/json", buildStatusJson());
+    webSend(200, "application/json", buildStatusJson());
 }
 
 static void handleUpdateGet() {
     if (!checkAuth()) return;
     addNoCacheHeaders();
-    String html = "<html><body><h1>OTA Update</h1><form method='POST' action='/update' enctype='multipart/form-data'><input type='file' name='update'><input type='submit' value='Upload'></form></body></html>";
-    server.send(200, "text/html", html);
+    String html = "<html><body><h1>OTA Update</h1><form method='POST' action='/update' enctype='multipart/form-data'><input type='file' name='update'><input type='submit' value='Upload'></form>"
+                  "<p>SHA-256 Prüfung: POST /update?sha256=&lt;hex&gt;&amp;size=&lt;bytes&gt;</p></body></html>";
+    webSend(200, "text/html", html);
+}
+
+// Der Upload läuft im Web-Task, der Haupt-Loop (und damit der Watchdog-Feed)
+// läuft weiter. Das Ventil wird über die Queue geschlossen.
+// Optionale Query-Parameter: sha256 (Hex, wird beim Upload mitgerechnet und
+// vor dem Aktivieren geprüft) und size (Bytes, für den Fortschritt).
+static unsigned long uploadStartMs = 0;
+static OtaOwner uploadSession = OtaOwner::NONE;   // NONE = Upload abgelehnt
+
+// Upload als ein Messwert (Start bis Ende), nicht pro Chunk
+static void recordUpload(int status) {
+    curStatus = status;
+    curBytes = 0;
+    httpRecord(R_UPDATE_POST, (millis() - uploadStartMs) * 1000UL);
 }
 
 static void handleUpdatePost() {
     if (!checkAuth()) return;
     HTTPUpload &upload = server.upload();
     if (upload.status == UPLOAD_FILE_START) {
-        valveSafeBeforeUpdate();
-        if (!Update.begin()) Update.printError(Serial);
+        uploadStartMs = millis();
+        uploadSession = OtaOwner::NONE;
+        if (otaPullRunning()) {
+            // Pull-OTA schreibt gerade: dessen Image nicht anfassen
+            logWarn("OTA upload rejected: pull update running");
+            return;
+        }
+        logWarn("Safe mode: Valve CLOSE for OTA");
+        webPostInt(WebCmdType::VALVE_CLOSE, 0);
+        size_t size = server.hasArg("size") ? (size_t)server.arg("size").toInt() : 0;
+        uploadSession = otaBegin(OtaOwner::WEB, size, server.arg("sha256"));
     } else if (upload.status == UPLOAD_FILE_WRITE) {
-        if (Update.write(upload.buf, upload.currentSize) != upload.currentSize) Update.printError(Serial);
+        if (uploadSession == OtaOwner::WEB) otaWrite(OtaOwner::WEB, upload.buf, upload.currentSize);
     } else if (upload.status == UPLOAD_FILE_END) {
-        if (Update.end(true)) {
-            server.send(200, "text/html", "Update OK. Rebooting...");
-            valveSafeAfterUpdate();
-            delay(1000);
-            ESP.restart();
+        if (uploadSession != OtaOwner::WEB) {
+            webSend(409, "text/plain", "Update rejected: another update is running");
+            recordUpload(409);
+        } else if (otaFinish(OtaOwner::WEB)) {
+            webSend(200, "text/html", "Update OK (sha256 " + otaGetSha256() + "). Rebooting...");
+            recordUpload(200);
+            webPostInt(WebCmdType::RESTART, 0);
         } else {
-            server.send(500, "text/plain", "Update failed");
+            webSend(500, "text/plain", String("Update failed: ") + otaGetError());
+            recordUpload(500);
         }
     } else if (upload.status == UPLOAD_FILE_ABORTED) {
-        Update.end();
+        if (uploadSession == OtaOwner::WEB) otaAbort(OtaOwner::WEB, "upload aborted");
+        recordUpload(499);
+    }
+}
+
+static void webTask(void*) {
+    for (;;) {
+        server.handleClient();
+        sseLoop();
+        vTaskDelay(pdMS_TO_TICKS(2));
     }
 }
 
 void webInit() {
-    server.on("/",           HTTP_GET,  handleRoot);
-    server.on("/schedule",   HTTP_GET,  handleScheduleGet);
-    server.on("/schedule_save", HTTP_POST, handleSchedulePost);
-    server.on("/valve",      HTTP_POST, handleValvePost);
-    server.on("/set_auto",   HTTP_POST, handleSetAutoPost); // NEU
-    server.on("/settings",   HTTP_POST, handleSettingsPost);
-    server.on("/mqtt_config",HTTP_GET,  handleMqttConfig);
-    server.on("/mqtt_settings", HTTP_POST, handleMqttSettingsPost);
-    server.on("/diag",       HTTP_GET,  handleDiag);
-    server.on("/diag.json",  HTTP_GET,  handleDiagJson); 
-    server.on("/restart",    HTTP_POST, handleRestart);
-    server.on("/clear_diag", HTTP_POST, handleClearDiagPost);
-    server.on("/api/status", HTTP_GET,  handleApiStatus);
-    server.on("/update",     HTTP_GET,  handleUpdateGet);
+    cmdQueue = xQueueCreate(WEB_CMD_QUEUE_LEN, sizeof(WebCommand));
+
+    cpuMhz = ESP.getCpuFreqMHz();
+
+    server.on("/",           HTTP_GET,  timed(R_UI, handleUi));
+    server.on("/api/state",  HTTP_GET,  timed(R_API_STATE, handleApiState));
+    server.on("/api/schedule", HTTP_GET, timed(R_API_SCHEDULE, handleApiSchedule));
+    server.on("/api/log",    HTTP_GET,  timed(R_API_LOG, handleApiLog));
+    server.on("/events",     HTTP_GET,  timed(R_EVENTS, handleEvents));
+    server.on("/api/config", HTTP_GET,  timed(R_API_CONFIG, handleApiConfig));
+    server.on("/schedule",   HTTP_GET,  timed(R_LEGACY, [](){ redirectToView("schedule"); }));
+    server.on("/diag",       HTTP_GET,  timed(R_LEGACY, [](){ redirectToView("diag"); }));
+    server.on("/mqtt_config",HTTP_GET,  timed(R_LEGACY, [](){ redirectToView("mqtt"); }));
+    server.on("/schedule_save", HTTP_POST, timed(R_SCHEDULE_SAVE, handleSchedulePost));
+    server.on("/valve",      HTTP_POST, timed(R_VALVE, handleValvePost));
+    server.on("/set_auto",   HTTP_POST, timed(R_SET_AUTO, handleSetAutoPost)); // NEU
+    server.on("/settings",   HTTP_POST, timed(R_SETTINGS, handleSettingsPost));
+    server.on("/mqtt_settings", HTTP_POST, timed(R_MQTT_SETTINGS, handleMqttSettingsPost));
+    server.on("/diag.json",  HTTP_GET,  timed(R_DIAG_JSON, handleDiagJson));
+    server.on("/restart",    HTTP_POST, timed(R_RESTART, handleRestart));
+    server.on("/clear_diag", HTTP_POST, timed(R_CLEAR_DIAG, handleClearDiagPost));
+    server.on("/alarm_reset", HTTP_POST, timed(R_ALARM_RESET, handleAlarmResetPost));
+    server.on("/api/status", HTTP_GET,  timed(R_API_STATUS, handleApiStatus));
+    server.on("/metrics",    HTTP_GET,  timed(R_METRICS, handleMetrics));
+    server.on("/api/rules",  HTTP_GET,  timed(R_API_RULES_GET, handleApiRulesGet));
+    server.on("/api/queue",  HTTP_GET,  timed(R_API_QUEUE, handleApiQueue));
+    server.on("/api/runs",   HTTP_GET,  timed(R_API_RUNS, handleApiRuns));
+    server.on("/api/history", HTTP_GET, timed(R_API_HISTORY, handleApiHistory));
+    server.on("/api/rules",  HTTP_POST, timed(R_API_RULES_POST, handleApiRulesPost));
+    server.on("/update",     HTTP_GET,  timed(R_UPDATE_GET, handleUpdateGet));
     server.on("/update",     HTTP_POST, [](){}, handleUpdatePost);
 
     server.begin();
-    logInfo("Web/OTA server started on port 80");
+    // Gleiche Priorität wie der Arduino loopTask -> Zeitscheiben, kein Blockieren
+    xTaskCreate(webTask, "web", WEB_TASK_STACK, nullptr, 1, &webTaskHandle);
+    logInfo("Web/OTA server started on port 80 (own task)");
 }
 
+// Im Haupt-Loop: Web-Kommandos ausführen (nie blockierend)
 void webLoop() {
-    server.handleClient();
-}
\ No newline at end of file
+    WebCommand cmd;
+    while (xQueueReceive(cmdQueue, &cmd, 0) == pdTRUE) {
+        webExecute(cmd);
+    }
+}
+
+// Ein Topic pro benutzter Route (passt in den 512-Byte MQTT-Puffer)
+void webPublishRouteStats() {
+    if (!mqttIsConnected()) return;
+    for (int r = 0; r < R_COUNT; r++) {
+        RouteStats st;
+        routeStatsGet(r, st);       // Kopie vor dem JSON, der Web-Task schreibt weiter
+        if (st.count == 0) continue;
+        String topic = String(TOPIC_HTTP) + "/" + ROUTE_NAMES[r];
+        mqttPublish(topic.c_str(), webRouteStatsJson(st).c_str());
+    }
+}
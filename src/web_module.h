@@ -3,3 +3,6 @@
 
 void webInit();
 void webLoop();
+
+// Routen-Statistik (Latenz-Histogramm, Bytes, Fehler) nach <base>/http/<route>
+void webPublishRouteStats();
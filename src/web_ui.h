@@ -0,0 +1,363 @@
+// AUTO-GENERATED by tools/embed_web_ui.py from web/index.html - NICHT EDITIEREN
+#pragma once
+#include <Arduino.h>
+
+#define WEB_UI_FW "1.2.8"
+#define WEB_UI_GZ_LEN 5663
+
+static const uint8_t WEB_UI_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9d, 0x3b, 0xeb, 0x7a, 0xdb, 0xb6,
+    0x92, 0xff, 0xfd, 0x14, 0x28, 0x73, 0x1a, 0x52, 0x1b, 0x89, 0x92, 0x1c, 0x3b, 0x71, 0x25, 0x59,
+    0xfd, 0x9c, 0x38, 0x3e, 0xc9, 0xd6, 0x8e, 0x7d, 0x22, 0xa7, 0xd9, 0x6e, 0xd6, 0x9f, 0x3f, 0x88,
+    0x84, 0x24, 0xd6, 0xbc, 0x95, 0x84, 0x7c, 0x49, 0xea, 0x67, 0xd9, 0x3f, 0xfb, 0x26, 0xe7, 0xc5,
+    0x76, 0x66, 0x00, 0x92, 0xa0, 0x44, 0x29, 0x69, 0x93, 0xd6, 0x26, 0x81, 0xc1, 0xdc, 0x30, 0x37,
+    0x0c, 0x98, 0xd1, 0x0f, 0xc7, 0xe7, 0xaf, 0x2f, 0x7f, 0xbb, 0x78, 0xc3, 0x16, 0x32, 0x0a, 0xc7,
+    0x3b, 0x23, 0xfa, 0x35, 0x5a, 0x08, 0xee, 0x8f, 0x47, 0x91, 0x90, 0x9c, 0x79, 0x0b, 0x9e, 0xe5,
+    0x42, 0x1e, 0x5a, 0x4b, 0x39, 0xeb, 0x1c, 0x58, 0x7a, 0x34, 0xe6, 0x91, 0x38, 0xb4, 0x6e, 0x03,
+    0x71, 0x97, 0x26, 0x99, 0xb4, 0x98, 0x97, 0xc4, 0x52, 0xc4, 0x00, 0x75, 0x17, 0xf8, 0x72, 0x71,
+    0xe8, 0x8b, 0xdb, 0xc0, 0x13, 0x1d, 0x7a, 0x69, 0xb3, 0x20, 0x0e, 0x64, 0xc0, 0xc3, 0x4e, 0xee,
+    0xf1, 0x50, 0x1c, 0xf6, 0x2d, 0x20, 0x23, 0x03, 0x19, 0x8a, 0xf1, 0x9b, 0xc9, 0x45, 0xe7, 0x57,
+    0x1e, 0xde, 0x8a, 0x51, 0x57, 0x0d, 0xec, 0x8c, 0x72, 0xf9, 0x80, 0xbf, 0xa7, 0x89, 0xff, 0xc0,
+    0xbe, 0xb2, 0x19, 0xa0, 0xed, 0xcc, 0x78, 0x14, 0x84, 0x0f, 0x03, 0xd6, 0xe1, 0x69, 0x1a, 0x8a,
+    0x4e, 0xfe, 0x90, 0x4b, 0x11, 0xb5, 0xd9, 0xab, 0x30, 0x88, 0x6f, 0xce, 0xb8, 0x37, 0xa1, 0xf7,
+    0x13, 0x80, 0x6c, 0x33, 0x7b, 0x22, 0xe6, 0x89, 0x60, 0x1f, 0xdf, 0xd9, 0x6d, 0xf6, 0x21, 0x99,
+    0x26, 0x32, 0x69, 0xb3, 0xb7, 0x02, 0x08, 0xc8, 0xc0, 0xe3, 0x6d, 0x76, 0x94, 0x01, 0x1b, 0x6d,
+    0x96, 0xf3, 0x38, 0xef, 0xe4, 0x22, 0x0b, 0x66, 0x43, 0x96, 0x72, 0xdf, 0x0f, 0xe2, 0xf9, 0x80,
+    0xf5, 0x7b, 0xe9, 0xfd, 0x90, 0x4d, 0xb9, 0x77, 0x33, 0xcf, 0x92, 0x65, 0xec, 0x0f, 0xd8, 0x93,
+    0xd9, 0x1e, 0xfc, 0xfd, 0x69, 0x08, 0xc2, 0x85, 0x49, 0x06, 0xef, 0xcf, 0x9f, 0x3f, 0x1f, 0xb2,
+    0x88, 0xdf, 0x2b, 0xb9, 0x06, 0xec, 0xa0, 0x47, 0x6b, 0x22, 0x9e, 0xcd, 0x83, 0x78, 0xc0, 0x7a,
+    0x8c, 0x2f, 0x65, 0x32, 0x64, 0x8f, 0x3b, 0x8b, 0x7e, 0xc1, 0x7b, 0x1e, 0x7c, 0x11, 0x80, 0xdb,
+    0xdd, 0xcf, 0x44, 0x54, 0x40, 0x76, 0x80, 0x2f, 0x99, 0x44, 0x03, 0xb6, 0x8f, 0xab, 0x0b, 0xe4,
+    0x7b, 0x7b, 0x7b, 0xb4, 0x74, 0x77, 0x75, 0xe9, 0xae, 0xb9, 0x54, 0x26, 0xe9, 0x80, 0xed, 0x2a,
+    0x56, 0x93, 0xcc, 0x17, 0x59, 0x89, 0x6c, 0x37, 0xbd, 0x67, 0x79, 0x12, 0x06, 0x3e, 0x7b, 0xe2,
+    0xfb, 0x7e, 0x29, 0x58, 0x9d, 0xd8, 0xe3, 0x4e, 0x0a, 0xe8, 0x0b, 0x86, 0x61, 0x88, 0xf5, 0x86,
+    0x26, 0xb5, 0x9e, 0xfb, 0x93, 0xe2, 0x14, 0x74, 0x2b, 0x3a, 0x0b, 0x11, 0xcc, 0x17, 0x12, 0x79,
+    0x20, 0xd6, 0x5c, 0xb4, 0x0a, 0xa0, 0x18, 0xc4, 0xb3, 0x04, 0xb0, 0xd4, 0x54, 0x25, 0x7e, 0x12,
+    0x9e, 0x68, 0x50, 0xa7, 0xe2, 0x31, 0xe3, 0x7e, 0xb0, 0xcc, 0x35, 0x0f, 0x2b, 0x4a, 0xe8, 0xd3,
+    0xa0, 0x1f, 0xe4, 0x69, 0xc8, 0x61, 0x93, 0x67, 0xa1, 0x80, 0xd7, 0xdf, 0x97, 0xb9, 0x0c, 0x66,
+    0x0f, 0x1d, 0x6d, 0x56, 0x03, 0x96, 0xa7, 0x1c, 0xec, 0x69, 0x2a, 0xe4, 0x9d, 0x10, 0xb1, 0x66,
+    0xf9, 0x4e, 0xb3, 0x37, 0x4d, 0x42, 0x7f, 0x58, 0x37, 0x95, 0x28, 0x89, 0x13, 0x5a, 0x32, 0xac,
+    0xeb, 0xb2, 0x4f, 0xc2, 0x81, 0x28, 0x1e, 0xcf, 0xfc, 0x15, 0x19, 0xee, 0x16, 0x81, 0x14, 0xa6,
+    0x04, 0xfb, 0x0d, 0x12, 0x1c, 0xa8, 0xb1, 0xfb, 0x4e, 0xbe, 0xe0, 0x7e, 0x72, 0x87, 0x9b, 0x8e,
+    0x8a, 0x47, 0x4d, 0x66, 0xf3, 0x29, 0x77, 0x7a, 0x6d, 0xfa, 0xeb, 0xf6, 0xf6, 0x5b, 0x1b, 0x24,
+    0x05, 0xe2, 0x53, 0x19, 0x03, 0xed, 0x52, 0xe4, 0x20, 0x26, 0x6d, 0x4f, 0xc3, 0xc4, 0xbb, 0x31,
+    0xe9, 0x23, 0x62, 0xb5, 0xd5, 0xa6, 0x0c, 0x2f, 0xca, 0x81, 0xba, 0xfc, 0xda, 0x8e, 0xb4, 0x14,
+    0x4d, 0x8a, 0x57, 0x63, 0x03, 0x16, 0x27, 0x31, 0x40, 0x78, 0xcb, 0x2c, 0xc7, 0x05, 0x69, 0x12,
+    0x80, 0x8e, 0xb3, 0xe1, 0xaa, 0x55, 0x28, 0x3e, 0x3b, 0xf3, 0x0c, 0x14, 0xbe, 0xba, 0xdb, 0xbb,
+    0x07, 0xfc, 0xe5, 0xde, 0xfe, 0x90, 0x69, 0x3f, 0xd8, 0x3b, 0xf8, 0xb1, 0x84, 0xcf, 0xc4, 0xaa,
+    0x5e, 0x9f, 0xf8, 0xde, 0xf3, 0xfd, 0x0d, 0xd0, 0xd3, 0x70, 0x29, 0x56, 0xc1, 0x7b, 0xbd, 0x97,
+    0xd3, 0xd9, 0xac, 0x04, 0xef, 0xf7, 0x7a, 0x3f, 0xd6, 0xcd, 0x5f, 0x99, 0x96, 0xc6, 0x90, 0x64,
+    0x3c, 0x9e, 0xaf, 0xe1, 0x98, 0xf9, 0x2f, 0x45, 0x7f, 0x6f, 0x0b, 0x0e, 0x63, 0x2b, 0x40, 0x44,
+    0xfe, 0xb0, 0x8a, 0xe0, 0x85, 0xf7, 0x72, 0xff, 0xe5, 0x06, 0xad, 0x16, 0x1a, 0x6c, 0xd2, 0xb1,
+    0xb9, 0x53, 0x7b, 0x38, 0x50, 0x6e, 0x27, 0x58, 0x0e, 0x6d, 0x69, 0x83, 0xe6, 0x1f, 0x77, 0x82,
+    0x38, 0x5d, 0xca, 0xcf, 0xf2, 0x21, 0x15, 0x87, 0xf1, 0x32, 0x9a, 0x8a, 0xec, 0x0a, 0xa3, 0x66,
+    0x39, 0x26, 0xc5, 0xbd, 0xbc, 0x02, 0x16, 0x57, 0xbc, 0x6b, 0xcd, 0x2c, 0x0a, 0xfe, 0xfa, 0x55,
+    0x2c, 0xf0, 0x3c, 0x6f, 0x8d, 0x53, 0x62, 0x4c, 0xab, 0xe6, 0x05, 0x61, 0x42, 0x02, 0x1d, 0x1e,
+    0x06, 0x73, 0xd8, 0x7f, 0x4f, 0xd4, 0xed, 0x61, 0x57, 0xa9, 0xca, 0x60, 0xc7, 0x5b, 0x08, 0xef,
+    0x06, 0x9c, 0x00, 0x59, 0x92, 0xa0, 0xff, 0x7c, 0x96, 0x64, 0x60, 0xdf, 0x14, 0xde, 0x1d, 0x88,
+    0x75, 0xad, 0x9a, 0x31, 0xe1, 0x62, 0xc9, 0xa7, 0x21, 0x6e, 0x52, 0x6d, 0x3f, 0x34, 0x57, 0xa0,
+    0xe2, 0x90, 0xa7, 0x39, 0x08, 0x51, 0x3c, 0x35, 0x6f, 0xb7, 0x5c, 0x20, 0x39, 0x83, 0xd1, 0x50,
+    0xcc, 0xe4, 0x4a, 0xc4, 0x16, 0x42, 0xac, 0xc5, 0x20, 0x58, 0xe9, 0x9b, 0xba, 0x3b, 0x50, 0xfe,
+    0xba, 0x16, 0x40, 0x0d, 0xa5, 0x11, 0x9a, 0x5b, 0x91, 0x61, 0xd6, 0x08, 0x0b, 0x72, 0x51, 0xe0,
+    0xfb, 0xa1, 0x20, 0xab, 0xf1, 0xf9, 0x43, 0x27, 0xe4, 0x53, 0x11, 0x7e, 0x87, 0x1b, 0xc3, 0xc6,
+    0xe8, 0xa8, 0xb1, 0xc6, 0x68, 0x11, 0xfa, 0x0f, 0x0e, 0x0e, 0x9a, 0xf7, 0xa8, 0xb6, 0x05, 0xe6,
+    0x6e, 0xeb, 0x3d, 0xa9, 0x18, 0x71, 0x93, 0x35, 0x27, 0xf5, 0x3c, 0xb1, 0x8f, 0x7e, 0x54, 0xcb,
+    0x5e, 0x0d, 0x16, 0xd2, 0xeb, 0xed, 0xf5, 0x0e, 0xf6, 0x09, 0x5d, 0xcc, 0x6f, 0xcb, 0xf4, 0x60,
+    0xa6, 0x9a, 0x22, 0x97, 0x18, 0xfb, 0xa1, 0xd9, 0x55, 0x23, 0x2b, 0xe6, 0xd6, 0x64, 0x4d, 0x1a,
+    0x3b, 0x07, 0xfc, 0x05, 0x43, 0x85, 0xa3, 0x13, 0xb8, 0x2f, 0x3c, 0x70, 0x65, 0x19, 0x24, 0x71,
+    0xe1, 0x5e, 0x55, 0x5a, 0x3d, 0xd8, 0x10, 0xf2, 0xd6, 0x9c, 0xed, 0x5b, 0x7b, 0x51, 0x78, 0x7d,
+    0x9a, 0x25, 0x10, 0xd7, 0xf2, 0xbc, 0x33, 0x9d, 0x6f, 0x4a, 0x64, 0x4d, 0xce, 0x5d, 0xe4, 0xc3,
+    0xdd, 0x5a, 0xda, 0x47, 0x7d, 0x60, 0xc0, 0x4c, 0xc0, 0x60, 0x66, 0x21, 0xe6, 0x84, 0x05, 0x58,
+    0x0a, 0x66, 0x29, 0x93, 0xd2, 0x2c, 0x08, 0xd1, 0x5a, 0xca, 0x94, 0x4a, 0x1e, 0xd0, 0xa4, 0xa8,
+    0x7a, 0xc4, 0x59, 0xdb, 0xf4, 0x5a, 0x62, 0x56, 0x8c, 0x90, 0x0b, 0x06, 0x4a, 0x75, 0xe4, 0x60,
+    0x90, 0xc6, 0xf7, 0x73, 0x22, 0x7f, 0xcb, 0xc3, 0xd5, 0x2a, 0x6a, 0x35, 0x35, 0x36, 0x66, 0x11,
+    0xd8, 0x9b, 0xfd, 0x17, 0xd3, 0xe7, 0x84, 0x83, 0x87, 0x3c, 0x8b, 0xd6, 0x03, 0xac, 0xbf, 0x29,
+    0xd9, 0xa3, 0x5b, 0xaa, 0x2c, 0xa2, 0x6c, 0x02, 0x32, 0xc2, 0xba, 0xb2, 0x00, 0x6f, 0x98, 0xcc,
+    0x19, 0x79, 0xe6, 0x9a, 0x8c, 0x25, 0x5e, 0xcc, 0x80, 0x7b, 0x7a, 0xcf, 0x40, 0xa9, 0xc2, 0x74,
+    0x37, 0x65, 0x24, 0x8f, 0x3b, 0xa3, 0xae, 0x2a, 0x19, 0x47, 0x5d, 0x2a, 0x5a, 0x77, 0x46, 0x58,
+    0x3a, 0x62, 0x21, 0xdb, 0x67, 0x81, 0x7f, 0x68, 0x51, 0x5d, 0x69, 0x99, 0x95, 0xe6, 0xa2, 0x0f,
+    0xb3, 0x7e, 0x70, 0xcb, 0xbc, 0x90, 0xe7, 0xf9, 0xa1, 0x65, 0x54, 0x35, 0x50, 0xdd, 0x82, 0x6a,
+    0x62, 0x5a, 0xe8, 0xa1, 0xed, 0x58, 0xe3, 0x4e, 0x67, 0x40, 0xff, 0x01, 0x19, 0x98, 0x31, 0xe6,
+    0xa3, 0xc4, 0x07, 0xbc, 0xe5, 0x78, 0x17, 0x30, 0x8e, 0x77, 0x14, 0x62, 0x9c, 0xbe, 0xed, 0xf8,
+    0x3c, 0x5f, 0x58, 0x05, 0x11, 0xac, 0x94, 0xa1, 0xee, 0x65, 0xcc, 0xa4, 0x8c, 0x45, 0x08, 0x90,
+    0x5c, 0xec, 0x8e, 0x27, 0x92, 0xcb, 0x65, 0x0e, 0xbc, 0xed, 0x22, 0x0c, 0x40, 0xa5, 0xe3, 0x77,
+    0x17, 0x03, 0x36, 0x9a, 0x12, 0xae, 0x20, 0x25, 0x42, 0xd3, 0x31, 0xfb, 0x93, 0x7d, 0x98, 0x4c,
+    0xde, 0xc1, 0x44, 0xc9, 0x46, 0x96, 0xe7, 0x41, 0xc5, 0x06, 0xf3, 0x5f, 0x45, 0xa3, 0x6e, 0x5a,
+    0x22, 0x21, 0x91, 0x4b, 0x3c, 0xb7, 0xf8, 0x66, 0x31, 0xd2, 0xd7, 0xa1, 0x55, 0xa9, 0x5d, 0xd5,
+    0x98, 0x9a, 0x86, 0x81, 0x1a, 0xc7, 0x4a, 0xf9, 0x2a, 0xa4, 0xef, 0xc1, 0x6a, 0x59, 0xb6, 0x8c,
+    0x4d, 0x36, 0xe2, 0x7b, 0x69, 0x2a, 0xa3, 0x04, 0xa6, 0xc9, 0x3f, 0x96, 0x62, 0x29, 0x4a, 0x55,
+    0xe0, 0x46, 0x5a, 0xe3, 0x7f, 0xe1, 0x98, 0x6f, 0xa2, 0x20, 0xa8, 0x4e, 0x18, 0xe4, 0xb2, 0x91,
+    0xea, 0x09, 0xb9, 0x96, 0x96, 0x24, 0x4c, 0x0b, 0x76, 0xd9, 0x69, 0x37, 0x0a, 0x62, 0x50, 0xcc,
+    0x65, 0x22, 0x79, 0x68, 0xe2, 0x93, 0x89, 0xc1, 0x12, 0x3b, 0x35, 0x71, 0xbd, 0xe2, 0x12, 0x7c,
+    0xed, 0xa1, 0x44, 0x37, 0xe5, 0xb2, 0x40, 0xf7, 0x6b, 0x05, 0x57, 0x6c, 0x25, 0x3a, 0x75, 0x87,
+    0xbc, 0xa0, 0x94, 0x41, 0xf9, 0x84, 0x92, 0x64, 0x34, 0x1d, 0x9f, 0x9c, 0x9e, 0x7f, 0x62, 0x47,
+    0xa7, 0x47, 0x1f, 0xce, 0x4c, 0x06, 0xaa, 0x75, 0x1d, 0x74, 0x74, 0x43, 0x2a, 0xa0, 0xf3, 0x34,
+    0x46, 0xfb, 0x80, 0x2c, 0x83, 0x7b, 0x92, 0x33, 0x34, 0x36, 0xe1, 0x8f, 0xa6, 0x99, 0xa2, 0x0d,
+    0xd4, 0xa7, 0x4b, 0x48, 0x4b, 0x71, 0x41, 0xb0, 0xa8, 0x53, 0x2c, 0x96, 0xc4, 0x5e, 0x18, 0x78,
+    0x37, 0x87, 0x56, 0x9a, 0xe4, 0xd2, 0xb1, 0xbb, 0x44, 0xe0, 0x1a, 0x62, 0x8c, 0x90, 0x76, 0xcb,
+    0x1a, 0x7f, 0xc0, 0x07, 0x46, 0x83, 0x40, 0x87, 0x70, 0x14, 0xc6, 0x59, 0x13, 0xca, 0x0f, 0xf8,
+    0x7c, 0xab, 0x50, 0x15, 0x54, 0xc1, 0x3c, 0xd8, 0xc6, 0xdf, 0xe0, 0xcf, 0x0b, 0x05, 0xcf, 0xae,
+    0x11, 0x11, 0xb2, 0x77, 0xe4, 0xdd, 0xc4, 0xc9, 0x5d, 0x28, 0xfc, 0xb9, 0x68, 0x64, 0x2f, 0xad,
+    0xc8, 0x26, 0x37, 0xa5, 0xa9, 0xaa, 0xa8, 0x44, 0xa5, 0xa8, 0x35, 0x3e, 0xff, 0x45, 0x6f, 0x51,
+    0xb9, 0xae, 0xd9, 0xa7, 0xce, 0x78, 0xbc, 0x84, 0xf0, 0xf7, 0x1a, 0xcc, 0x3c, 0x4b, 0x42, 0xc3,
+    0xb7, 0x34, 0xe7, 0x48, 0x08, 0x0f, 0x6c, 0x1d, 0xe0, 0xdd, 0x32, 0xe4, 0x60, 0x46, 0x59, 0x49,
+    0xca, 0x58, 0x13, 0x09, 0x34, 0x7c, 0x8d, 0x2b, 0x51, 0xa0, 0xa7, 0x4f, 0x0e, 0x5e, 0x3c, 0x87,
+    0xec, 0xa9, 0xf4, 0x2e, 0x13, 0x76, 0xf4, 0xf1, 0xf2, 0x9c, 0x9d, 0x41, 0x70, 0x28, 0xe5, 0xdb,
+    0x69, 0xd6, 0x17, 0x2b, 0xcb, 0xeb, 0x75, 0x0a, 0x64, 0x15, 0x76, 0xfb, 0x6b, 0x0e, 0x71, 0x41,
+    0x0c, 0xec, 0x24, 0x15, 0xb1, 0xfd, 0x08, 0xd4, 0xce, 0x2f, 0xde, 0xbc, 0xff, 0x2e, 0xbc, 0x10,
+    0x74, 0xbf, 0x89, 0x15, 0x22, 0x5c, 0x2e, 0x08, 0xed, 0xeb, 0xd3, 0xf3, 0xc9, 0x1b, 0x13, 0xef,
+    0x37, 0x54, 0xfb, 0x31, 0xe7, 0xa0, 0x9c, 0xa7, 0x3c, 0x4a, 0x87, 0x6c, 0x22, 0xa4, 0x84, 0x60,
+    0x5d, 0x0f, 0x5e, 0xc7, 0x1c, 0x72, 0x0d, 0x23, 0xb0, 0xd2, 0xc9, 0x96, 0x39, 0xf0, 0xa4, 0xbd,
+    0x0c, 0x5d, 0xb6, 0x6b, 0xb8, 0x4a, 0x18, 0x44, 0x86, 0xaf, 0xc2, 0x6c, 0xdd, 0x0b, 0x35, 0x03,
+    0x46, 0xda, 0x06, 0x3e, 0x0a, 0x4b, 0x9e, 0xf2, 0xcc, 0x5a, 0x83, 0xc0, 0x74, 0x5b, 0x9a, 0x8f,
+    0xaa, 0x3a, 0x7b, 0x3f, 0x5a, 0xda, 0xd4, 0x4c, 0x83, 0xc3, 0xd2, 0x55, 0x79, 0x6b, 0x27, 0xd7,
+    0x92, 0x58, 0xa5, 0x8d, 0x17, 0x82, 0x9c, 0x06, 0x51, 0x20, 0x99, 0x03, 0x7c, 0xb5, 0x06, 0xc8,
+    0xd9, 0x88, 0x8a, 0x61, 0x46, 0xc5, 0xb0, 0xa5, 0x0a, 0x76, 0x4b, 0xb7, 0x44, 0x42, 0x04, 0xbd,
+    0x06, 0x48, 0x13, 0xcb, 0x11, 0x18, 0x0b, 0x58, 0xc8, 0x34, 0x49, 0x24, 0x7b, 0x9b, 0x2c, 0x33,
+    0xe6, 0x74, 0xfa, 0xec, 0x90, 0x9d, 0xcf, 0x66, 0xdf, 0xc4, 0x97, 0x89, 0xe9, 0xf5, 0xc2, 0xc4,
+    0xa5, 0x63, 0x17, 0x3b, 0x03, 0x15, 0x3a, 0xbf, 0xb6, 0x40, 0x8d, 0x27, 0xdc, 0x93, 0xe0, 0x1e,
+    0x1b, 0x11, 0xe5, 0x52, 0xa4, 0x87, 0x56, 0xcf, 0xed, 0x17, 0x38, 0x21, 0xdc, 0x29, 0x0e, 0x71,
+    0x0f, 0xb6, 0xad, 0xe8, 0xd5, 0x96, 0xcc, 0x88, 0x8e, 0xc9, 0x0b, 0xc6, 0x64, 0x4d, 0x9e, 0x39,
+    0xef, 0xa2, 0xb4, 0x7b, 0xda, 0xfa, 0x0b, 0x6c, 0x60, 0x7c, 0xbc, 0xbe, 0x31, 0xf1, 0x9d, 0x0a,
+    0x7e, 0x03, 0x06, 0x45, 0xd5, 0xcc, 0x6d, 0x20, 0x1f, 0x98, 0xd3, 0x53, 0x6a, 0x6a, 0xb3, 0x7e,
+    0xa7, 0xdf, 0xdb, 0x82, 0x1c, 0xc4, 0x01, 0xdc, 0x16, 0x76, 0x67, 0x0e, 0xad, 0x7e, 0xaf, 0xdc,
+    0x0d, 0x40, 0x78, 0x9d, 0x03, 0xc2, 0x8a, 0x0a, 0x84, 0x30, 0xfa, 0xdf, 0xc4, 0x92, 0x2f, 0xa7,
+    0xb0, 0x6b, 0x6b, 0x41, 0x00, 0x4f, 0xa7, 0x16, 0x46, 0xe8, 0x25, 0xc0, 0x4c, 0xf8, 0xad, 0x28,
+    0x8d, 0x5d, 0xa3, 0x1b, 0x75, 0xd1, 0x7c, 0x0c, 0x87, 0x69, 0x28, 0x03, 0x72, 0x38, 0x2d, 0xf9,
+    0xcb, 0x50, 0xd4, 0x4a, 0x01, 0x1d, 0x65, 0x77, 0x56, 0x0c, 0xb0, 0x00, 0x1d, 0xaf, 0xb9, 0x5d,
+    0x61, 0xca, 0x45, 0x91, 0xd9, 0xb9, 0x1f, 0x60, 0x04, 0x2a, 0xf8, 0xa0, 0xf3, 0xd5, 0x78, 0x24,
+    0x55, 0xdf, 0x4e, 0x66, 0xf8, 0x38, 0x7e, 0x32, 0xea, 0xc2, 0x4f, 0x7c, 0x7a, 0x13, 0x97, 0x8f,
+    0x97, 0x41, 0x24, 0xca, 0x97, 0xe3, 0x65, 0xe6, 0xe4, 0xad, 0xf2, 0xf5, 0xd7, 0x24, 0x74, 0x4e,
+    0xab, 0xd7, 0x63, 0xfe, 0x90, 0x17, 0x2f, 0x05, 0x33, 0x5f, 0x3c, 0x6b, 0xfc, 0xdf, 0x50, 0x79,
+    0xe9, 0x89, 0x2e, 0x92, 0xea, 0x16, 0x64, 0xa9, 0x69, 0x87, 0xa2, 0xe4, 0x61, 0x22, 0x73, 0xf4,
+    0x36, 0x1a, 0xc2, 0xdf, 0xc4, 0x5f, 0xa9, 0xa7, 0xbf, 0xa9, 0xfc, 0x4a, 0x3d, 0x95, 0xde, 0x1b,
+    0xe3, 0xd3, 0x07, 0x80, 0xca, 0x99, 0xe3, 0x65, 0x49, 0xdc, 0xaa, 0xc5, 0xa5, 0xcf, 0x5f, 0x2d,
+    0x1c, 0xb4, 0x06, 0x16, 0x46, 0xa0, 0x05, 0xba, 0x22, 0x1c, 0xa1, 0xb0, 0x26, 0x06, 0x11, 0xef,
+    0x84, 0xb8, 0x81, 0x37, 0xab, 0x6d, 0xf9, 0xcb, 0xcc, 0x1a, 0xe4, 0x6d, 0x6b, 0x96, 0x25, 0x11,
+    0xc0, 0xfe, 0x06, 0x7f, 0x3a, 0x67, 0x67, 0x9d, 0xe3, 0x63, 0x98, 0x03, 0xa5, 0x0f, 0x5c, 0xb7,
+    0x6d, 0x09, 0xd8, 0x89, 0x07, 0x6b, 0x10, 0xb7, 0xad, 0xfc, 0x06, 0x0a, 0xb4, 0x41, 0xff, 0xf1,
+    0xaa, 0x0a, 0x5a, 0x98, 0x32, 0x79, 0x26, 0xb8, 0xaa, 0xa3, 0x90, 0x1b, 0x8b, 0x65, 0xc9, 0x1d,
+    0x30, 0x79, 0xb0, 0x12, 0x95, 0xe8, 0x20, 0x60, 0x16, 0xe8, 0x65, 0x7d, 0x4e, 0xfa, 0xd3, 0x78,
+    0xb6, 0xc6, 0x7a, 0xa5, 0xa9, 0x32, 0xd8, 0xe7, 0xa0, 0x2b, 0x52, 0x80, 0x03, 0x91, 0x9d, 0x14,
+    0x47, 0x6f, 0x65, 0x78, 0x37, 0x8b, 0x47, 0x9c, 0xe8, 0x44, 0xf9, 0xbc, 0xac, 0x4d, 0xb6, 0x9a,
+    0x32, 0xa6, 0xe5, 0x4d, 0x66, 0xdc, 0x5c, 0xd6, 0x52, 0x6b, 0x56, 0x27, 0x0a, 0x65, 0x79, 0x30,
+    0x5a, 0xaf, 0x41, 0xf2, 0x87, 0x7c, 0x2d, 0x2e, 0x6f, 0x48, 0xe8, 0xff, 0xba, 0xbc, 0x64, 0xef,
+    0xf0, 0x94, 0x14, 0xf3, 0x30, 0x6f, 0x40, 0x15, 0xfd, 0x21, 0xe5, 0x77, 0xe2, 0x3a, 0x4d, 0x6a,
+    0x19, 0x4b, 0xf5, 0x27, 0x34, 0x14, 0x1c, 0x4c, 0x2c, 0x95, 0x95, 0x92, 0x79, 0x07, 0x9d, 0x6d,
+    0xa5, 0x0e, 0xc1, 0x13, 0xf3, 0xde, 0xc1, 0x81, 0x55, 0xda, 0x75, 0x59, 0x16, 0x6d, 0xc1, 0x03,
+    0xe6, 0x12, 0x6b, 0x9f, 0xa8, 0xfb, 0x42, 0x93, 0xa2, 0x49, 0x90, 0xef, 0x56, 0xb4, 0x11, 0x41,
+    0x94, 0x06, 0x88, 0x97, 0xb7, 0x90, 0xf3, 0x07, 0x6b, 0x91, 0x8e, 0x6a, 0x39, 0x1d, 0x1c, 0x17,
+    0x00, 0xd1, 0x60, 0x8d, 0xd6, 0xb8, 0x88, 0x91, 0x84, 0xe7, 0x22, 0xc9, 0x1a, 0xf0, 0xd4, 0x93,
+    0x94, 0xba, 0x03, 0x58, 0xc5, 0x94, 0xde, 0xaf, 0xa0, 0xfa, 0x7b, 0x6e, 0xaf, 0xac, 0x47, 0x65,
+    0x4f, 0xa5, 0x02, 0xe5, 0xfd, 0x9b, 0xd5, 0xb7, 0x4c, 0x7d, 0x28, 0x70, 0xfe, 0x92, 0xa5, 0x9e,
+    0x5f, 0x1e, 0xb1, 0x8f, 0xb4, 0xcc, 0xb0, 0x0a, 0x93, 0x5d, 0x28, 0x28, 0x84, 0xda, 0xcd, 0xd9,
+    0x5d, 0x87, 0x5e, 0x2a, 0xb9, 0x26, 0x6f, 0x8f, 0x3a, 0xbb, 0xfb, 0x2f, 0x98, 0x93, 0xa4, 0x78,
+    0x0a, 0xe7, 0x61, 0x6b, 0x93, 0xe2, 0xf5, 0xfa, 0x7c, 0xc1, 0x9b, 0x14, 0xcf, 0xe0, 0x64, 0xeb,
+    0x89, 0x05, 0x1c, 0xc4, 0x45, 0x06, 0x0a, 0x5a, 0x70, 0x40, 0x9a, 0x2f, 0x23, 0x36, 0x0b, 0xb2,
+    0xe8, 0x0e, 0xc2, 0x80, 0x3b, 0xc5, 0xa4, 0x5d, 0xa9, 0xf3, 0xbb, 0xc2, 0xc1, 0x32, 0x0d, 0x13,
+    0xee, 0x63, 0x2c, 0xf8, 0x48, 0x4f, 0x2b, 0xe5, 0xe3, 0x37, 0xcb, 0x2b, 0x60, 0xf7, 0xfb, 0x2b,
+    0xac, 0xa1, 0xd1, 0x24, 0xd0, 0xfd, 0x9d, 0xa6, 0xa2, 0x2b, 0x2d, 0x30, 0xeb, 0xd0, 0x93, 0x6e,
+    0x72, 0x07, 0x4d, 0x34, 0xe6, 0xb7, 0x6a, 0xef, 0x38, 0x5b, 0x64, 0x62, 0x76, 0x68, 0x3d, 0xa1,
+    0xc3, 0x35, 0x64, 0xa8, 0x7c, 0x31, 0x4d, 0x60, 0x13, 0x47, 0x5d, 0x8e, 0x87, 0xe3, 0x6a, 0xbe,
+    0x4a, 0xa5, 0x45, 0xd6, 0x58, 0x03, 0x51, 0xbe, 0x82, 0x41, 0x45, 0x4d, 0xd5, 0xf1, 0x63, 0xa8,
+    0x1b, 0x1f, 0xc3, 0xcf, 0xd5, 0x75, 0x5d, 0x9c, 0x72, 0x7f, 0xcf, 0x21, 0x8b, 0x30, 0x88, 0xcd,
+    0x73, 0xbc, 0x1a, 0xbb, 0x9e, 0x86, 0x3c, 0x86, 0x4a, 0xe6, 0x3f, 0x27, 0xe7, 0xef, 0xd7, 0xe8,
+    0x68, 0x6b, 0x44, 0x13, 0xc3, 0xb9, 0x1d, 0xa3, 0x06, 0xf9, 0xe6, 0x19, 0xca, 0x4b, 0x62, 0xdc,
+    0x7c, 0xc7, 0x56, 0xe6, 0xff, 0xb3, 0xdd, 0x62, 0x4f, 0x9f, 0x32, 0x5d, 0xce, 0xc3, 0x36, 0x00,
+    0x03, 0xfa, 0xd4, 0x47, 0xb5, 0xe5, 0x31, 0x5d, 0xbb, 0x55, 0x3b, 0x5c, 0xea, 0x32, 0xf7, 0xb2,
+    0x20, 0x95, 0xe3, 0x9d, 0x6e, 0x97, 0x1d, 0x07, 0x78, 0x3f, 0xc6, 0xee, 0x82, 0xcc, 0x67, 0x58,
+    0xd5, 0x82, 0xad, 0xb1, 0x13, 0x6d, 0x60, 0x6c, 0x2e, 0xa6, 0x50, 0x56, 0x30, 0xd8, 0x3e, 0xf8,
+    0x7f, 0x2a, 0x60, 0xa7, 0xe3, 0x2f, 0x12, 0x46, 0x3d, 0xee, 0x2d, 0xa4, 0x8b, 0xcb, 0x5f, 0x89,
+    0x80, 0x9d, 0x7c, 0xea, 0x7c, 0x12, 0xde, 0x22, 0x17, 0xa1, 0x42, 0x93, 0x03, 0x4a, 0x11, 0xc4,
+    0x11, 0x76, 0xb2, 0x58, 0x2c, 0x96, 0xb0, 0x20, 0xe4, 0xbe, 0x88, 0xdd, 0x9d, 0x5b, 0x9e, 0x01,
+    0xb1, 0xeb, 0x93, 0x4f, 0x50, 0xc6, 0xd9, 0x7d, 0x77, 0xd7, 0x3d, 0xb0, 0x87, 0x34, 0x78, 0x7c,
+    0xf4, 0xdb, 0x04, 0xc6, 0x3e, 0xdb, 0x93, 0xa5, 0xdd, 0xb6, 0xcf, 0x12, 0xf8, 0x71, 0x89, 0x4f,
+    0x9f, 0x04, 0x3e, 0x2d, 0xe0, 0xc7, 0x49, 0x06, 0x3f, 0x26, 0xdc, 0xbe, 0x52, 0x0b, 0xc8, 0x89,
+    0x01, 0x09, 0x6e, 0xbc, 0xdd, 0x66, 0x74, 0x84, 0x81, 0xf7, 0x78, 0x19, 0x86, 0x6d, 0x16, 0x06,
+    0xb7, 0xd5, 0x0b, 0xf5, 0x11, 0x4e, 0x45, 0x0c, 0x03, 0x9d, 0xfe, 0x70, 0x67, 0x67, 0xb6, 0x8c,
+    0x3d, 0x74, 0x4b, 0xf6, 0x0f, 0x27, 0xf0, 0x5b, 0xec, 0x2b, 0xcb, 0x84, 0x5c, 0x66, 0x31, 0xf3,
+    0x13, 0x6f, 0x19, 0x41, 0x50, 0x76, 0x61, 0x0b, 0xdf, 0x84, 0x02, 0x1f, 0x5f, 0x3d, 0xbc, 0xf3,
+    0x11, 0x08, 0xfb, 0x4a, 0xe5, 0x32, 0x98, 0x76, 0x96, 0x59, 0x68, 0xac, 0x9c, 0x09, 0xe9, 0x2d,
+    0x70, 0xac, 0xcd, 0xbe, 0xa2, 0x66, 0xe0, 0x8c, 0x63, 0xc7, 0x49, 0x27, 0x87, 0x32, 0x18, 0xcf,
+    0x53, 0x2e, 0xd4, 0x43, 0xb1, 0x53, 0xae, 0x77, 0x32, 0x63, 0x69, 0x46, 0x96, 0xe3, 0x20, 0x85,
+    0x3a, 0x15, 0xda, 0x53, 0x42, 0x09, 0xd6, 0xc2, 0x61, 0x05, 0xd8, 0x49, 0x03, 0xb9, 0x48, 0xc8,
+    0x45, 0xe2, 0x03, 0xbd, 0x8b, 0xf3, 0xc9, 0x25, 0xe8, 0x01, 0xeb, 0xab, 0x01, 0xe8, 0xfc, 0x8e,
+    0x7d, 0xfc, 0x70, 0x3a, 0x81, 0x93, 0xb6, 0xb7, 0xb8, 0xe0, 0x19, 0x8f, 0x72, 0x07, 0xd1, 0xb0,
+    0x3f, 0xff, 0x64, 0x5f, 0x1f, 0x5b, 0x6d, 0xec, 0xc1, 0x05, 0x99, 0xf0, 0x24, 0x2c, 0x8c, 0xe8,
+    0x58, 0x5c, 0xb2, 0x09, 0x36, 0x0a, 0x76, 0xb4, 0x68, 0x0d, 0x77, 0x0c, 0x66, 0x30, 0xbe, 0x5e,
+    0x20, 0x43, 0xf8, 0xd0, 0x66, 0x44, 0x1a, 0xe2, 0x57, 0xa6, 0xf9, 0xc2, 0x51, 0x37, 0x89, 0x55,
+    0x04, 0x07, 0x35, 0x57, 0xa2, 0x0a, 0x05, 0xc0, 0x98, 0x70, 0xd3, 0x8c, 0x52, 0xde, 0xb1, 0x98,
+    0xf1, 0x65, 0x28, 0x41, 0x62, 0x1a, 0xc7, 0xad, 0xf4, 0x71, 0xab, 0x1a, 0x38, 0xc6, 0xb1, 0x13,
+    0x40, 0x7d, 0x0c, 0x9c, 0x13, 0xe5, 0x96, 0x5e, 0x14, 0xcc, 0x00, 0xb3, 0x22, 0x4f, 0xbf, 0x1c,
+    0x5f, 0x4f, 0x7c, 0x5b, 0x33, 0xfe, 0xf7, 0xc9, 0xce, 0xd8, 0x63, 0x4d, 0x01, 0x70, 0x14, 0x44,
+    0x4e, 0xb4, 0xfc, 0x94, 0x8d, 0xf2, 0x52, 0x76, 0xe6, 0xa0, 0x14, 0x37, 0x0c, 0x2a, 0xc8, 0x62,
+    0x06, 0x39, 0x24, 0xad, 0x08, 0x65, 0x48, 0xf9, 0xe7, 0x9b, 0xab, 0x16, 0x5b, 0x1d, 0x71, 0x09,
+    0x1c, 0xa4, 0x57, 0xcb, 0x60, 0xa4, 0x46, 0x54, 0xe4, 0x9e, 0x93, 0x1b, 0xb6, 0x32, 0x91, 0x19,
+    0x9c, 0x35, 0x60, 0xc8, 0xcd, 0x04, 0x65, 0x06, 0xa7, 0xfb, 0xf9, 0xe9, 0x68, 0x7c, 0xd5, 0x9d,
+    0xb7, 0x0d, 0x95, 0x7b, 0xc6, 0x8a, 0xaf, 0xf6, 0x53, 0x1b, 0xc4, 0xa4, 0x8c, 0x09, 0x2a, 0xb0,
+    0x47, 0xf4, 0x16, 0x4a, 0x7a, 0x19, 0xd3, 0xcb, 0x1c, 0x5e, 0x1e, 0x3f, 0x7b, 0x57, 0x85, 0x01,
+    0x56, 0xe4, 0xe9, 0x56, 0xe7, 0xe4, 0xce, 0x99, 0xdd, 0x29, 0x49, 0x49, 0x26, 0xf0, 0xb9, 0xc3,
+    0x43, 0xed, 0xc2, 0x60, 0x4c, 0x39, 0x44, 0x7e, 0x80, 0x9d, 0x80, 0xa5, 0xc3, 0xd1, 0xde, 0x5d,
+    0x06, 0x1f, 0x04, 0xe6, 0x14, 0x02, 0xc2, 0x75, 0x8a, 0x0f, 0xd4, 0xe7, 0x46, 0x48, 0x80, 0xc3,
+    0x79, 0xb5, 0x75, 0x76, 0xd7, 0x36, 0x7c, 0x28, 0x23, 0x90, 0x06, 0x0f, 0x42, 0x11, 0xc3, 0xc4,
+    0xa3, 0xeb, 0x01, 0x57, 0x41, 0x69, 0x17, 0xda, 0x31, 0x25, 0x80, 0x68, 0x05, 0xd1, 0x0c, 0x7b,
+    0xa9, 0xc2, 0xd1, 0xdb, 0x55, 0xc4, 0x89, 0x1c, 0x69, 0x16, 0x12, 0xe6, 0x2e, 0xf0, 0x8a, 0x03,
+    0xff, 0x70, 0x6c, 0x6a, 0xf3, 0xda, 0x40, 0x11, 0x2c, 0xeb, 0xb5, 0xba, 0x6d, 0x46, 0x70, 0x57,
+    0x42, 0xb5, 0xaa, 0x41, 0xb0, 0xd3, 0x0b, 0x10, 0x41, 0x1c, 0x8b, 0xec, 0xed, 0xe5, 0xd9, 0x29,
+    0xcd, 0xe3, 0x20, 0x89, 0x6d, 0x63, 0xc3, 0xc7, 0x66, 0x3f, 0x83, 0xb6, 0xa9, 0xae, 0x6e, 0x6a,
+    0x59, 0x21, 0x88, 0x2e, 0xb0, 0x6d, 0x36, 0x68, 0x84, 0x54, 0x0d, 0x27, 0xc8, 0x47, 0x47, 0xef,
+    0x3f, 0x1e, 0x9d, 0x16, 0xc0, 0x9a, 0x83, 0x20, 0x6d, 0xe0, 0x30, 0x48, 0xf5, 0x2c, 0xb6, 0x80,
+    0x1b, 0xe6, 0x71, 0x58, 0x43, 0xa8, 0xc6, 0xcf, 0x3a, 0xc8, 0x2d, 0xb2, 0x8d, 0x3d, 0x25, 0xe2,
+    0x8a, 0xba, 0x40, 0xc7, 0xf6, 0xca, 0x1a, 0xe2, 0xd2, 0x25, 0x26, 0xab, 0x35, 0x24, 0x17, 0x2d,
+    0x82, 0xcc, 0x07, 0xfa, 0xd3, 0x6b, 0xc2, 0x34, 0x6a, 0xa0, 0x02, 0xa3, 0xae, 0x4c, 0x4e, 0x82,
+    0x7b, 0xe1, 0x3b, 0xbb, 0x85, 0xde, 0x65, 0x22, 0x9b, 0xb4, 0x9e, 0xc8, 0x12, 0xb4, 0x5f, 0x80,
+    0x4e, 0x79, 0x13, 0x28, 0x8c, 0xae, 0x63, 0x8d, 0xef, 0x9b, 0x40, 0x61, 0x74, 0xa8, 0x0d, 0x3a,
+    0x77, 0xff, 0x60, 0x3f, 0xc0, 0xae, 0x15, 0x49, 0xa2, 0x88, 0x57, 0x46, 0xd2, 0x00, 0x10, 0x15,
+    0x5d, 0x00, 0x1f, 0x0d, 0x03, 0x46, 0xca, 0xd0, 0xa7, 0x41, 0x8e, 0x24, 0xe7, 0xf3, 0x50, 0x38,
+    0x36, 0xd6, 0x93, 0x60, 0xbb, 0x3f, 0x00, 0xb4, 0x11, 0xa5, 0xf0, 0x8d, 0x12, 0x86, 0xdd, 0xe5,
+    0x69, 0xd0, 0x2d, 0x96, 0xeb, 0x68, 0x83, 0xd6, 0x49, 0x7d, 0x6f, 0x15, 0x71, 0x14, 0xcb, 0x55,
+    0x97, 0x78, 0x1b, 0x9d, 0x5c, 0x5f, 0xc3, 0x90, 0xc5, 0xe1, 0xd5, 0x87, 0x5d, 0x88, 0xbc, 0xd2,
+    0x65, 0x6e, 0x10, 0x9f, 0x26, 0x11, 0x1a, 0xc3, 0x56, 0x72, 0x43, 0x63, 0x58, 0xc4, 0x28, 0x64,
+    0xe7, 0xbf, 0x14, 0xbb, 0x57, 0xb5, 0x84, 0xb7, 0x71, 0x92, 0xdc, 0xb4, 0x4c, 0xf8, 0xe4, 0x66,
+    0xab, 0x7a, 0x56, 0xa0, 0x37, 0x70, 0x88, 0x73, 0x1a, 0xac, 0xe8, 0xc8, 0x6e, 0x57, 0xc6, 0x8a,
+    0xf7, 0xb5, 0x0a, 0xe9, 0x52, 0x4f, 0x9b, 0x5c, 0x10, 0xb1, 0x31, 0xeb, 0x81, 0xa9, 0x9e, 0x71,
+    0xb9, 0x70, 0xe1, 0xb0, 0xef, 0x40, 0x85, 0xdd, 0x56, 0x6f, 0xa0, 0xb1, 0x24, 0x83, 0xad, 0xc2,
+    0x86, 0x24, 0xfb, 0x0f, 0xbc, 0x8a, 0x63, 0x5d, 0xb5, 0xa6, 0xd5, 0x02, 0x93, 0xee, 0x69, 0x4e,
+    0x70, 0x7a, 0x8d, 0xd7, 0x75, 0x04, 0x5d, 0xf6, 0xa2, 0x57, 0xc8, 0x08, 0x28, 0xb6, 0xaf, 0x40,
+    0xbe, 0xcc, 0x05, 0x50, 0x59, 0x97, 0x2e, 0xa6, 0xae, 0xee, 0x0e, 0x49, 0x86, 0x67, 0xcc, 0xfe,
+    0xd1, 0x6e, 0x80, 0xa9, 0xca, 0x6b, 0x0d, 0x38, 0x66, 0x3f, 0xa1, 0x94, 0xb6, 0xfe, 0xc8, 0x82,
+    0x5c, 0x52, 0x7f, 0x9e, 0x51, 0x5f, 0x5f, 0x67, 0x6a, 0x95, 0x46, 0x26, 0x9a, 0x1c, 0x57, 0xce,
+    0xa5, 0xd6, 0xa2, 0xcd, 0x1c, 0x1b, 0x16, 0xc0, 0x4e, 0x85, 0xb7, 0x86, 0x83, 0x22, 0x0e, 0x90,
+    0x47, 0x4d, 0x01, 0xf4, 0xea, 0xd4, 0x69, 0x0b, 0x18, 0xd2, 0x8d, 0xb7, 0x86, 0x3f, 0x10, 0xa3,
+    0x44, 0x54, 0xa7, 0x50, 0xd3, 0x16, 0xce, 0x92, 0xb6, 0x10, 0xd9, 0x00, 0xa7, 0x1d, 0xbb, 0xa7,
+    0x88, 0xe1, 0xd4, 0x8f, 0x38, 0xe5, 0xe6, 0x50, 0x29, 0x0b, 0xa7, 0xb3, 0xab, 0x28, 0xe2, 0xe5,
+    0x63, 0x8b, 0xb4, 0x60, 0x53, 0x6e, 0x80, 0x8a, 0xf5, 0x14, 0x8a, 0xc3, 0xce, 0xb1, 0x08, 0x25,
+    0xcf, 0x59, 0x0a, 0xc5, 0xee, 0x44, 0x64, 0xb7, 0x22, 0xeb, 0x4c, 0x50, 0xca, 0x37, 0x74, 0x2a,
+    0x1f, 0xb2, 0x29, 0x56, 0xb5, 0x62, 0x11, 0xc2, 0x34, 0x1c, 0xce, 0x83, 0x29, 0x94, 0xc5, 0x00,
+    0x7d, 0x91, 0x84, 0x21, 0x64, 0x60, 0xc6, 0x6f, 0x64, 0x70, 0x6b, 0x14, 0x07, 0x58, 0x75, 0x23,
+    0x56, 0xa7, 0x4a, 0x94, 0x3f, 0xdc, 0x05, 0xb1, 0x9f, 0xdc, 0xb9, 0x84, 0x70, 0x92, 0x2c, 0x33,
+    0x4f, 0x98, 0xd9, 0xb0, 0x28, 0x50, 0xa1, 0xc2, 0x31, 0x20, 0x20, 0x4a, 0xa8, 0xb6, 0x80, 0x32,
+    0x60, 0x04, 0x82, 0xb2, 0x2a, 0x82, 0xcc, 0x89, 0xed, 0xf5, 0xc6, 0xba, 0x8a, 0x68, 0x51, 0x52,
+    0x33, 0xd1, 0x57, 0x75, 0x15, 0x9e, 0x40, 0xdc, 0x14, 0xbf, 0xd8, 0x73, 0x84, 0x4b, 0x95, 0xa4,
+    0xae, 0x94, 0x6a, 0x65, 0x0b, 0x94, 0xc1, 0x84, 0x03, 0x2a, 0x10, 0x58, 0xe3, 0x53, 0x21, 0x82,
+    0x50, 0xb5, 0x04, 0x4a, 0x44, 0xd4, 0x38, 0x68, 0xf1, 0x04, 0x9c, 0x71, 0xd1, 0x81, 0xa2, 0x48,
+    0xc2, 0xd1, 0x2a, 0x0b, 0xa4, 0x64, 0x37, 0x49, 0x14, 0x49, 0x76, 0x9b, 0x44, 0xec, 0x9f, 0x22,
+    0xfb, 0xf7, 0xff, 0x49, 0xe6, 0xc4, 0x90, 0xc7, 0xe1, 0x3c, 0x11, 0xb1, 0xb7, 0x08, 0xfb, 0x1a,
+    0xb3, 0x2d, 0x79, 0xd7, 0x8f, 0xad, 0x92, 0x77, 0xdf, 0x4d, 0xa0, 0x2c, 0xc5, 0x08, 0x0c, 0x36,
+    0x2c, 0x66, 0x41, 0x0c, 0x1e, 0x04, 0x27, 0x1a, 0x35, 0x3c, 0x3e, 0x64, 0xb0, 0xd7, 0x18, 0xd3,
+    0xe8, 0x64, 0xb8, 0x66, 0x91, 0x36, 0x31, 0x31, 0x20, 0x7b, 0x53, 0x2b, 0x4a, 0x1b, 0x7e, 0x6c,
+    0xaa, 0x04, 0x28, 0xd6, 0x3a, 0x7f, 0x28, 0xdd, 0x15, 0xd1, 0x9c, 0x6e, 0x18, 0xd7, 0x50, 0xff,
+    0xe1, 0x46, 0x3c, 0x5d, 0xa9, 0xd9, 0xb5, 0x4a, 0x74, 0xdd, 0x9e, 0x67, 0x1e, 0x1a, 0x60, 0xe6,
+    0xc6, 0x64, 0xad, 0xc8, 0x03, 0x3e, 0xa3, 0xa5, 0x29, 0xd3, 0x23, 0xfb, 0x85, 0xf9, 0xdb, 0x24,
+    0xd4, 0x36, 0xad, 0x9e, 0xc9, 0x11, 0xd0, 0x24, 0xc9, 0xb6, 0xc9, 0x79, 0x01, 0xca, 0x5f, 0x66,
+    0x95, 0x6d, 0x63, 0xfb, 0x5a, 0x61, 0x69, 0x29, 0x69, 0x5a, 0xee, 0xef, 0x09, 0xc4, 0x2c, 0x2c,
+    0xdb, 0x9a, 0x6b, 0x1c, 0x7d, 0xa8, 0x75, 0xa8, 0xd3, 0xda, 0x66, 0x5f, 0x20, 0x23, 0xbc, 0x06,
+    0xcc, 0x52, 0xb1, 0x8d, 0x1b, 0x8d, 0xa1, 0xc4, 0x06, 0x04, 0x11, 0x54, 0xdf, 0x01, 0x3c, 0x97,
+    0x20, 0xc0, 0x5c, 0x9f, 0x2a, 0x34, 0x5c, 0xea, 0x82, 0x61, 0xbc, 0x81, 0x6d, 0x33, 0x44, 0x07,
+    0x74, 0x41, 0x21, 0xfd, 0x82, 0x3d, 0x03, 0x2c, 0x23, 0x99, 0x91, 0x6c, 0x01, 0xb8, 0xdc, 0x2e,
+    0x4a, 0x4f, 0x0e, 0x56, 0xd4, 0x2f, 0xe6, 0x91, 0x7f, 0xc6, 0xf1, 0xaf, 0xa5, 0x64, 0x19, 0x8f,
+    0xa4, 0x8f, 0xb7, 0xa3, 0x7a, 0xed, 0x33, 0xa6, 0xa2, 0x02, 0x5d, 0x24, 0x76, 0x61, 0xca, 0x1e,
+    0xd6, 0x68, 0xf8, 0xf5, 0x86, 0x49, 0xf1, 0x91, 0x51, 0xd1, 0x63, 0x12, 0xf1, 0x35, 0x22, 0x42,
+    0x3c, 0xb6, 0x45, 0x28, 0x73, 0x57, 0xa8, 0xbd, 0x20, 0x50, 0x08, 0xd6, 0xd5, 0x66, 0x34, 0x13,
+    0x28, 0xbb, 0x15, 0xf8, 0x6d, 0x45, 0x87, 0x9a, 0xac, 0x83, 0x38, 0xb9, 0xcb, 0x78, 0x6a, 0x6d,
+    0xeb, 0x6e, 0x2d, 0x0c, 0xc2, 0xf5, 0x8b, 0x86, 0xdd, 0xe7, 0x65, 0xab, 0x4a, 0x85, 0xa5, 0x85,
+    0x02, 0xaa, 0x75, 0x45, 0xf6, 0xf6, 0xb1, 0x11, 0x86, 0xe1, 0xab, 0x8a, 0x84, 0xf6, 0x16, 0x72,
+    0xd1, 0x46, 0x72, 0xfb, 0x3f, 0xad, 0x90, 0x8b, 0x36, 0x92, 0xfb, 0x0e, 0x05, 0xd7, 0xa9, 0x82,
+    0x3d, 0x9a, 0x74, 0x6b, 0x64, 0xd0, 0x56, 0xd7, 0x09, 0xbd, 0xe8, 0xad, 0x12, 0x82, 0x30, 0x71,
+    0x26, 0xf0, 0xda, 0x14, 0xcc, 0x7f, 0xc0, 0xf0, 0x9a, 0x80, 0x41, 0xb0, 0x08, 0x03, 0xf1, 0xef,
+    0xff, 0x95, 0x14, 0x62, 0xb1, 0xd7, 0x40, 0x10, 0x6d, 0x76, 0xcc, 0x97, 0xf0, 0x02, 0xae, 0x08,
+    0xa7, 0xf6, 0x8c, 0x9d, 0x03, 0x27, 0xd4, 0x6c, 0x10, 0xdf, 0xcf, 0x31, 0xf8, 0x56, 0x93, 0xa6,
+    0x8c, 0x6b, 0x26, 0x43, 0x08, 0x30, 0x16, 0xf4, 0x45, 0x38, 0xc2, 0x68, 0x0b, 0x59, 0x11, 0x66,
+    0xbf, 0xd2, 0xda, 0xa8, 0x12, 0xa8, 0x8c, 0x9a, 0x18, 0x5a, 0xfb, 0x43, 0xf8, 0x35, 0x3a, 0x64,
+    0x2f, 0xe1, 0xf7, 0xb3, 0x67, 0x85, 0x87, 0x28, 0x67, 0x9b, 0x62, 0x18, 0x05, 0xef, 0x78, 0x09,
+    0xf5, 0x11, 0xd6, 0x90, 0x40, 0xee, 0xce, 0x67, 0xe3, 0x31, 0x9b, 0xb6, 0xd8, 0x53, 0xe5, 0x6e,
+    0x86, 0x5c, 0xea, 0xd3, 0x31, 0xdd, 0xf5, 0x29, 0x3f, 0xe1, 0x22, 0x36, 0x13, 0x65, 0xd1, 0x49,
+    0x6c, 0x18, 0xb3, 0xb5, 0xdd, 0x31, 0xee, 0xfc, 0x4a, 0x0d, 0xf4, 0x34, 0xad, 0x5c, 0x24, 0x69,
+    0x76, 0x10, 0x33, 0x25, 0x97, 0x7e, 0xac, 0x3f, 0xd1, 0xe9, 0x0d, 0x57, 0x3e, 0x7c, 0x53, 0xdf,
+    0xbd, 0x59, 0x63, 0x0a, 0x79, 0xd8, 0xb7, 0xf9, 0x3c, 0xbd, 0x52, 0x7e, 0x4c, 0x6c, 0x2b, 0xf7,
+    0x56, 0x47, 0xc0, 0x3d, 0x3a, 0x06, 0x4d, 0xb3, 0xb1, 0xa6, 0xa4, 0xe4, 0x7e, 0x34, 0xf7, 0xb4,
+    0x6e, 0x2e, 0x68, 0x23, 0x31, 0xe3, 0x61, 0xce, 0x5e, 0x05, 0x32, 0xe2, 0xf9, 0x8d, 0x60, 0x0e,
+    0xde, 0x8c, 0x92, 0xed, 0xf4, 0xdb, 0x6c, 0xbf, 0x7c, 0x7e, 0xf6, 0xbc, 0xb5, 0xe2, 0xcc, 0xc6,
+    0x8d, 0xd4, 0x16, 0x2b, 0xf9, 0xb2, 0x66, 0x23, 0x7d, 0xed, 0x4d, 0xc4, 0x37, 0x50, 0x1b, 0x8d,
+    0xcc, 0xf0, 0xd9, 0xd1, 0x51, 0x6a, 0xc5, 0x05, 0xbe, 0x6c, 0xf7, 0x34, 0xba, 0x08, 0xd3, 0xa1,
+    0x5b, 0x97, 0x54, 0x14, 0x5e, 0x57, 0x8e, 0x8d, 0x0b, 0x9c, 0x2b, 0xfb, 0x4e, 0x90, 0x8e, 0xb2,
+    0x87, 0x89, 0x08, 0x05, 0xde, 0x9f, 0x1e, 0x85, 0xa1, 0x63, 0xbb, 0x5f, 0x3c, 0x58, 0xb1, 0x1e,
+    0x92, 0x05, 0x75, 0x9f, 0x44, 0xa8, 0xab, 0x40, 0xfd, 0x0d, 0x14, 0x20, 0x54, 0xc1, 0xbd, 0x88,
+    0xc8, 0x74, 0x2e, 0xd8, 0x74, 0x2c, 0x56, 0x57, 0x42, 0x74, 0xe3, 0x53, 0x26, 0x44, 0x7a, 0x03,
+    0x8a, 0x45, 0x5f, 0x82, 0xde, 0x1b, 0x32, 0x61, 0x91, 0x05, 0xa9, 0xba, 0xc8, 0xa9, 0x2d, 0x11,
+    0xcc, 0x1e, 0x60, 0x6a, 0x68, 0xa4, 0xaa, 0xff, 0x89, 0x57, 0x73, 0x95, 0x71, 0x13, 0xa5, 0x7a,
+    0x27, 0xfa, 0xcc, 0x8f, 0x47, 0x23, 0x45, 0xba, 0xa1, 0x6f, 0xa3, 0x3e, 0xc7, 0xca, 0x07, 0xec,
+    0xab, 0xad, 0xd3, 0x73, 0xe7, 0x12, 0xf6, 0x15, 0x9b, 0x17, 0xf8, 0xfd, 0x7f, 0xa0, 0xba, 0x00,
+    0x5d, 0x6c, 0xa3, 0xd9, 0x8f, 0x45, 0x9b, 0xc7, 0xfe, 0x8c, 0xdb, 0xb4, 0x26, 0x11, 0xec, 0xd9,
+    0x95, 0xfd, 0xa8, 0x0c, 0x67, 0x7b, 0x57, 0x0e, 0xab, 0x01, 0xd5, 0x52, 0x58, 0x85, 0xc3, 0x94,
+    0x5a, 0x62, 0x6e, 0x2c, 0x4b, 0xe4, 0x26, 0x95, 0x63, 0xfb, 0xd8, 0xf1, 0xdb, 0x2c, 0x4c, 0xe6,
+    0xa5, 0xca, 0x8b, 0x3b, 0xaf, 0xba, 0x65, 0x10, 0x87, 0xf6, 0xc9, 0x27, 0xf6, 0x2b, 0x88, 0x4e,
+    0x1f, 0xf2, 0xa9, 0x16, 0x41, 0x71, 0x83, 0xc1, 0x43, 0x8b, 0xfc, 0x0c, 0x5b, 0x44, 0x3e, 0x76,
+    0x2f, 0x94, 0x03, 0xaa, 0xcf, 0x89, 0xc8, 0xdf, 0x94, 0x4f, 0xdb, 0xa7, 0x09, 0x38, 0x2e, 0x5d,
+    0xb5, 0x6d, 0x47, 0x81, 0xed, 0x0d, 0x13, 0x09, 0x2b, 0x30, 0xe8, 0xb9, 0x6b, 0x80, 0x0f, 0x7c,
+    0xe5, 0xce, 0x8d, 0x2d, 0x0d, 0xe7, 0xfd, 0xe5, 0x05, 0x3b, 0xff, 0xa5, 0x85, 0xd9, 0x5c, 0xf5,
+    0x34, 0x56, 0xe0, 0xf0, 0x0b, 0x14, 0x80, 0x3a, 0xbf, 0x64, 0x93, 0xdf, 0xde, 0xbf, 0x7e, 0x73,
+    0xac, 0x20, 0x15, 0x4d, 0x93, 0xe3, 0x77, 0x59, 0x16, 0xcc, 0x69, 0x4f, 0xe9, 0xab, 0x99, 0xed,
+    0x6c, 0x07, 0x59, 0x76, 0x8d, 0x67, 0xbf, 0x8d, 0xf2, 0x7f, 0x4c, 0xe5, 0x16, 0xd9, 0x7d, 0x77,
+    0x49, 0xf3, 0xd7, 0x39, 0x55, 0x5d, 0x79, 0x13, 0x86, 0x13, 0x90, 0x8f, 0xbd, 0x15, 0x3c, 0xdd,
+    0x8c, 0x04, 0x4c, 0x34, 0xbd, 0x9e, 0x21, 0x1c, 0x62, 0x99, 0x3e, 0x48, 0xd1, 0x88, 0xe9, 0x94,
+    0x43, 0x76, 0x43, 0x1b, 0x60, 0x67, 0xf9, 0x1c, 0x3f, 0x83, 0x31, 0x04, 0x01, 0x9c, 0x92, 0x3e,
+    0x8a, 0x2a, 0x4b, 0xa2, 0xda, 0x29, 0x1c, 0xef, 0x26, 0x9a, 0x2c, 0x04, 0x8c, 0x2e, 0x86, 0x70,
+    0x81, 0x1f, 0xce, 0xa9, 0xb0, 0xeb, 0x22, 0xe4, 0xb5, 0x57, 0x0c, 0x6f, 0xd9, 0xb0, 0xdf, 0xde,
+    0x4c, 0xb6, 0xef, 0xd5, 0xfb, 0xf3, 0x0d, 0x3b, 0x44, 0x72, 0xbc, 0xc9, 0x32, 0xfc, 0x30, 0x74,
+    0xdb, 0xe6, 0x10, 0x2b, 0x22, 0xcb, 0x36, 0x6e, 0xce, 0xf9, 0x52, 0x4e, 0xe9, 0xec, 0x4a, 0x85,
+    0xf9, 0x66, 0xfd, 0x12, 0x22, 0x2a, 0xd6, 0x49, 0xc1, 0x50, 0xac, 0x45, 0x9b, 0x15, 0x7c, 0x24,
+    0x61, 0x3a, 0x95, 0x9b, 0xb0, 0x15, 0x7c, 0x65, 0xc2, 0xbb, 0x86, 0x53, 0x15, 0xec, 0xfc, 0x48,
+    0x9d, 0x37, 0xdf, 0xe3, 0x05, 0x3e, 0x6a, 0x63, 0x0d, 0x80, 0x4c, 0x83, 0xf1, 0x79, 0x62, 0x9b,
+    0x92, 0xd8, 0x45, 0x8f, 0x01, 0xef, 0xf1, 0x6b, 0x87, 0x33, 0x6c, 0x8e, 0x03, 0x07, 0x0f, 0x2b,
+    0x47, 0x86, 0xd0, 0x0d, 0xa1, 0xd4, 0x81, 0x23, 0xfd, 0xcf, 0xf0, 0x58, 0x8f, 0xa9, 0xf7, 0x46,
+    0xec, 0xb1, 0xd5, 0xe7, 0x1a, 0x7e, 0xa9, 0xc8, 0x7b, 0x4d, 0xb5, 0x4a, 0x2b, 0x55, 0x90, 0xb5,
+    0x5b, 0xb4, 0x7d, 0xe6, 0x0a, 0xa4, 0xbc, 0xba, 0x40, 0x1d, 0x88, 0x54, 0x4b, 0x42, 0xdf, 0x61,
+    0xaf, 0x64, 0x22, 0x14, 0xc2, 0x81, 0x39, 0x3c, 0x6b, 0xdf, 0xc1, 0x29, 0xe3, 0x7d, 0xc2, 0xf0,
+    0x89, 0xa9, 0xf3, 0x28, 0x7b, 0xc0, 0x8f, 0x09, 0x0d, 0x0c, 0xc5, 0x31, 0xb5, 0x19, 0x87, 0x9a,
+    0x55, 0x58, 0xea, 0x08, 0xea, 0x31, 0x91, 0xba, 0xed, 0x3a, 0x17, 0x54, 0x4d, 0x32, 0x3a, 0x68,
+    0xd6, 0x9b, 0x64, 0x93, 0xf2, 0xec, 0x89, 0x67, 0x46, 0x75, 0xf5, 0x83, 0xcd, 0x1e, 0xf5, 0x15,
+    0x21, 0xbb, 0xc8, 0x92, 0x28, 0xc8, 0x85, 0xcb, 0x21, 0x67, 0x7e, 0x56, 0x88, 0xca, 0x4b, 0x39,
+    0xbb, 0xd5, 0x36, 0x70, 0x03, 0x77, 0x76, 0xeb, 0x6a, 0xd3, 0x8d, 0x4c, 0x19, 0xa3, 0xb3, 0xcf,
+    0xbd, 0xab, 0x36, 0xcb, 0x3e, 0xf7, 0xaf, 0x1a, 0xba, 0xca, 0xf9, 0x22, 0xb9, 0xd3, 0x4c, 0xeb,
+    0x4b, 0x28, 0xa7, 0xec, 0x45, 0x2f, 0xe0, 0x3c, 0x4a, 0x45, 0x25, 0x5d, 0x48, 0x62, 0x9b, 0x66,
+    0x39, 0x55, 0xf9, 0x51, 0xb7, 0x2f, 0xe9, 0xbc, 0x8e, 0xdd, 0xd4, 0x0e, 0x6e, 0x16, 0xae, 0x6f,
+    0xb5, 0xea, 0x77, 0x59, 0xdf, 0x2a, 0x09, 0x10, 0x78, 0x7b, 0x51, 0xb0, 0xb1, 0x4f, 0x06, 0x73,
+    0x10, 0xc3, 0xf1, 0xb0, 0x6d, 0xd2, 0x1f, 0xea, 0x1a, 0x65, 0x45, 0xb5, 0xc8, 0x0b, 0x8a, 0x52,
+    0x0d, 0xa9, 0x20, 0x64, 0x68, 0x93, 0x6e, 0x23, 0xe7, 0xf6, 0x9a, 0x3a, 0xbd, 0xc2, 0xf2, 0xb1,
+    0xaf, 0x8b, 0xdf, 0x5b, 0xaf, 0xa5, 0x48, 0xcf, 0x55, 0xff, 0x22, 0xb0, 0x3a, 0x28, 0xab, 0x2b,
+    0x85, 0xf2, 0xc4, 0xcb, 0xca, 0x2b, 0x17, 0x3c, 0xfe, 0x97, 0x9f, 0xe2, 0xe1, 0x6e, 0x7e, 0x2d,
+    0x3f, 0xa9, 0x1b, 0x98, 0xed, 0x21, 0xaf, 0x6a, 0xa6, 0xe1, 0x1d, 0xcf, 0xf4, 0x7a, 0x31, 0x00,
+    0x32, 0xf0, 0x00, 0x35, 0x01, 0xd7, 0xe0, 0x9e, 0xab, 0x1f, 0x8d, 0xc6, 0x54, 0x7b, 0x73, 0x3f,
+    0x8a, 0xfe, 0x54, 0x5f, 0xba, 0x15, 0xeb, 0xd5, 0x9b, 0xd1, 0x6c, 0x6e, 0x33, 0xf5, 0xe9, 0x1a,
+    0x02, 0xa8, 0xa7, 0xbf, 0x80, 0xbf, 0xfc, 0x24, 0x0d, 0x57, 0x97, 0x2f, 0x8f, 0xad, 0x06, 0x2d,
+    0xa8, 0x0d, 0x00, 0x0d, 0xe0, 0x97, 0x1a, 0x08, 0x4e, 0x81, 0x0a, 0x5f, 0xda, 0x0c, 0x3f, 0xb9,
+    0x28, 0x87, 0xf0, 0x45, 0x61, 0x68, 0xda, 0xda, 0xe2, 0x2e, 0xdc, 0x2e, 0xb6, 0xa9, 0xc1, 0x7f,
+    0xc8, 0x11, 0x4b, 0xb8, 0x76, 0xc3, 0xa6, 0x6f, 0xf5, 0xa2, 0xb2, 0x1f, 0x51, 0x79, 0x92, 0x8b,
+    0x45, 0x75, 0x5e, 0x5a, 0x9b, 0xe9, 0xf1, 0x45, 0x91, 0x66, 0x78, 0x3c, 0x95, 0x89, 0x65, 0x5b,
+    0xbc, 0x0c, 0x15, 0x75, 0x4f, 0x2c, 0x3e, 0x65, 0x28, 0x7b, 0x1c, 0x33, 0x30, 0x2d, 0xd5, 0x2e,
+    0xc2, 0x2f, 0x32, 0xd0, 0x4b, 0xe0, 0x57, 0x0e, 0x2c, 0x94, 0xae, 0x37, 0x33, 0xdb, 0x64, 0xb4,
+    0xa4, 0xb8, 0x7d, 0x2c, 0x6f, 0x1a, 0x41, 0xda, 0x7b, 0x3d, 0xf6, 0x5f, 0x67, 0xa7, 0x6f, 0xa5,
+    0x4c, 0x3f, 0x08, 0xf0, 0xc3, 0x5c, 0xdf, 0x59, 0xce, 0x7c, 0x17, 0xea, 0x4e, 0x60, 0xd2, 0xb1,
+    0xd5, 0x4d, 0x3e, 0x38, 0xd6, 0x8c, 0x66, 0xee, 0x5d, 0xc5, 0x90, 0x9b, 0xc4, 0xc5, 0x57, 0x11,
+    0x6b, 0x4d, 0x3b, 0xcd, 0x5e, 0x53, 0x9f, 0xd7, 0xb0, 0x65, 0xe1, 0x22, 0x1e, 0xa3, 0x1b, 0x2d,
+    0xf0, 0x26, 0x84, 0x87, 0x2d, 0xdd, 0xe0, 0x52, 0xd1, 0xfc, 0x1e, 0x08, 0x15, 0x77, 0x68, 0xb5,
+    0xab, 0xb1, 0xcd, 0x1d, 0xb3, 0x7b, 0x70, 0x88, 0x3c, 0x4d, 0xe2, 0x5c, 0x5c, 0xc2, 0xb8, 0x81,
+    0x47, 0x60, 0x3a, 0xff, 0x0b, 0x88, 0x6c, 0xf5, 0xf1, 0x08, 0x9b, 0x71, 0xd0, 0xb0, 0x5f, 0x70,
+    0x84, 0x0a, 0xcd, 0x17, 0xbc, 0xdc, 0x05, 0x78, 0x2e, 0x6a, 0x6f, 0x17, 0xa2, 0x60, 0xe4, 0x68,
+    0x3d, 0xe1, 0xf7, 0xcb, 0x4e, 0x51, 0xe0, 0xdb, 0x5d, 0xa5, 0xc7, 0x9f, 0xf1, 0xdf, 0x1e, 0x1c,
+    0x62, 0x2c, 0x98, 0xb9, 0xf8, 0x48, 0xa7, 0x74, 0x40, 0x06, 0xb9, 0xf9, 0xa9, 0xfa, 0xf6, 0x85,
+    0x26, 0x45, 0xec, 0x41, 0xc1, 0xf7, 0xf1, 0xc3, 0xbb, 0xd7, 0x49, 0x94, 0xe2, 0x71, 0x51, 0x22,
+    0x54, 0x4b, 0x1d, 0x30, 0x35, 0xfe, 0x1c, 0xb7, 0x67, 0xe6, 0x6b, 0x73, 0x29, 0x2e, 0xaf, 0xd7,
+    0x22, 0x09, 0x7d, 0xb9, 0xad, 0xdf, 0x86, 0xab, 0x70, 0x86, 0xf1, 0xdb, 0xa5, 0x2b, 0x5c, 0xe3,
+    0x11, 0x66, 0x1d, 0xb8, 0x70, 0x4c, 0xbb, 0x4b, 0xee, 0x67, 0x62, 0xd5, 0x7d, 0xe0, 0x24, 0xc6,
+    0xd4, 0xe0, 0x2d, 0xe8, 0x2b, 0xf2, 0x43, 0xca, 0x21, 0xc3, 0x1d, 0x95, 0x49, 0xe0, 0x77, 0xd5,
+    0x40, 0x1e, 0x62, 0x87, 0xfa, 0x2c, 0x90, 0xaa, 0x4b, 0x0d, 0xd5, 0xff, 0x14, 0xd6, 0x2f, 0xe3,
+    0x39, 0x75, 0x45, 0xe2, 0xc4, 0x5b, 0x40, 0x44, 0x08, 0x61, 0x0f, 0xc0, 0xdf, 0x43, 0x28, 0x27,
+    0x98, 0xf3, 0x71, 0x91, 0x7d, 0x11, 0x01, 0x04, 0x80, 0x77, 0x17, 0x6d, 0xfa, 0xc7, 0x20, 0x6d,
+    0x2a, 0x31, 0x5b, 0x3b, 0xc0, 0x04, 0x7d, 0x1b, 0x07, 0xda, 0x5f, 0xb9, 0x39, 0x25, 0x47, 0xa0,
+    0x0e, 0x34, 0x84, 0x77, 0x6a, 0x32, 0x67, 0x70, 0xc6, 0x7a, 0xa0, 0x24, 0x4b, 0xd9, 0xa1, 0x5f,
+    0x8f, 0xfb, 0x3a, 0xcb, 0x56, 0x4e, 0xc8, 0xe0, 0x9c, 0xb5, 0xdf, 0xeb, 0xe1, 0xad, 0x85, 0x49,
+    0x45, 0x03, 0xb4, 0xd9, 0xf3, 0x9e, 0x9a, 0x84, 0x4a, 0x49, 0x7f, 0x67, 0x02, 0x95, 0xa4, 0xfa,
+    0xf0, 0x53, 0xfd, 0xab, 0xf2, 0xff, 0x07, 0xc4, 0xa2, 0x9d, 0x31, 0x66, 0x3e, 0x00, 0x00,
+};
@@ -2,14 +2,9 @@
 #include "config.h"
 #include "logger.h"
 #include "settings_module.h" 
+#include "hal.h"
 
-#include <WiFi.h>
-#include <WebServer.h>
-#include <Preferences.h>
-
-static Preferences prefs;
-static WebServer cfgServer(80);
-static NetConfig currentCfg;
+static HalNvs prefs;
 
 void netcfgLoad(NetConfig &cfg) {
     // 1. WLAN (aus netcfg)
@@ -35,6 +30,14 @@ void netcfgSave(const NetConfig &cfg) {
     settingsSetMqttPort(cfg.mqttPort); // <--- Port speichern
 }
 
+// === PORTAL (nur auf dem Gerät, braucht WebServer + SoftAP) ===
+#ifndef HAL_HOST
+#include <WiFi.h>
+#include <WebServer.h>
+
+static WebServer cfgServer(80);
+static NetConfig currentCfg;
+
 static void handleRoot() {
     String html = "<html><head><title>Setup</title>";
     html += "<meta name='viewport' content='width=device-width, initial-scale=1'>";
@@ -101,4 +104,12 @@ void wifiConfigPortal() {
             digitalWrite(PIN_STATUS_LED, !digitalRead(PIN_STATUS_LED));
         }
     }
-}
\ No newline at end of file
+}
+
+#else
+
+void wifiConfigPortal() {
+    logWarn("Config portal not available on host");
+}
+
+#endif
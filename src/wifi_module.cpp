@@ -1,12 +1,14 @@
 // Firmware V1.2.7 - WiFi Module (Settings Integration Fix)
 #include "wifi_module.h"
 #include "config.h"
+#include "clock_module.h"
+#include "hal.h"
 #include "logger.h"
 #include "wifi_config_module.h"
 #include "valve_module.h"
 #include "settings_module.h" // <--- WICHTIG
+#include "metrics_module.h"
 
-#include <WiFi.h>
 
 static NetConfig netCfg;
 static unsigned long lastReconnectAttempt = 0;
@@ -17,8 +19,8 @@ static const unsigned long WIFI_MAX_DOWN_MS = 5UL * 60UL * 1000UL;
 static unsigned long reconnectCounter = 0; 
 
 void wifiInit() {
-    pinMode(PIN_CFG_BUTTON, INPUT_PULLUP);
-    if (digitalRead(PIN_CFG_BUTTON) == LOW) {
+    halPinMode(PIN_CFG_BUTTON, INPUT_PULLUP);
+    if (halDigitalRead(PIN_CFG_BUTTON) == LOW) {
         wifiConfigPortal(); // Blockiert, bis Config fertig
     }
 
@@ -29,49 +31,48 @@ void wifiInit() {
     String realMqttHost = settingsGetMqttHost();
     logInfo("WiFi using SSID=" + netCfg.ssid + " MQTT Host=" + realMqttHost);
 
-    WiFi.mode(WIFI_STA);
-    WiFi.begin(netCfg.ssid.c_str(), netCfg.pass.c_str());
-    lastReconnectAttempt = millis();
-    lastWifiOkMs = millis();
+    halWifiBegin(netCfg.ssid.c_str(), netCfg.pass.c_str());
+    lastReconnectAttempt = clockMillis();
+    lastWifiOkMs = clockMillis();
     reconnectCounter = 0;
 }
 
 void wifiLoop() {
-    if (WiFi.status() == WL_CONNECTED) {
-        lastWifiOkMs = millis();
+    if (halWifiConnected()) {
+        lastWifiOkMs = clockMillis();
         reconnectCounter = 0; 
         return;
     }
 
-    unsigned long now = millis();
+    unsigned long now = clockMillis();
     if (now - lastReconnectAttempt > WIFI_RECONNECT_INTERVAL_MS) {
         lastReconnectAttempt = now;
         reconnectCounter++;
+        metricInc(MC_WIFI_RECONNECTS);
 
         logWarn("WiFi disconnected, reconnect attempt #" + String(reconnectCounter));
-        WiFi.disconnect(false, false);
-        WiFi.mode(WIFI_STA);
-        WiFi.begin(netCfg.ssid.c_str(), netCfg.pass.c_str());
+        halWifiDisconnect();
+        halWifiBegin(netCfg.ssid.c_str(), netCfg.pass.c_str());
     }
 
     if (now - lastWifiOkMs > WIFI_MAX_DOWN_MS) {
         logError("WiFi down > 5min, rebooting (safe valve close)");
         valveSafeBeforeUpdate();
-        delay(500);
-        ESP.restart();
+        halDelay(500);
+        halRestart();
     }
 }
 
 bool wifiIsConnected() {
-    return WiFi.status() == WL_CONNECTED;
+    return halWifiConnected();
 }
 
 String wifiGetIp() {
     if (!wifiIsConnected()) return String("0.0.0.0");
-    return WiFi.localIP().toString();
+    return halWifiIp();
 }
 
 int wifiGetRssi() {
     if (!wifiIsConnected()) return 0;
-    return WiFi.RSSI();
+    return halWifiRssi();
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+// Loop-Benchmark: setup() und loop() aus main.cpp auf dem Host-Backend,
+// echte CPU-Zeit (halRealMicros) je loop() bei simuliertem 100-ms-Takt.
+//   pio test -e native -f test_benchmark -v     (Werte stehen in der Ausgabe)
+// Die Zahlen sind Host-Zeiten, nicht die des ESP32 - zum Vergleich zweier
+// Stände auf demselben Rechner (z.B. vor/nach einer Änderung am Loop).
+#include <unity.h>
+#include "hal.h"
+#include "config.h"
+#include "clock_module.h"
+#include "valve_module.h"
+#include "irrigation_module.h"
+
+void setup();
+void loop();
+
+static const uint32_t STEP_MS = 100;
+static const uint32_t LOOPS = 6000;        // 10 min Gerätezeit je Messung
+
+struct LoopStats {
+    double   avgUs;
+    uint32_t maxUs;
+};
+
+// flowLpm > 0: Impulse wie der Sensor (450 Impulse/L) zwischen den Durchläufen
+static LoopStats runLoops(uint32_t loops, float flowLpm) {
+    LoopStats st = { 0, 0 };
+    double acc = 0;
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < loops; i++) {
+        unsigned long t0 = halRealMicros();
+        loop();
+        uint32_t us = halRealMicros() - t0;
+        sum += us;
+        if (us > st.maxUs) st.maxUs = us;
+
+        acc += flowLpm * 450.0f / 60.0f * (STEP_MS / 1000.0f);
+        uint32_t n = (uint32_t)acc;
+        if (n > 0) {
+            acc -= n;
+            halHostPulses(PIN_FLOW, n, STEP_MS * 1000 / n);
+        } else {
+            halHostAdvanceMs(STEP_MS);
+        }
+    }
+    st.avgUs = (double)sum / loops;
+    return st;
+}
+
+static void report(const char* name, const LoopStats &st) {
+    char buf[128];
+    snprintf(buf, sizeof(buf), "%-22s %8.2f us/loop  (max %u us, %u loops)", name, st.avgUs, st.maxUs, LOOPS);
+    TEST_MESSAGE(buf);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_boot() {
+    halHostReset();
+    halHostNvsErase();
+    clockSimReset(0, 1780272000);       // 2026-06-01 00:00 UTC
+    unsigned long t0 = halRealMicros();
+    setup();
+    char buf[64];
+    snprintf(buf, sizeof(buf), "setup()                %8lu us", halRealMicros() - t0);
+    TEST_MESSAGE(buf);
+    runLoops(100, 0);                   // MQTT verbinden, Boot-Events
+}
+
+void test_loop_idle() {
+    uint32_t feeds = halHostWdtFeeds();
+    LoopStats st = runLoops(LOOPS, 0);
+    report("idle (online)", st);
+    TEST_ASSERT_EQUAL_UINT32(0, halHostRestarts());
+    TEST_ASSERT_GREATER_OR_EQUAL(LOOPS, halHostWdtFeeds() - feeds);
+}
+
+void test_loop_valve_open() {
+    irrigationSetMode(IrrigationMode::MANUAL);
+    valveSet(ValveState::OPEN);
+    LoopStats st = runLoops(LOOPS, 12.0f);
+    report("valve open, 12 L/min", st);
+    TEST_ASSERT_EQUAL(ValveState::OPEN, valveGetState());
+    valveSet(ValveState::CLOSED);
+    runLoops(100, 0);                   // Nachlauf, Schließ-Events
+}
+
+void test_loop_mqtt_offline() {
+    halHostSetMqtt(false);
+    LoopStats st = runLoops(LOOPS, 0);
+    report("offline (Verlauf puffert)", st);
+    halHostSetMqtt(true);
+    st = runLoops(LOOPS, 0);
+    report("reconnect + Nachsenden", st);
+    TEST_ASSERT_EQUAL_UINT32(0, halHostRestarts());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_boot);
+    RUN_TEST(test_loop_idle);
+    RUN_TEST(test_loop_valve_open);
+    RUN_TEST(test_loop_mqtt_offline);
+    return UNITY_END();
+}
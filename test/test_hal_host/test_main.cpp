@@ -0,0 +1,262 @@
+// HAL-Host-Backend (src/hal_host.cpp): GPIO/ISR, NVS, MQTT-Attrappe.
+//   pio test -e native -f test_hal_host
+#include <unity.h>
+#include "hal.h"
+#include "config.h"
+#include "clock_module.h"
+#include "flow_module.h"
+#include "mqtt_module.h"
+
+extern unsigned long rtcTotalPulses;    // flow_module.cpp (RTC-RAM auf dem Gerät)
+
+static const uint8_t TEST_PIN = 10;
+static const time_t T0 = 1780272000;    // 2026-06-01 00:00 UTC
+
+static int isrCalls = 0;
+static void countIsr() { isrCalls++; }
+
+static String lastCmd;
+static int cmdCalls = 0;
+static void onCmd(const String &cmd) {
+    lastCmd = cmd;
+    cmdCalls++;
+}
+
+void setUp() {
+    halHostReset();
+    clockSimReset(0, T0);
+    isrCalls = 0;
+    cmdCalls = 0;
+    lastCmd = "";
+}
+
+void tearDown() {}
+
+// === GPIO / INTERRUPTS ===
+void test_isr_fires_on_configured_edge_only() {
+    halPinMode(TEST_PIN, INPUT_PULLUP);
+    halAttachInterrupt(TEST_PIN, countIsr, FALLING);
+    TEST_ASSERT_EQUAL(HIGH, halDigitalRead(TEST_PIN));  // Pull-up ohne äußeren Pegel
+
+    halHostSetInput(TEST_PIN, LOW);
+    TEST_ASSERT_EQUAL(1, isrCalls);
+    halHostSetInput(TEST_PIN, LOW);                     // kein Pegelwechsel
+    TEST_ASSERT_EQUAL(1, isrCalls);
+    halHostSetInput(TEST_PIN, HIGH);                    // steigend
+    TEST_ASSERT_EQUAL(1, isrCalls);
+
+    halAttachInterrupt(TEST_PIN, countIsr, CHANGE);
+    halHostSetInput(TEST_PIN, LOW);
+    halHostSetInput(TEST_PIN, HIGH);
+    TEST_ASSERT_EQUAL(3, isrCalls);
+}
+
+void test_edges_masked_while_interrupts_off() {
+    halPinMode(TEST_PIN, INPUT_PULLUP);
+    halAttachInterrupt(TEST_PIN, countIsr, FALLING);
+    halInterruptsOff();
+    halHostPulses(TEST_PIN, 5, 1000);
+    halInterruptsOn();
+    TEST_ASSERT_EQUAL(0, isrCalls);
+    halHostPulses(TEST_PIN, 5, 1000);
+    TEST_ASSERT_EQUAL(5, isrCalls);
+}
+
+void test_pulses_advance_simulated_clock() {
+    halPinMode(TEST_PIN, INPUT_PULLUP);
+    halAttachInterrupt(TEST_PIN, countIsr, FALLING);
+    unsigned long us0 = clockMicros();
+    halHostPulses(TEST_PIN, 40, 2500);
+    TEST_ASSERT_EQUAL(40, isrCalls);
+    TEST_ASSERT_EQUAL_UINT32(100000, clockMicros() - us0);
+    TEST_ASSERT_EQUAL_UINT32(100, clockMillis());
+}
+
+void test_output_pin_levels() {
+    TEST_ASSERT_EQUAL(-1, halHostGetOutput(PIN_RELAY));     // noch hochohmig
+    halPinMode(PIN_RELAY, OUTPUT);
+    halDigitalWrite(PIN_RELAY, HIGH);
+    TEST_ASSERT_EQUAL(HIGH, halHostGetOutput(PIN_RELAY));
+    halDigitalWrite(PIN_RELAY, LOW);
+    TEST_ASSERT_EQUAL(LOW, halHostGetOutput(PIN_RELAY));
+    halHostReset();
+    TEST_ASSERT_EQUAL(-1, halHostGetOutput(PIN_RELAY));
+}
+
+void test_adc_reads_injected_millivolts() {
+    halAnalogInit(PIN_BATTERY_ADC);
+    halHostSetAnalogMv(PIN_BATTERY_ADC, 1875);
+    TEST_ASSERT_EQUAL_UINT32(1875, halAnalogReadMilliVolts(PIN_BATTERY_ADC));
+}
+
+// Echte ISR aus flow_module: 20 L/min bei 450 Impulsen/L = 150 Impulse/s
+void test_flow_module_counts_isr_pulses() {
+    flowInit();
+    unsigned long total0 = flowGetTotalPulses();
+    uint32_t isr0 = flowGetIsrPulses();
+    for (int i = 0; i < 20; i++) {
+        halHostPulses(PIN_FLOW, 15, 6666);
+        halHostAdvanceMs(1);
+        flowLoop();
+    }
+    halHostAdvanceMs(100);
+    flowLoop();
+    TEST_ASSERT_EQUAL_UINT32(300, flowGetIsrPulses() - isr0);
+    TEST_ASSERT_EQUAL_UINT32(300, flowGetTotalPulses() - total0);
+}
+
+void test_flow_glitch_filter_drops_fast_edges() {
+    flowInit();
+    uint32_t isr0 = flowGetIsrPulses();
+    halHostPulses(PIN_FLOW, 10, 100);           // Abstand < MIN_PULSE_SPACING_US
+    uint32_t n = flowGetIsrPulses() - isr0;
+    TEST_ASSERT_GREATER_THAN(0, n);
+    TEST_ASSERT_LESS_THAN(10, n);
+}
+
+// === NVS ===
+void test_nvs_survives_reset() {
+    HalNvs p;
+    p.begin("test-hal", false);
+    p.putInt("i", -42);
+    p.putULong("u", 4000000000UL);
+    p.putFloat("f", 3.25f);
+    p.putString("s", "hello");
+    p.putLong64("l", -1234567890123LL);
+    uint8_t blob[5] = { 1, 2, 3, 4, 5 };
+    p.putBytes("b", blob, sizeof(blob));
+    p.end();
+
+    halHostReset();
+
+    p.begin("test-hal", true);
+    TEST_ASSERT_EQUAL_INT32(-42, p.getInt("i"));
+    TEST_ASSERT_EQUAL_UINT32(4000000000UL, p.getULong("u"));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 3.25f, p.getFloat("f"));
+    TEST_ASSERT_EQUAL_STRING("hello", p.getString("s").c_str());
+    TEST_ASSERT_TRUE(p.getLong64("l") == -1234567890123LL);
+    uint8_t back[8] = { 0 };
+    TEST_ASSERT_EQUAL(5, p.getBytesLength("b"));
+    TEST_ASSERT_EQUAL(5, p.getBytes("b", back, sizeof(back)));
+    TEST_ASSERT_EQUAL(0, memcmp(blob, back, sizeof(blob)));
+    TEST_ASSERT_EQUAL(7, p.getInt("missing", 7));
+    p.end();
+}
+
+void test_nvs_read_only_and_namespaces() {
+    HalNvs p;
+    p.begin("test-ro", true);
+    TEST_ASSERT_EQUAL(0, p.putInt("x", 1));
+    TEST_ASSERT_EQUAL(9, p.getInt("x", 9));
+    p.end();
+
+    p.begin("test-ns-a", false);
+    p.putInt("x", 1);
+    p.end();
+    p.begin("test-ns-b", false);
+    TEST_ASSERT_EQUAL(0, p.getInt("x", 0));
+    p.end();
+
+    halHostNvsErase();
+    p.begin("test-ns-a", true);
+    TEST_ASSERT_EQUAL(0, p.getInt("x", 0));
+    p.end();
+}
+
+// Stromausfall: RTC-Zähler weg, Stand kommt aus dem NVS zurück
+void test_flow_total_restored_from_nvs() {
+    flowInit();
+    halHostPulses(PIN_FLOW, 45, 10000);
+    halHostAdvanceMs(100);
+    flowLoop();
+    unsigned long saved = flowGetTotalPulses();
+    TEST_ASSERT_GREATER_THAN(0, saved);
+    flowSaveToFlash();
+
+    halHostReset();
+    rtcTotalPulses = 0;
+    flowInit();
+    TEST_ASSERT_EQUAL_UINT32(saved, flowGetTotalPulses());
+}
+
+// === MQTT ===
+// Der Reconnect-Zeitstempel im Modul überlebt setUp(): bis zu zwei Abstände warten
+static void mqttConnect() {
+    mqttInit();
+    mqttSetCommandCallback(onCmd);
+    for (int i = 0; i < 3 && !mqttIsConnected(); i++) {
+        halHostAdvanceMs(6000);
+        mqttLoop();
+    }
+    TEST_ASSERT_TRUE(mqttIsConnected());
+}
+
+static int countTopic(const char* topic) {
+    int n = 0;
+    for (const HalHostMessage &m : halHostMqttLog()) if (m.topic == topic) n++;
+    return n;
+}
+
+void test_mqtt_connect_publishes_online() {
+    mqttConnect();
+    bool online = false;
+    for (const HalHostMessage &m : halHostMqttLog()) {
+        if (m.topic == TOPIC_LWT && m.payload == MQTT_PAYLOAD_ONLINE && m.retained) online = true;
+    }
+    TEST_ASSERT_TRUE(online);
+}
+
+void test_mqtt_inject_reaches_command_callback() {
+    mqttConnect();
+    halHostMqttInject(TOPIC_CMD, "{\"cmd\":\"alarm_reset\"}");
+    TEST_ASSERT_EQUAL(1, cmdCalls);
+    TEST_ASSERT_EQUAL_STRING("{\"cmd\":\"alarm_reset\"}", lastCmd.c_str());
+
+    halHostMqttInject(TOPIC_STATE, "OPEN");     // nicht abonniert
+    TEST_ASSERT_EQUAL(1, cmdCalls);
+}
+
+void test_mqtt_broker_down_drops_publish_and_inject() {
+    mqttConnect();
+    halHostMqttClearLog();
+    halHostSetMqtt(false);
+    TEST_ASSERT_FALSE(mqttPublish(TOPIC_DIAG, "x"));
+    TEST_ASSERT_FALSE(mqttIsConnected());
+    halHostMqttInject(TOPIC_CMD, "MODE_AUTO");
+    TEST_ASSERT_EQUAL(0, cmdCalls);
+    TEST_ASSERT_EQUAL(0, halHostMqttLog().size());
+
+    halHostSetMqtt(true);
+    mqttConnect();
+    TEST_ASSERT_TRUE(mqttPublish(TOPIC_DIAG, "y"));
+    TEST_ASSERT_EQUAL(1, countTopic(TOPIC_DIAG));
+    TEST_ASSERT_EQUAL_STRING("y", halHostMqttLog().back().payload.c_str());
+}
+
+void test_mqtt_log_keeps_latest() {
+    mqttConnect();
+    halHostMqttClearLog();
+    for (int i = 0; i < 300; i++) mqttPublish(TOPIC_DIAG, String(i).c_str());
+    TEST_ASSERT_EQUAL(256, halHostMqttLog().size());
+    TEST_ASSERT_EQUAL_STRING("44", halHostMqttLog().front().payload.c_str());
+    TEST_ASSERT_EQUAL_STRING("299", halHostMqttLog().back().payload.c_str());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_isr_fires_on_configured_edge_only);
+    RUN_TEST(test_edges_masked_while_interrupts_off);
+    RUN_TEST(test_pulses_advance_simulated_clock);
+    RUN_TEST(test_output_pin_levels);
+    RUN_TEST(test_adc_reads_injected_millivolts);
+    RUN_TEST(test_flow_module_counts_isr_pulses);
+    RUN_TEST(test_flow_glitch_filter_drops_fast_edges);
+    RUN_TEST(test_nvs_survives_reset);
+    RUN_TEST(test_nvs_read_only_and_namespaces);
+    RUN_TEST(test_flow_total_restored_from_nvs);
+    RUN_TEST(test_mqtt_connect_publishes_online);
+    RUN_TEST(test_mqtt_inject_reaches_command_callback);
+    RUN_TEST(test_mqtt_broker_down_drops_publish_and_inject);
+    RUN_TEST(test_mqtt_log_keeps_latest);
+    return UNITY_END();
+}
@@ -0,0 +1,129 @@
+// Cron-Regeln im laufenden Betrieb (setup()/loop() aus main.cpp auf der
+// simulierten Uhr): Import nach langer Laufzeit, Nachholen nach Hängern.
+//   pio test -e native -f test_rules
+// Alle Tests laufen nacheinander auf derselben Zeitachse ab einem Boot.
+#include <unity.h>
+#include "hal.h"
+#include "config.h"
+#include "clock_module.h"
+#include "valve_module.h"
+#include "irrigation_module.h"
+#include "rules_module.h"
+
+void setup();
+void loop();
+
+static const time_t T0 = 1780272000;                // Mo 2026-06-01 07:00 ICT
+
+static bool booted = false;
+static int opens = 0;                               // Ventil-Öffnungen seit Boot
+
+// Ein Durchlauf; Ventil offen: 100-ms-Takt mit 12 L/min (450 Impulse/L), sonst 1 s
+static void step() {
+    bool was = valveGetState() == ValveState::OPEN;
+    loop();
+    bool open = valveGetState() == ValveState::OPEN;
+    if (open && !was) opens++;
+    if (!open) {
+        halHostAdvanceMs(1000);
+        return;
+    }
+    halHostPulses(PIN_FLOW, 9, 10000);
+    halHostAdvanceMs(10);
+}
+
+static void runUntil(time_t t) {
+    while (clockNow() < t) step();
+}
+
+// Wie der Web-Import (RULES_APPLY läuft im Haupt-Loop)
+static void importRules(const char* json) {
+    RuleSpec rules[MAX_RULES];
+    String err;
+    int n = rulesParseJson(json, rules, MAX_RULES, err);
+    TEST_ASSERT_TRUE_MESSAGE(n >= 0 && err.length() == 0, err.c_str());
+    rulesSet(rules, n);
+}
+
+void setUp() {
+    if (booted) return;
+    halHostReset();
+    halHostNvsErase();
+    clockSimReset(0, T0);
+    setup();
+    irrigationSetMode(IrrigationMode::AUTO);
+    booted = true;
+}
+
+void tearDown() {}
+
+// 3 Tage ohne Regeln, dann stündliche Regel importieren: nichts rückwirkend,
+// erst die nächste volle Stunde läuft
+void test_import_after_long_uptime_fires_nothing() {
+    runUntil(T0 + 3 * 86400 + 20 * 60);             // xx:20
+    TEST_ASSERT_EQUAL_INT(0, opens);
+
+    importRules("[{\"cron\":\"0 * * * *\",\"dur\":60}]");
+    runUntil(clockNow() + 30 * 60);                 // bis xx:50
+    TEST_ASSERT_EQUAL_INT(0, opens);
+    TEST_ASSERT_FALSE(irrigationIsRunning());
+    QueuedRun q[IRR_RUN_QUEUE_LEN];
+    TEST_ASSERT_EQUAL_INT(0, irrigationGetQueue(q));
+
+    runUntil(clockNow() + 20 * 60);                 // über die volle Stunde
+    TEST_ASSERT_EQUAL_INT(1, opens);
+}
+
+// Loop-Hänger über mehrere Termine: höchstens ein Nachholen je Regel,
+// und nur innerhalb IRR_CATCHUP_WINDOW_S
+void test_stall_catches_up_once_within_window() {
+    importRules("[{\"cron\":\"*/2 * * * *\",\"dur\":30}]");
+    runUntil(clockNow() + 60);
+    while (valveGetState() == ValveState::OPEN || irrigationIsRunning()) step();
+    int before = opens;
+
+    halHostAdvanceMs(IRR_CATCHUP_WINDOW_S * 1000UL - 60000);    // Hänger knapp im Fenster
+    step();
+    runUntil(clockNow() + 50);
+    TEST_ASSERT_EQUAL_INT(before + 1, opens);
+    QueuedRun q[IRR_RUN_QUEUE_LEN];
+    TEST_ASSERT_LESS_OR_EQUAL(1, irrigationGetQueue(q));
+
+    while (valveGetState() == ValveState::OPEN || irrigationIsRunning()) step();
+    importRules("[]");
+    before = opens;
+    halHostAdvanceMs(3600000UL);                    // eine Stunde Hänger ohne Regeln
+    importRules("[{\"cron\":\"* * * * *\",\"dur\":10}]");
+    step();
+    TEST_ASSERT_EQUAL_INT(before, opens);
+    importRules("[]");
+}
+
+// Zwei Regeln in derselben Minute (z.B. verschiedene Zonen um 06:00): beide
+// laufen, die zweite über die Warteschlange
+void test_two_rules_same_minute_both_run() {
+    while (valveGetState() == ValveState::OPEN || irrigationIsRunning()) step();
+    time_t at = clockNow() - clockNow() % 60 + 180;
+    struct tm tm;
+    clockLocal(at, tm);
+    char json[160];
+    snprintf(json, sizeof(json), "[{\"cron\":\"%d %d * * *\",\"dur\":60,\"zones\":1},"
+             "{\"cron\":\"%d %d * * *\",\"dur\":90,\"zones\":%d}]", tm.tm_min, tm.tm_hour, tm.tm_min, tm.tm_hour,
+             VALVE_ZONES > 1 ? 2 : 1);
+    importRules(json);
+
+    int before = opens;
+    unsigned long daily0 = valveGetDailyOpenSec();
+    runUntil(at + 10 * 60);
+    TEST_ASSERT_EQUAL_INT(before + 2, opens);
+    TEST_ASSERT_UINT_WITHIN(2, 150, valveGetDailyOpenSec() - daily0);
+    importRules("[]");
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_import_after_long_uptime_fires_nothing);
+    RUN_TEST(test_stall_catches_up_once_within_window);
+    RUN_TEST(test_two_rules_same_minute_both_run);
+    return UNITY_END();
+}
@@ -0,0 +1,249 @@
+// Zeitplan über ein ganzes Jahr in CET/CEST (Europa statt TIME_TZ_POSIX):
+// scheduleNextOccurrence() direkt und irrigationLoop() auf der simulierten
+// Uhr mit Loop-Hängern und NTP-Sprüngen vor und zurück. Jeder Slot muss an
+// jedem fälligen Tag genau einmal starten.
+//   pio test -e native -f test_schedule_dst
+#include <unity.h>
+#include "hal.h"
+#include "config.h"
+#include "clock_module.h"
+#include "irrigation_module.h"
+#include "schedule_module.h"
+#include "sequencer_module.h"
+#include "valve_module.h"
+
+void setup();
+
+static const char* TZ_EUROPE = "CET-1CEST,M3.5.0,M10.5.0/3";
+static const time_t YEAR_START = 1767222000;    // 2026-01-01 00:00 CET
+static const int YEAR_DAYS = 365;
+static const int SPRING_YDAY = 87;              // So 29.03.2026: 02:00 -> 03:00
+static const int AUTUMN_YDAY = 297;             // So 25.10.2026: 03:00 -> 02:00
+
+// 02:30 fehlt im Frühjahr und kommt im Herbst zweimal vor
+static const IrrigationSlot SLOTS[] = {
+    { true,  2, 30, 100, 127,  1, 0 },
+    { true,  6,  0, 200, 127,  1, 0 },
+    { true, 21, 15, 300, 0x12, 1, 0 },          // Mo + Do
+};
+static const int SLOT_COUNT = sizeof(SLOTS) / sizeof(SLOTS[0]);
+
+static const int CATCHUP_MIN = IRR_CATCHUP_WINDOW_S / 60;
+
+static void useEuropeTz() {
+    setenv("TZ", TZ_EUROPE, 1);
+    tzset();
+}
+
+static struct tm local(time_t t) {
+    struct tm tm;
+    clockLocal(t, tm);
+    return tm;
+}
+
+static bool dueOn(const IrrigationSlot &s, int wday) { return (s.weekDays >> wday) & 1; }
+
+// Lokale Startminute am Tag; im Frühjahr verschiebt mktime 02:30 auf 03:30
+static int expectedMinute(const IrrigationSlot &s, int yday) {
+    int m = s.startHour * 60 + s.startMinute;
+    if (yday == SPRING_YDAY && s.startHour == 2) m += 60;
+    return m;
+}
+
+void setUp() {
+    useEuropeTz();
+}
+
+void tearDown() {}
+
+// === scheduleNextOccurrence() ===
+void test_next_occurrence_once_per_due_day() {
+    for (int i = 0; i < SLOT_COUNT; i++) {
+        const IrrigationSlot &s = SLOTS[i];
+        int perDay[YEAR_DAYS + 1] = { 0 };
+        time_t t = YEAR_START - 1;
+        for (;;) {
+            time_t next = scheduleNextOccurrence(s, t);
+            TEST_ASSERT_GREATER_THAN(t, next);
+            TEST_ASSERT_LESS_OR_EQUAL(8 * 86400, next - t);
+            t = next;
+            struct tm tm = local(t);
+            if (tm.tm_year != 2026 - 1900) break;
+            TEST_ASSERT_TRUE(dueOn(s, tm.tm_wday));
+            TEST_ASSERT_EQUAL_INT(expectedMinute(s, tm.tm_yday), tm.tm_hour * 60 + tm.tm_min);
+            perDay[tm.tm_yday]++;
+        }
+        for (int d = 0; d < YEAR_DAYS; d++) {
+            struct tm tm = local(YEAR_START + d * 86400L + 12 * 3600);
+            char msg[48];
+            snprintf(msg, sizeof(msg), "slot %d yday %d", i + 1, tm.tm_yday);
+            TEST_ASSERT_EQUAL_INT_MESSAGE(dueOn(s, tm.tm_wday) ? 1 : 0, perDay[tm.tm_yday], msg);
+        }
+    }
+}
+
+void test_dst_days_are_23_and_25_hours() {
+    const IrrigationSlot &s = SLOTS[1];     // 06:00
+    time_t t = YEAR_START + SPRING_YDAY * 86400L - 7 * 86400L;
+    for (int d = 0; d < 220; d++) {
+        time_t a = scheduleNextOccurrence(s, t);
+        time_t b = scheduleNextOccurrence(s, a);
+        int yday = local(b).tm_yday;
+        long want = yday == SPRING_YDAY ? 23 * 3600 : yday == AUTUMN_YDAY ? 25 * 3600 : 86400;
+        TEST_ASSERT_EQUAL_INT32(want, (long)(b - a));
+        t = a;
+    }
+}
+
+// Doppelte Stunde: immer die erste 02:30 (Sommerzeit), die zweite ist derselbe Termin
+void test_autumn_repeated_hour_counts_once() {
+    const IrrigationSlot &s = SLOTS[0];
+    time_t day = YEAR_START + AUTUMN_YDAY * 86400L - 3600;     // 00:00 CEST
+    for (int i = 0; i < 3; i++) {
+        // mktime merkt sich die letzte Deutung: vorher beide Hälften der Stunde abfragen
+        local(day + 3 * 3600 + i * 1800);
+        time_t a = scheduleNextOccurrence(s, day);
+        TEST_ASSERT_EQUAL_INT(1, local(a).tm_isdst);
+        TEST_ASSERT_EQUAL_INT(150, local(a).tm_hour * 60 + local(a).tm_min);
+        TEST_ASSERT_EQUAL_INT32(86400 + 3600, (long)(scheduleNextOccurrence(s, a) - a));
+        TEST_ASSERT_EQUAL_INT32(86400 + 3600, (long)(scheduleNextOccurrence(s, a + 1800) - a));
+    }
+}
+
+// === irrigationLoop() über ein Jahr ===
+struct Fire {
+    int slot;
+    int yday;
+    int minute;     // lokal
+};
+
+static Fire fires[SLOT_COUNT * (YEAR_DAYS + 8)];
+static int fireCount = 0;
+static int stalls = 0;
+static int ntpForward = 0;
+static int ntpBack = 0;
+
+static uint32_t rng = 20260101;
+static uint32_t rnd(uint32_t n) {
+    rng = rng * 1103515245 + 12345;
+    return (rng >> 16) % n;
+}
+
+static int slotByDuration(int remainingSec) {
+    int best = 0;
+    for (int i = 1; i < SLOT_COUNT; i++) {
+        if (abs(remainingSec - SLOTS[i].durationSec) < abs(remainingSec - SLOTS[best].durationSec)) best = i;
+    }
+    return best;
+}
+
+// Jede Minute zufällig: ~1x/Tag ein Loop-Hänger (bis 5 min), ~1x/Tag ein
+// NTP-Sprung (±5 min). Zusätzlich gezielt um die Startzeiten: kurz nach
+// einem Start zurück hinter den Termin, kurz davor vorwärts darüber.
+static int lastTargetDay = -1;                          // gezielter Sprung höchstens einmal je Tag
+
+static void disturb(time_t now) {
+    struct tm tm = local(now);
+    int minute = tm.tm_hour * 60 + tm.tm_min;
+    if (tm.tm_sec >= 20) return;                        // einmal je Minute
+
+    for (int i = 0; i < SLOT_COUNT && lastTargetDay != tm.tm_yday; i++) {
+        int start = expectedMinute(SLOTS[i], tm.tm_yday);
+        if (tm.tm_yday % 9 == i && minute == start + 1) {
+            clockSimSetEpoch(now - 240);
+            ntpBack++;
+            lastTargetDay = tm.tm_yday;
+            return;
+        }
+        if (tm.tm_yday % 11 == i && minute == start - 2) {
+            clockSimSetEpoch(now + 300);
+            ntpForward++;
+            lastTargetDay = tm.tm_yday;
+            return;
+        }
+    }
+    if (rnd(1440) == 0) {
+        halHostAdvanceMs(60000 + rnd(240) * 1000);
+        stalls++;
+    }
+    if (rnd(1440) == 0) {
+        long step = 30 + rnd(270);
+        if (rnd(2)) {
+            clockSimSetEpoch(now + step);
+            ntpForward++;
+        } else {
+            clockSimSetEpoch(now - step);
+            ntpBack++;
+        }
+    }
+}
+
+static void simulateYear() {
+    halHostReset();
+    halHostNvsErase();
+    clockSimReset(0, YEAR_START);
+    setup();
+    useEuropeTz();                                      // setup() stellt TIME_TZ_POSIX ein
+
+    for (int i = 0; i < MAX_PROGRAM_SLOTS; i++) {
+        IrrigationSlot s = i < SLOT_COUNT ? SLOTS[i] : IrrigationSlot{ false, 0, 0, 60, 127, 1, 0 };
+        irrigationUpdateSlot(i, s);
+    }
+    irrigationSetMode(IrrigationMode::AUTO);
+
+    bool running = false;
+    while (clockNow() < YEAR_START + YEAR_DAYS * 86400L + 3600) {
+        // Tages-Reset wie loop() in main.cpp (sonst greift das Tageslimit)
+        struct tm d = local(clockNow());
+        valveRollDay((d.tm_year + 1900) * 10000 + (d.tm_mon + 1) * 100 + d.tm_mday);
+        seqLoop(clockMillis());
+        irrigationLoop();
+        time_t now = clockNow();
+        bool r = irrigationIsRunning();
+        if (r && !running) {
+            struct tm tm = local(now);
+            TEST_ASSERT_LESS_THAN((int)(sizeof(fires) / sizeof(fires[0])), fireCount);
+            fires[fireCount++] = { slotByDuration(irrigationGetRemainingSec()), tm.tm_yday + (tm.tm_year - 126) * YEAR_DAYS,
+                                   tm.tm_hour * 60 + tm.tm_min };
+        }
+        running = r;
+        disturb(now);
+        halHostAdvanceMs(20000);
+    }
+}
+
+void test_year_every_slot_fires_once_per_due_day() {
+    simulateYear();
+    char msg[64];
+    snprintf(msg, sizeof(msg), "%d runs, %d stalls, NTP %d forward / %d back", fireCount, stalls, ntpForward, ntpBack);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_GREATER_THAN(100, ntpBack);
+    TEST_ASSERT_GREATER_THAN(100, ntpForward);
+
+    for (int i = 0; i < SLOT_COUNT; i++) {
+        for (int d = 0; d < YEAR_DAYS; d++) {
+            struct tm tm = local(YEAR_START + d * 86400L + 12 * 3600);
+            int n = 0;
+            for (int k = 0; k < fireCount; k++) {
+                if (fires[k].slot != i || fires[k].yday != tm.tm_yday) continue;
+                n++;
+                // Start zur Zeit oder verspätet im Nachhol-Fenster (Hänger, Sprung vorwärts)
+                int late = fires[k].minute - expectedMinute(SLOTS[i], tm.tm_yday);
+                snprintf(msg, sizeof(msg), "slot %d yday %d late %d min", i + 1, tm.tm_yday, late);
+                TEST_ASSERT_TRUE_MESSAGE(late >= 0 && late <= CATCHUP_MIN, msg);
+            }
+            snprintf(msg, sizeof(msg), "slot %d yday %d", i + 1, tm.tm_yday);
+            TEST_ASSERT_EQUAL_INT_MESSAGE(dueOn(SLOTS[i], tm.tm_wday) ? 1 : 0, n, msg);
+        }
+    }
+    for (int k = 0; k < fireCount; k++) TEST_ASSERT_LESS_THAN(YEAR_DAYS, fires[k].yday);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_next_occurrence_once_per_due_day);
+    RUN_TEST(test_dst_days_are_23_and_25_hours);
+    RUN_TEST(test_autumn_repeated_hour_counts_once);
+    RUN_TEST(test_year_every_slot_fires_once_per_due_day);
+    return UNITY_END();
+}
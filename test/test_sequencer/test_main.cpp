@@ -0,0 +1,291 @@
+// Zonen-Sequencer (sequencer_module) mit dem echten Ventil-Modul auf dem
+// Host: Budget offener Zonen, Pause zwischen Schaltvorgängen, Tageslimit je
+// Zone, Resume mit übersprungenem Anfang. Zuletzt der Gesamt-FAILSAFE aus
+// main.cpp mit der Lauf-Warteschlange (setup()/loop()).
+//   pio test -e native       -f test_sequencer   (1 Zone wie config.h)
+//   pio test -e native_zones                     (4 Zonen, 2 offen, Limit; zones.h)
+// Die Erwartungen werden aus den config.h-Werten gerechnet; Fälle, die mehr
+// Zonen oder ein Tageslimit brauchen, sind mit der Vorgabe ignoriert.
+#include <unity.h>
+#include "hal.h"
+#include "config.h"
+#include "clock_module.h"
+#include "valve_module.h"
+#include "sequencer_module.h"
+#include "irrigation_module.h"
+#include "settings_module.h"
+
+void setup();
+void loop();
+
+static const int LANES = VALVE_MAX_OPEN < VALVE_ZONES ? VALVE_MAX_OPEN : VALVE_ZONES;
+static const uint32_t GAP_S = (VALVE_ZONE_GAP_MS + 999) / 1000;
+static const uint32_t STEP_MS = 100;
+static const uint16_t ALL_ZONES = (1u << VALVE_ZONES) - 1;
+
+struct ZoneTrace {
+    uint32_t openMs;            // Summe offen
+    int      opens;             // Zahl der Öffnungen
+    uint32_t firstOpenAt;       // ms ab Start des Szenarios
+};
+
+static ZoneTrace trace[VALVE_ZONES];
+static int maxOpen = 0;
+static uint32_t minGapBeforeOpen = 0xFFFFFFFF;     // kleinster Abstand Schaltvorgang -> Öffnen
+static int32_t testDay = 20260601;
+
+void setUp() {
+    halHostReset();
+    clockSimReset(0, 1780272000);
+    seqCancel();
+    seqInit();
+    valveInit();
+    valveSet(ValveState::CLOSED);
+    // frisches Tageskonto: erstes Datum setzt nur, zweites setzt zurück
+    valveRollDay(testDay++);
+    valveRollDay(testDay++);
+    memset(trace, 0, sizeof(trace));
+    maxOpen = 0;
+    minGapBeforeOpen = 0xFFFFFFFF;
+}
+
+void tearDown() {}
+
+// seqLoop() im 100-ms-Takt, bis nichts mehr läuft (oder maxMs)
+static uint32_t runSequencer(uint32_t maxMs) {
+    bool was[VALVE_ZONES];
+    for (int z = 0; z < VALVE_ZONES; z++) was[z] = valveZoneIsOpen(z);
+    uint32_t t = 0;
+    uint32_t lastSwitch = 0;
+    bool anySwitch = false;
+    while (t < maxMs && seqIsBusy()) {
+        seqLoop(clockMillis());
+        for (int z = 0; z < VALVE_ZONES; z++) {
+            bool open = valveZoneIsOpen(z);
+            if (open && !was[z]) {
+                if (anySwitch && t - lastSwitch < minGapBeforeOpen) minGapBeforeOpen = t - lastSwitch;
+                if (trace[z].opens++ == 0) trace[z].firstOpenAt = t;
+            }
+            if (open != was[z]) {
+                lastSwitch = t;
+                anySwitch = true;
+            }
+            was[z] = open;
+        }
+        if (valveOpenCount() > maxOpen) maxOpen = valveOpenCount();
+        halHostAdvanceMs(STEP_MS);
+        t += STEP_MS;
+        for (int z = 0; z < VALVE_ZONES; z++) if (valveZoneIsOpen(z)) trace[z].openMs += STEP_MS;
+    }
+    return t;
+}
+
+// === BUDGET OFFENER ZONEN ===
+void test_open_count_never_exceeds_lanes() {
+    TEST_ASSERT_EQUAL_INT(VALVE_ZONES, seqEnqueueProgram(ALL_ZONES, 60, 0));
+    runSequencer(3600000);
+    TEST_ASSERT_FALSE(seqIsBusy());
+    TEST_ASSERT_EQUAL_INT(LANES, maxOpen);
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        TEST_ASSERT_EQUAL_INT(1, trace[z].opens);
+        TEST_ASSERT_UINT_WITHIN(STEP_MS, 60000, trace[z].openMs);
+    }
+}
+
+void test_manually_open_zone_counts_against_budget() {
+    if (VALVE_ZONES < 2) TEST_IGNORE_MESSAGE("needs VALVE_ZONES >= 2 (pio test -e native_zones)");
+    valveZoneSet(0, true);                      // z.B. per Web geöffnet
+    seqEnqueueProgram(ALL_ZONES & ~1u, 30, 0);
+    runSequencer(20 * 60000);
+    TEST_ASSERT_EQUAL_INT(LANES, maxOpen);      // manuelle Zone + LANES-1 vom Sequencer
+    TEST_ASSERT_TRUE(valveZoneIsOpen(0));       // bleibt offen, gehört nicht dem Sequencer
+    valveZoneSet(0, false);
+}
+
+void test_waits_while_same_zone_is_open_manually() {
+    valveZoneSet(0, true);
+    seqEnqueue(0, 10);
+    for (int i = 0; i < 100; i++) {
+        seqLoop(clockMillis());
+        halHostAdvanceMs(STEP_MS);
+    }
+    TEST_ASSERT_TRUE(seqIsBusy());              // wartet, statt die Zone zu übernehmen
+    valveZoneSet(0, false);
+    runSequencer(60000);
+    TEST_ASSERT_EQUAL_INT(1, trace[0].opens);
+    TEST_ASSERT_UINT_WITHIN(STEP_MS, 10000, trace[0].openMs);
+}
+
+// === PAUSE ZWISCHEN SCHALTVORGÄNGEN ===
+void test_gap_between_switches() {
+    seqEnqueue(0, 10);
+    seqEnqueue(0, 10);                          // dieselbe Zone zweimal: zu, Pause, auf
+    for (int z = 1; z < VALVE_ZONES; z++) seqEnqueue(z, 10);
+    runSequencer(3600000);
+    TEST_ASSERT_EQUAL_INT(2, trace[0].opens);
+    TEST_ASSERT_UINT_WITHIN(STEP_MS, 20000, trace[0].openMs);
+    TEST_ASSERT_GREATER_OR_EQUAL(VALVE_ZONE_GAP_MS, minGapBeforeOpen);
+    TEST_ASSERT_LESS_THAN(VALVE_ZONE_GAP_MS + STEP_MS + 1, minGapBeforeOpen);
+}
+
+// === TAGESLIMIT JE ZONE ===
+void test_zone_daily_limit_closes_and_skips() {
+    if (VALVE_ZONE_LIMIT_S == 0) TEST_IGNORE_MESSAGE("needs VALVE_ZONE_LIMIT_S > 0 (pio test -e native_zones)");
+    const uint16_t over = VALVE_ZONE_LIMIT_S + 300;
+    seqEnqueue(0, over);
+    runSequencer(3600000);
+    TEST_ASSERT_UINT_WITHIN(STEP_MS, VALVE_ZONE_LIMIT_S * 1000UL, trace[0].openMs);
+    TEST_ASSERT_FALSE(valveZoneIsOpen(0));
+
+    // am selben Tag: übersprungen, andere Zonen laufen weiter
+    memset(trace, 0, sizeof(trace));
+    seqEnqueue(0, 60);
+    if (VALVE_ZONES > 1) seqEnqueue(1, 60);
+    runSequencer(3600000);
+    TEST_ASSERT_EQUAL_INT(0, trace[0].opens);
+    if (VALVE_ZONES > 1) TEST_ASSERT_UINT_WITHIN(STEP_MS, 60000, trace[1].openMs);
+
+    // neuer Tag: Konto leer, Zone läuft wieder
+    valveRollDay(testDay++);
+    memset(trace, 0, sizeof(trace));
+    seqEnqueue(0, 60);
+    runSequencer(3600000);
+    TEST_ASSERT_EQUAL_INT(1, trace[0].opens);
+    TEST_ASSERT_UINT_WITHIN(STEP_MS, 60000, trace[0].openMs);
+}
+
+// === RESUME ===
+// Plan wie seqEnqueueProgram(): gleiche Dauer, die k-te Zone der Maske
+// startet in Runde k / LANES, Runden durch GAP_S getrennt
+static void plannedWindow(int k, uint16_t dur, uint32_t &start, uint32_t &end) {
+    start = (k / LANES) * (dur + GAP_S);
+    end = start + dur;
+}
+
+static void checkResume(uint16_t dur, uint32_t skip) {
+    int expectRuns = 0;
+    uint32_t expectMs[VALVE_ZONES];
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        uint32_t start, end;
+        plannedWindow(z, dur, start, end);
+        expectMs[z] = end <= skip ? 0 : (start < skip ? end - skip : dur) * 1000UL;
+        if (expectMs[z]) expectRuns++;
+    }
+    TEST_ASSERT_EQUAL_INT(expectRuns, seqEnqueueProgram(ALL_ZONES, dur, skip));
+    runSequencer(3600000);
+    for (int z = 0; z < VALVE_ZONES; z++) {
+        char msg[48];
+        snprintf(msg, sizeof(msg), "zone %d skip %u", z + 1, (unsigned)skip);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(expectMs[z] ? 1 : 0, trace[z].opens, msg);
+        TEST_ASSERT_TRUE_MESSAGE(trace[z].openMs + STEP_MS >= expectMs[z] && trace[z].openMs <= expectMs[z] + STEP_MS, msg);
+    }
+}
+
+void test_resume_skips_elapsed_parts() {
+    const uint16_t dur = 100;
+    uint32_t total = ((VALVE_ZONES - 1) / LANES) * (dur + GAP_S) + dur;
+    const uint32_t skips[] = { 0, 40, dur, dur + GAP_S / 2 + 1, total - 1, total };
+    for (uint32_t skip : skips) {
+        setUp();
+        checkResume(dur, skip);
+    }
+}
+
+// Restzeit-Schätzung gegen das tatsächliche Ende; der Plan kennt die
+// versetzten Starts der Spuren (Pause je Schaltvorgang) nicht
+void test_remaining_tracks_actual_end() {
+    const uint16_t dur = 100;
+    seqEnqueueProgram(ALL_ZONES, dur, 0);
+    uint32_t total = ((VALVE_ZONES - 1) / LANES) * (dur + GAP_S) + dur;
+    TEST_ASSERT_EQUAL_UINT32(total, seqGetRemainingSec(clockMillis()));
+
+    static uint32_t estimate[3600];
+    int samples = 0;
+    uint32_t t = 0;
+    while (seqIsBusy() && samples < 3600) {
+        seqLoop(clockMillis());
+        estimate[samples++] = seqGetRemainingSec(clockMillis());
+        halHostAdvanceMs(1000);
+        t++;
+    }
+    TEST_ASSERT_FALSE(seqIsBusy());
+    TEST_ASSERT_EQUAL_INT(0, valveOpenCount());
+    TEST_ASSERT_EQUAL_UINT32(0, seqGetRemainingSec(clockMillis()));
+    for (int i = 0; i < samples; i++) {
+        uint32_t actual = t - i;
+        char msg[32];
+        snprintf(msg, sizeof(msg), "at %d s", i);
+        TEST_ASSERT_UINT_WITHIN_MESSAGE(GAP_S * LANES + 1, actual, estimate[i], msg);
+    }
+}
+
+// === GESAMT-TAGESLIMIT (FAILSAFE in main.cpp) ===
+// Limit reißt mitten im Lauf, ein zweiter Lauf wartet: der erste wird
+// abgebrochen (MANUAL bleibt), der zweite startet erst, wenn das Limit es zulässt
+static int firmwareOpens = 0;
+
+static void firmwareStep() {
+    bool was = valveOpenCount() > 0;
+    loop();
+    bool open = valveOpenCount() > 0;
+    if (open && !was) firmwareOpens++;
+    if (!open) {
+        halHostAdvanceMs(1000);
+        return;
+    }
+    halHostPulses(PIN_FLOW, 9, 10000);      // 12 L/min
+    halHostAdvanceMs(10);
+}
+
+void test_daily_limit_cancels_run_and_holds_queue() {
+    halHostNvsErase();
+    setup();
+    settingsSetDailyLimitSec(120);
+    irrigationSetMode(IrrigationMode::AUTO);
+    unsigned long t0 = clockMillis();
+    while (clockMillis() - t0 < 10000) firmwareStep();     // Boot, MQTT
+
+    irrigationRequest(300, -1, 1, 0.0f, IRR_PRIO_MANUAL);
+    irrigationRequest(60, -1, 1, 0.0f, IRR_PRIO_MANUAL);
+    QueuedRun q[IRR_RUN_QUEUE_LEN];
+    TEST_ASSERT_TRUE(irrigationIsRunning());
+    TEST_ASSERT_EQUAL_INT(1, irrigationGetQueue(q));
+
+    t0 = clockMillis();
+    while (clockMillis() - t0 < 600000) firmwareStep();
+    TEST_ASSERT_EQUAL_INT(1, firmwareOpens);                // kein Wiederöffnen je Warteschlangen-Lauf
+    TEST_ASSERT_UINT_WITHIN(2, 120, valveGetDailyOpenSec());
+    TEST_ASSERT_FALSE(irrigationIsRunning());
+    TEST_ASSERT_EQUAL(IrrigationMode::MANUAL, irrigationGetMode());
+    TEST_ASSERT_EQUAL_INT(1, irrigationGetQueue(q));
+
+    // zurück auf AUTO: Limit weiter überschritten -> nichts startet
+    irrigationSetMode(IrrigationMode::AUTO);
+    irrigationStart(30);
+    t0 = clockMillis();
+    while (clockMillis() - t0 < 120000) firmwareStep();
+    TEST_ASSERT_EQUAL_INT(1, firmwareOpens);
+    TEST_ASSERT_FALSE(irrigationIsRunning());
+    TEST_ASSERT_EQUAL_INT(1, irrigationGetQueue(q));
+
+    // Limit angehoben: der wartende Lauf startet
+    settingsSetDailyLimitSec(3600);
+    t0 = clockMillis();
+    while (clockMillis() - t0 < 120000) firmwareStep();
+    TEST_ASSERT_EQUAL_INT(2, firmwareOpens);
+    TEST_ASSERT_EQUAL_INT(0, irrigationGetQueue(q));
+    TEST_ASSERT_UINT_WITHIN(3, 180, valveGetDailyOpenSec());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_open_count_never_exceeds_lanes);
+    RUN_TEST(test_manually_open_zone_counts_against_budget);
+    RUN_TEST(test_waits_while_same_zone_is_open_manually);
+    RUN_TEST(test_gap_between_switches);
+    RUN_TEST(test_zone_daily_limit_closes_and_skips);
+    RUN_TEST(test_resume_skips_elapsed_parts);
+    RUN_TEST(test_remaining_tracks_actual_end);
+    RUN_TEST(test_daily_limit_cancels_run_and_holds_queue);
+    return UNITY_END();
+}
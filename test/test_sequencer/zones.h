@@ -0,0 +1,8 @@
+// Zonen-Aufbau für [env:native_zones] (per -include vor config.h):
+// 4 Zonen, höchstens 2 gleichzeitig offen, 10 min Tageslimit je Zone.
+// Die Pins gibt es nur auf dem Host-Backend.
+#pragma once
+#define VALVE_ZONES         4
+#define VALVE_ZONE_PINS     { PIN_RELAY, 20, 21, 22 }
+#define VALVE_MAX_OPEN      2
+#define VALVE_ZONE_LIMIT_S  600
@@ -0,0 +1,59 @@
+"""
+Erzeugt src/web_ui.h aus web/index.html (gzip, als PROGMEM Byte-Array).
+
+Laeuft automatisch als PlatformIO pre-Script (extra_scripts in platformio.ini)
+oder manuell:  python tools/embed_web_ui.py
+"""
+import gzip
+import os
+import re
+
+try:
+    Import("env")  # noqa: F821 (nur unter PlatformIO/SCons vorhanden)
+    ROOT = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SRC = os.path.join(ROOT, "web", "index.html")
+CONFIG = os.path.join(ROOT, "src", "config.h")
+OUT = os.path.join(ROOT, "src", "web_ui.h")
+
+
+def fw_version():
+    with open(CONFIG, encoding="utf-8") as f:
+        m = re.search(r'#define\s+FW_VERSION\s+"([^"]+)"', f.read())
+    return m.group(1) if m else "dev"
+
+
+def build():
+    fw = fw_version()
+    with open(SRC, encoding="utf-8") as f:
+        html = f.read().replace("%FW_VERSION%", fw)
+
+    # mtime=0 -> reproduzierbares Ergebnis (kein Diff ohne Aenderung)
+    data = gzip.compress(html.encode("utf-8"), compresslevel=9, mtime=0)
+
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+
+    header = (
+        "// AUTO-GENERATED by tools/embed_web_ui.py from web/index.html - NICHT EDITIEREN\n"
+        "#pragma once\n"
+        "#include <Arduino.h>\n\n"
+        '#define WEB_UI_FW "%s"\n'
+        "#define WEB_UI_GZ_LEN %d\n\n"
+        "static const uint8_t WEB_UI_GZ[] PROGMEM = {\n%s\n};\n"
+    ) % (fw, len(data), "\n".join(lines))
+
+    old = None
+    if os.path.exists(OUT):
+        with open(OUT, encoding="utf-8") as f:
+            old = f.read()
+    if old != header:
+        with open(OUT, "w", encoding="utf-8") as f:
+            f.write(header)
+    print("web_ui.h: %d bytes html -> %d bytes gzip (FW %s)" % (len(html), len(data), fw))
+
+
+build()
@@ -0,0 +1,9 @@
+"""
+32-Bit-Host-Build fuer [env:native32]: -m32 auch beim Linken
+(build_flags gehen unter PlatformIO/SCons nur an den Compiler).
+
+Braucht die 32-Bit-Toolchain, unter Debian/Ubuntu: apt install g++-multilib
+"""
+Import("env")  # noqa: F821 (nur unter PlatformIO/SCons vorhanden)
+
+env.Append(LINKFLAGS=["-m32"])  # noqa: F821
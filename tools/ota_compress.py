@@ -0,0 +1,71 @@
+"""
+Komprimiert ein Firmware-Image fuer OTA (Web-Upload oder Pull-OTA).
+
+Format: "OTZ1" + Rohgroesse (uint32 little endian) + zlib-Stream.
+Das Geraet entpackt beim Schreiben mit tinfl (ROM) in ein Ringfenster von
+2^window Bytes - das Fenster bestimmt also den RAM-Bedarf waehrend des
+Updates (Standard 13 = 8 KB, erlaubt bis OTA_INFLATE_MAX_WINDOW).
+
+    python tools/ota_compress.py .pio/build/esp32-c6-supermini/firmware.bin
+    python tools/ota_compress.py firmware.bin -o fw.otz --window 12 --kbps 200
+
+Gibt Groessen, Einsparung, geschaetzte Uebertragungszeit und die SHA-256 der
+komprimierten Datei aus (fuer ?sha256= bzw. das MQTT-Kommando).
+"""
+import argparse
+import hashlib
+import struct
+import zlib
+
+MAGIC = b"OTZ1"
+
+
+def compress(raw, window, level):
+    c = zlib.compressobj(level, zlib.DEFLATED, window, 9)
+    return MAGIC + struct.pack("<I", len(raw)) + c.compress(raw) + c.flush()
+
+
+def verify(blob, raw, window):
+    # Entpacken mit genau diesem Fenster: Distanzen > 2^window wuerden hier scheitern
+    if blob[:4] != MAGIC or struct.unpack("<I", blob[4:8])[0] != len(raw):
+        raise SystemExit("FAIL: header")
+    d = zlib.decompressobj(window)
+    out = d.decompress(blob[8:]) + d.flush()
+    if out != raw:
+        raise SystemExit("FAIL: roundtrip mismatch")
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("image")
+    ap.add_argument("-o", "--output", help="Standard: <image>.otz")
+    ap.add_argument("--window", type=int, default=13, choices=range(9, 16), metavar="9..15",
+                    help="log2 Fenstergroesse (RAM auf dem Geraet)")
+    ap.add_argument("--level", type=int, default=9)
+    ap.add_argument("--kbps", type=float, default=250.0, help="angenommener OTA-Durchsatz (kbit/s)")
+    a = ap.parse_args()
+
+    with open(a.image, "rb") as f:
+        raw = f.read()
+    if raw[:1] != b"\xe9":
+        print("Warnung: kein ESP-Image (Magic 0xE9 fehlt)")
+
+    blob = compress(raw, a.window, a.level)
+    verify(blob, raw, a.window)
+
+    out = a.output or a.image + ".otz"
+    with open(out, "wb") as f:
+        f.write(blob)
+
+    saved = 100.0 * (1 - len(blob) / len(raw))
+    t_raw = len(raw) * 8 / (a.kbps * 1000)
+    t_z = len(blob) * 8 / (a.kbps * 1000)
+    print("raw        %8d bytes" % len(raw))
+    print("compressed %8d bytes  (-%.1f %%, Fenster %d B)" % (len(blob), saved, 1 << a.window))
+    print("transfer @ %.0f kbit/s: %.1f s -> %.1f s" % (a.kbps, t_raw, t_z))
+    print("written    %s" % out)
+    print("sha256     %s" % hashlib.sha256(blob).hexdigest())
+
+
+if __name__ == "__main__":
+    main()
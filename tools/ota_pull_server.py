@@ -0,0 +1,180 @@
+"""
+Lokaler Firmware-Server fuer Pull-OTA (MQTT-Kommando {"cmd":"ota",...}).
+
+Liefert eine Datei mit HTTP Range Support (206 + Content-Range), damit das
+Geraet nach einem WLAN-Abbruch ab dem letzten Byte weiterlaedt. Mit
+--drop-after wird die Verbindung nach N Bytes absichtlich gekappt, um den
+Resume-Pfad zu testen.
+
+    python tools/ota_pull_server.py .pio/build/esp32-c6-supermini/firmware.bin
+    python tools/ota_pull_server.py firmware.bin --drop-after 200000 \\
+        --broker 192.168.1.104 --topic garden/valve1 --host-ip 192.168.1.10
+
+--broker: schickt das OTA-Kommando per mosquitto_pub und zeigt danach
+<topic>/ota (Fortschritt/Endstatus) per mosquitto_sub.
+
+--selftest: laedt die Datei vom eigenen Server mit derselben Resume-Logik
+wie die Firmware (Range ab offset, Content-Range pruefen, SHA-256 am Ende)
+und prueft das Ergebnis. Laeuft ohne Geraet, nur Python-Standardbibliothek.
+"""
+import argparse
+import hashlib
+import http.server
+import json
+import os
+import re
+import shutil
+import subprocess
+import threading
+import urllib.error
+import urllib.request
+
+RANGE_RE = re.compile(r"bytes=(\d+)-(\d*)$")
+
+
+def make_handler(path, drop_after):
+    name = "/" + os.path.basename(path)
+    size = os.path.getsize(path)
+    state = {"served": 0}
+
+    class Handler(http.server.BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"
+
+        def do_GET(self):  # noqa: N802
+            if self.path.split("?")[0] != name:
+                self.send_error(404)
+                return
+            start, end = 0, size - 1
+            rng = self.headers.get("Range")
+            if rng:
+                m = RANGE_RE.match(rng.strip())
+                if not m or int(m.group(1)) >= size:
+                    self.send_response(416)
+                    self.send_header("Content-Range", "bytes */%d" % size)
+                    self.send_header("Content-Length", "0")
+                    self.end_headers()
+                    return
+                start = int(m.group(1))
+                if m.group(2):
+                    end = min(int(m.group(2)), size - 1)
+                self.send_response(206)
+                self.send_header("Content-Range", "bytes %d-%d/%d" % (start, end, size))
+            else:
+                self.send_response(200)
+            self.send_header("Content-Type", "application/octet-stream")
+            self.send_header("Content-Length", str(end - start + 1))
+            self.send_header("Accept-Ranges", "bytes")
+            self.end_headers()
+
+            with open(path, "rb") as f:
+                f.seek(start)
+                left = end - start + 1
+                while left > 0:
+                    chunk = f.read(min(4096, left))
+                    if drop_after and state["served"] + len(chunk) > drop_after:
+                        # einmalig mitten im Body abbrechen (simuliert WLAN-Abriss)
+                        cut = drop_after - state["served"]
+                        self.wfile.write(chunk[:max(cut, 0)])
+                        state["served"] = drop_after
+                        drop_after_hit()
+                        self.close_connection = True
+                        self.connection.shutdown(2)
+                        return
+                    self.wfile.write(chunk)
+                    state["served"] += len(chunk)
+                    left -= len(chunk)
+
+        def log_message(self, fmt, *args):
+            print("  [http] %s %s" % (self.address_string(), fmt % args))
+
+    def drop_after_hit():
+        nonlocal drop_after
+        print("  [http] connection dropped after %d bytes" % drop_after)
+        drop_after = 0
+
+    return Handler, name, size
+
+
+def selftest(url, sha_hex, max_resumes=10):
+    """Gleiche Logik wie otaPullTask(): GET, bei Abbruch Range ab offset."""
+    data = bytearray()
+    total = None
+    h = hashlib.sha256()
+    for attempt in range(max_resumes + 1):
+        req = urllib.request.Request(url)
+        if data:
+            req.add_header("Range", "bytes=%d-" % len(data))
+        try:
+            with urllib.request.urlopen(req, timeout=10) as r:
+                if data:
+                    cr = r.headers.get("Content-Range", "")
+                    if r.status != 206 or not cr.startswith("bytes %d-" % len(data)):
+                        raise SystemExit("FAIL: range not supported (%s %s)" % (r.status, cr))
+                    print("selftest: resumed at %d" % len(data))
+                elif total is None:
+                    total = int(r.headers.get("Content-Length", "0")) or None
+                while True:
+                    chunk = r.read(2048)
+                    if not chunk:
+                        break
+                    data += chunk
+                    h.update(chunk)
+        except (urllib.error.URLError, ConnectionError, OSError) as e:
+            print("selftest: attempt %d aborted at %d bytes (%s)" % (attempt, len(data), e))
+        if total is not None and len(data) >= total:
+            break
+    got = h.hexdigest()
+    if total is not None and len(data) != total:
+        raise SystemExit("FAIL: incomplete %d/%d" % (len(data), total))
+    if got != sha_hex:
+        raise SystemExit("FAIL: sha256 mismatch %s != %s" % (got, sha_hex))
+    print("selftest: OK, %d bytes, sha256 %s" % (len(data), got))
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("file")
+    ap.add_argument("--port", type=int, default=8000)
+    ap.add_argument("--host-ip", default="127.0.0.1", help="IP, unter der das Geraet diesen Server erreicht")
+    ap.add_argument("--drop-after", type=int, default=0, help="Verbindung einmalig nach N Bytes trennen")
+    ap.add_argument("--broker", help="MQTT Broker: OTA-Kommando per mosquitto_pub senden")
+    ap.add_argument("--topic", default="garden/valve1", help="MQTT_BASE_TOPIC des Geraets")
+    ap.add_argument("--selftest", action="store_true", help="ohne Geraet: Resume-Download gegen sich selbst")
+    a = ap.parse_args()
+
+    with open(a.file, "rb") as f:
+        sha = hashlib.sha256(f.read()).hexdigest()
+
+    handler, name, size = make_handler(a.file, a.drop_after)
+    srv = http.server.ThreadingHTTPServer(("0.0.0.0", a.port), handler)
+    threading.Thread(target=srv.serve_forever, daemon=True).start()
+
+    url = "http://%s:%d%s" % (a.host_ip, a.port, name)
+    cmd = json.dumps({"cmd": "ota", "url": url, "sha256": sha}, separators=(",", ":"))
+    print("serving %s (%d bytes, sha256 %s)" % (url, size, sha))
+    print("MQTT %s/cmnd <- %s" % (a.topic, cmd))
+
+    if a.selftest:
+        selftest("http://127.0.0.1:%d%s" % (a.port, name), sha)
+        srv.shutdown()
+        return
+
+    if a.broker:
+        if not shutil.which("mosquitto_pub"):
+            raise SystemExit("mosquitto_pub nicht gefunden (Paket mosquitto-clients)")
+        subprocess.run(["mosquitto_pub", "-h", a.broker, "-t", a.topic + "/cmnd", "-m", cmd], check=True)
+        print("watching %s/ota (Ctrl+C beendet)" % a.topic)
+        try:
+            subprocess.run(["mosquitto_sub", "-h", a.broker, "-t", a.topic + "/ota", "-t", a.topic + "/event", "-v"])
+        except KeyboardInterrupt:
+            pass
+    else:
+        try:
+            threading.Event().wait()
+        except KeyboardInterrupt:
+            pass
+    srv.shutdown()
+
+
+if __name__ == "__main__":
+    main()
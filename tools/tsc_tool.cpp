@@ -0,0 +1,290 @@
+// Verlauf im tscodec-Format auf dem PC: dekodieren und messen.
+//
+//   g++ -O2 -std=gnu++17 -Isrc tools/tsc_tool.cpp src/tscodec_module.cpp -o tsc_tool
+//
+//   ./tsc_tool decode history.bin        Download von /api/history -> JSON je Zeile
+//                                        (gleiches Format wie TOPIC_HISTORY)
+//   ./tsc_tool bench                     synthetische Verläufe (7 Tage je Profil)
+//   ./tsc_tool bench hist.jsonl          eigene Aufzeichnung, z.B.
+//                                        mosquitto_sub -t <base>/history > hist.jsonl
+//   Optionen für bench: --days N, --block BYTES (Standard TS_BLOCK_MAX)
+//
+// bench gibt je Verlauf Byte/Punkt (Blöcke inkl. Kopf und Längenpräfix wie
+// im Download) gegen JSON, Encode- und Decode-µs/Punkt aus und prüft, dass
+// jeder Punkt auf 0,01 genau zurückkommt.
+#include "tscodec_module.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+typedef std::vector<TsPoint> Trace;
+
+static std::string pointJson(const TsPoint &p) {
+    char buf[160];
+    snprintf(buf, sizeof(buf), "{\"ts\":%lu,\"flow_l_min\":%.2f,\"total_l\":%.2f,\"vbat\":%.2f,\"valve\":\"%s\"}",
+             (unsigned long)p.ts, p.flowLpm, p.totalL, p.batV, p.valveOpen ? "OPEN" : "CLOSED");
+    return buf;
+}
+
+// === SYNTHETISCHE VERLÄUFE ===
+// Nachbildung des Haupt-Loops: ein Punkt je Minute (Loop-Jitter: ab und zu
+// 61 s), ein zusätzlicher bei jedem Ventilwechsel.
+struct Sim {
+    Trace   out;
+    double  total = 1234.56;
+    double  bat = 4.05;
+    double  lpm = 0;
+    uint32_t seed = 12345;
+
+    double noise(double amp) {
+        seed = seed * 1103515245 + 12345;
+        return ((int)((seed >> 16) % 2001) - 1000) / 1000.0 * amp;
+    }
+
+    void point(uint32_t ts, bool open) {
+        out.push_back({ ts, (float)lpm, (float)total, (float)bat, open });
+    }
+
+    // runs: Startminute des Tages, Dauer in Minuten, L/min
+    void day(uint32_t t0, const std::vector<int> &starts, int minutes, double plateau, double leakLpm) {
+        bool open = false;
+        uint32_t ts = t0;
+        for (int m = 0; m < 1440; m++) {
+            bool want = false;
+            for (int s : starts) if (m >= s && m < s + minutes) want = true;
+            if (want != open) {
+                open = want;
+                lpm = open ? plateau * 0.4 : 0;          // Anlauf bzw. Nachlauf
+                point(ts + 7, open);
+            }
+            if (open) lpm = plateau + noise(0.15);
+            else lpm = leakLpm > 0 ? leakLpm + noise(leakLpm * 0.2) : 0;
+            if (lpm < 0) lpm = 0;
+            total += lpm;
+            // Akku: Solar tagsüber, Entladung nachts, Einbruch bei offenem Ventil, ADC-Rauschen
+            double solar = (m > 420 && m < 1140) ? 0.0004 : -0.0002;
+            bat += solar;
+            if (bat > 4.15) bat = 4.15;
+            double shown = bat - (open ? 0.06 : 0) + (noise(1) > 0.6 ? 0.01 : 0);
+            double keep = bat;
+            bat = shown;
+            point(ts, open);
+            bat = keep;
+            ts += (noise(1) > 0.9) ? 61 : 60;
+        }
+    }
+};
+
+struct Profile {
+    const char* name;
+    Trace       trace;
+};
+
+static std::vector<Profile> syntheticProfiles(int days) {
+    const uint32_t start = 1780272000;      // 2026-06-01
+    std::vector<Profile> out;
+
+    Sim idle;
+    for (int d = 0; d < days; d++) idle.day(start + d * 86400, {}, 0, 0, 0);
+    out.push_back({ "idle (kein Lauf)", idle.out });
+
+    Sim garden;
+    for (int d = 0; d < days; d++) garden.day(start + d * 86400, { 360, 1200 }, 15, 12.0, 0);
+    out.push_back({ "garden (2x 15 min/Tag)", garden.out });
+
+    Sim busy;
+    for (int d = 0; d < days; d++) busy.day(start + d * 86400, { 300, 480, 720, 960, 1140, 1260 }, 30, 18.0, 0);
+    out.push_back({ "busy (6x 30 min/Tag)", busy.out });
+
+    Sim leak;
+    for (int d = 0; d < days; d++) leak.day(start + d * 86400, { 360 }, 20, 10.0, 0.05);
+    out.push_back({ "leak (Tropfen dauerhaft)", leak.out });
+    return out;
+}
+
+// === AUFZEICHNUNG (JSON je Zeile) ===
+static bool numField(const char* line, const char* key, double &v) {
+    const char* p = strstr(line, key);
+    if (!p) return false;
+    p = strchr(p + strlen(key), ':');
+    if (!p) return false;
+    v = atof(p + 1);
+    return true;
+}
+
+static bool loadJsonl(const char* path, Trace &out) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        double ts, flow, total, vbat;
+        if (!numField(line, "\"ts\"", ts) || !numField(line, "\"flow_l_min\"", flow) ||
+            !numField(line, "\"total_l\"", total) || !numField(line, "\"vbat\"", vbat)) continue;
+        out.push_back({ (uint32_t)ts, (float)flow, (float)total, (float)vbat, strstr(line, "\"OPEN\"") != nullptr });
+    }
+    fclose(f);
+    return true;
+}
+
+// === KODIEREN IN BLÖCKE ===
+// Download-Format wie /api/history: je Block u16 Länge (little endian) + Block
+static void encodeAll(const Trace &t, size_t block, std::vector<uint8_t> &out, int &blocks) {
+    static TsEncoder enc;
+    uint8_t buf[TS_BLOCK_MAX];
+    out.clear();
+    blocks = 0;
+    auto flush = [&]() {
+        size_t n = tsEncFinish(enc, buf, sizeof(buf));
+        out.push_back(n & 0xFF);
+        out.push_back(n >> 8);
+        out.insert(out.end(), buf, buf + n);
+        blocks++;
+    };
+    tsEncBegin(enc, block);
+    for (const TsPoint &p : t) {
+        if (tsEncAdd(enc, p)) continue;
+        flush();
+        tsEncBegin(enc, block);
+        tsEncAdd(enc, p);
+    }
+    if (enc.count) flush();
+}
+
+typedef bool (*PointFn)(const TsPoint &p, void* ctx);
+
+static bool decodeAll(const uint8_t* data, size_t len, PointFn fn, void* ctx) {
+    size_t pos = 0;
+    while (pos + 2 <= len) {
+        size_t n = data[pos] | (data[pos + 1] << 8);
+        pos += 2;
+        if (pos + n > len) return false;
+        TsDecoder dec;
+        if (!tsDecBegin(dec, data + pos, n)) return false;
+        TsPoint p;
+        while (tsDecNext(dec, p)) {
+            if (!fn(p, ctx)) return false;
+        }
+        if (dec.error) return false;
+        pos += n;
+    }
+    return pos == len;
+}
+
+static double nowUs() {
+    using namespace std::chrono;
+    return duration<double, std::micro>(steady_clock::now().time_since_epoch()).count();
+}
+
+struct Verify {
+    const Trace* t;
+    size_t       i;
+    bool         ok;
+};
+
+static bool same(float a, float b) { return std::lround(a * 100.0f) == std::lround(b * 100.0f); }
+
+static bool verifyPoint(const TsPoint &p, void* ctx) {
+    Verify &v = *(Verify*)ctx;
+    if (v.i >= v.t->size()) return v.ok = false;
+    const TsPoint &e = (*v.t)[v.i++];
+    if (p.ts != e.ts || p.valveOpen != e.valveOpen || !same(p.flowLpm, e.flowLpm) ||
+        !same(p.totalL, e.totalL) || !same(p.batV, e.batV)) {
+        fprintf(stderr, "mismatch at point %zu: %s != %s\n", v.i - 1, pointJson(p).c_str(), pointJson(e).c_str());
+        return v.ok = false;
+    }
+    return true;
+}
+
+static bool countPoint(const TsPoint &, void* ctx) {
+    (*(size_t*)ctx)++;
+    return true;
+}
+
+static bool bench(const char* name, const Trace &t, size_t block) {
+    if (t.empty()) return true;
+    size_t json = 0;
+    for (const TsPoint &p : t) json += pointJson(p).size();
+
+    std::vector<uint8_t> enc;
+    int blocks = 0;
+    int reps = 0;
+    double t0 = nowUs();
+    do { encodeAll(t, block, enc, blocks); reps++; } while (nowUs() - t0 < 200000);
+    double encUs = (nowUs() - t0) / reps / t.size();
+
+    reps = 0;
+    t0 = nowUs();
+    do {
+        size_t n = 0;
+        decodeAll(enc.data(), enc.size(), countPoint, &n);
+        reps++;
+    } while (nowUs() - t0 < 200000);
+    double decUs = (nowUs() - t0) / reps / t.size();
+
+    Verify v = { &t, 0, true };
+    bool ok = decodeAll(enc.data(), enc.size(), verifyPoint, &v) && v.ok && v.i == t.size();
+
+    printf("%-26s %7zu pts %5d blk %7zu B  %6.2f B/pt  (JSON %5.1f B/pt, 1:%-4.0f)  enc %6.3f us/pt  dec %6.3f us/pt  %s\n",
+           name, t.size(), blocks, enc.size(), (double)enc.size() / t.size(), (double)json / t.size(),
+           (double)json / enc.size(), encUs, decUs, ok ? "OK" : "FAIL");
+    return ok;
+}
+
+static bool printPoint(const TsPoint &p, void*) {
+    puts(pointJson(p).c_str());
+    return true;
+}
+
+static int usage() {
+    fprintf(stderr, "usage: tsc_tool decode <history.bin>\n"
+                    "       tsc_tool bench [trace.jsonl] [--days N] [--block BYTES]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) return usage();
+
+    if (!strcmp(argv[1], "decode")) {
+        if (argc < 3) return usage();
+        FILE* f = fopen(argv[2], "rb");
+        if (!f) { perror(argv[2]); return 1; }
+        std::vector<uint8_t> data;
+        uint8_t buf[4096];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), f)) > 0) data.insert(data.end(), buf, buf + n);
+        fclose(f);
+        if (!decodeAll(data.data(), data.size(), printPoint, nullptr)) {
+            fprintf(stderr, "FAIL: corrupt or truncated block\n");
+            return 1;
+        }
+        return 0;
+    }
+
+    if (strcmp(argv[1], "bench")) return usage();
+    int days = 7;
+    size_t block = TS_BLOCK_MAX;
+    const char* file = nullptr;
+    for (int i = 2; i < argc; i++) {
+        if (!strcmp(argv[i], "--days") && i + 1 < argc) days = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--block") && i + 1 < argc) block = (size_t)atoi(argv[++i]);
+        else file = argv[i];
+    }
+    if (block < 32 || block > TS_BLOCK_MAX) {
+        fprintf(stderr, "--block: 32..%d\n", TS_BLOCK_MAX);
+        return 2;
+    }
+
+    bool ok = true;
+    if (file) {
+        Trace t;
+        if (!loadJsonl(file, t)) { perror(file); return 1; }
+        ok = bench(file, t, block);
+    } else {
+        for (const Profile &p : syntheticProfiles(days)) ok &= bench(p.name, p.trace, block);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+"""
+Loop-Jitter Benchmark: misst loop_avg_us / loop_max_us aus /diag.json,
+zuerst im Leerlauf, dann waehrend mehrere Clients den Webserver belasten.
+
+    python tools/web_load_test.py 192.168.1.50 --clients 6 --seconds 30
+
+Nur Python-Standardbibliothek. Zugangsdaten wie OTA_USER/OTA_PASS in config.h.
+"""
+import argparse
+import base64
+import json
+import statistics
+import threading
+import time
+import urllib.request
+
+# Mischung aus kleinen JSON-Antworten und der (gecachten) UI
+LOAD_PATHS = ["/api/state", "/api/status", "/api/log", "/diag.json", "/api/schedule", "/"]
+
+
+def make_opener(user, password):
+    token = base64.b64encode(("%s:%s" % (user, password)).encode()).decode()
+
+    def fetch(url, timeout=5):
+        req = urllib.request.Request(url, headers={"Authorization": "Basic " + token})
+        with urllib.request.urlopen(req, timeout=timeout) as r:
+            return r.read()
+    return fetch
+
+
+def sample_loop(fetch, base, seconds, label):
+    avg, mx = [], []
+    end = time.time() + seconds
+    while time.time() < end:
+        try:
+            d = json.loads(fetch(base + "/diag.json"))
+            avg.append(d["loop_avg_us"])
+            mx.append(d["loop_max_us"])
+        except Exception as e:  # noqa: BLE001
+            print("  sample failed:", e)
+        time.sleep(1.0)
+    if not avg:
+        print("%-8s keine Messwerte" % label)
+        return
+    print("%-8s loop_avg_us median=%6d   loop_max_us median=%7d  max=%7d  (%d samples)" % (
+        label, statistics.median(avg), statistics.median(mx), max(mx), len(avg)))
+
+
+def hammer(fetch, base, stop, stats, idx):
+    i = idx
+    while not stop.is_set():
+        path = LOAD_PATHS[i % len(LOAD_PATHS)]
+        t0 = time.time()
+        try:
+            fetch(base + path)
+            stats["ok"] += 1
+            stats["lat"].append(time.time() - t0)
+        except Exception:  # noqa: BLE001
+            stats["err"] += 1
+        i += 1
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("host")
+    ap.add_argument("--user", default="otauser")
+    ap.add_argument("--password", default="superSecret123")
+    ap.add_argument("--clients", type=int, default=4)
+    ap.add_argument("--seconds", type=int, default=20)
+    a = ap.parse_args()
+
+    base = "http://" + a.host
+    fetch = make_opener(a.user, a.password)
+
+    print("Leerlauf (%d s) ..." % a.seconds)
+    sample_loop(fetch, base, a.seconds, "idle")
+
+    print("Last: %d Clients (%d s) ..." % (a.clients, a.seconds))
+    stop = threading.Event()
+    stats = {"ok": 0, "err": 0, "lat": []}
+    threads = [threading.Thread(target=hammer, args=(fetch, base, stop, stats, i), daemon=True)
+               for i in range(a.clients)]
+    for t in threads:
+        t.start()
+    sample_loop(fetch, base, a.seconds, "load")
+    stop.set()
+    for t in threads:
+        t.join(timeout=6)
+
+    lat = sorted(stats["lat"]) or [0]
+    print("Requests ok=%d err=%d  %.1f req/s  latency p50=%.0f ms p95=%.0f ms" % (
+        stats["ok"], stats["err"], stats["ok"] / a.seconds,
+        lat[len(lat) // 2] * 1000, lat[int(len(lat) * 0.95)] * 1000))
+
+
+if __name__ == "__main__":
+    main()